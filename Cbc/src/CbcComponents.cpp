@@ -0,0 +1,444 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <cfloat>
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "OsiSolverInterface.hpp"
+#include "OsiBranchingObject.hpp"
+#include "CbcModel.hpp"
+#include "CbcSimpleInteger.hpp"
+#include "CbcCutGenerator.hpp"
+#include "CbcHeuristic.hpp"
+#include "CbcComponents.hpp"
+#ifdef CBC_THREAD
+#include "CbcThread.hpp"
+#endif
+
+// Default Constructor
+CbcComponents::CbcComponents ()
+        : whichColumn_(NULL),
+        whichRow_(NULL),
+        columns_(NULL),
+        startColumn_(NULL),
+        rows_(NULL),
+        startRow_(NULL),
+        numberColumns_(0),
+        numberRows_(0),
+        numberComponents_(0)
+{
+}
+
+// Copy constructor
+CbcComponents::CbcComponents ( const CbcComponents & rhs)
+{
+    gutsOfCopy(rhs);
+}
+
+// Assignment operator
+CbcComponents &
+CbcComponents::operator=( const CbcComponents & rhs)
+{
+    if (this != &rhs) {
+        gutsOfDelete();
+        gutsOfCopy(rhs);
+    }
+    return *this;
+}
+
+// Destructor
+CbcComponents::~CbcComponents ()
+{
+    gutsOfDelete();
+}
+
+void
+CbcComponents::gutsOfCopy(const CbcComponents & rhs)
+{
+    numberColumns_ = rhs.numberColumns_;
+    numberRows_ = rhs.numberRows_;
+    numberComponents_ = rhs.numberComponents_;
+    whichColumn_ = CoinCopyOfArray(rhs.whichColumn_, numberColumns_);
+    whichRow_ = CoinCopyOfArray(rhs.whichRow_, numberRows_);
+    columns_ = CoinCopyOfArray(rhs.columns_, numberColumns_);
+    rows_ = CoinCopyOfArray(rhs.rows_, numberRows_);
+    startColumn_ = CoinCopyOfArray(rhs.startColumn_, numberComponents_ + 1);
+    startRow_ = CoinCopyOfArray(rhs.startRow_, numberComponents_ + 1);
+}
+
+void
+CbcComponents::gutsOfDelete()
+{
+    delete [] whichColumn_;
+    delete [] whichRow_;
+    delete [] columns_;
+    delete [] startColumn_;
+    delete [] rows_;
+    delete [] startRow_;
+    whichColumn_ = NULL;
+    whichRow_ = NULL;
+    columns_ = NULL;
+    startColumn_ = NULL;
+    rows_ = NULL;
+    startRow_ = NULL;
+    numberColumns_ = 0;
+    numberRows_ = 0;
+    numberComponents_ = 0;
+}
+
+// Find components of solver
+int
+CbcComponents::findComponents(const OsiSolverInterface * solver)
+{
+    gutsOfDelete();
+    numberColumns_ = solver->getNumCols();
+    numberRows_ = solver->getNumRows();
+    const CoinPackedMatrix * matrix = solver->getMatrixByCol();
+    const int * row = matrix->getIndices();
+    const CoinBigIndex * columnStart = matrix->getVectorStarts();
+    const int * columnLength = matrix->getVectorLengths();
+    whichColumn_ = new int [numberColumns_];
+    whichRow_ = new int [numberRows_];
+    // union find on rows - whichRow_ is parent to start with
+    int * rowCount = new int [numberRows_];
+    for (int iRow = 0; iRow < numberRows_; iRow++) {
+        whichRow_[iRow] = iRow;
+        rowCount[iRow] = 0;
+    }
+    for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+        int firstRoot = -1;
+        for (CoinBigIndex j = columnStart[iColumn];
+                j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+            int iRow = row[j];
+            rowCount[iRow]++;
+            // find root and compress path
+            int root = iRow;
+            while (whichRow_[root] != root)
+                root = whichRow_[root];
+            while (whichRow_[iRow] != root) {
+                int next = whichRow_[iRow];
+                whichRow_[iRow] = root;
+                iRow = next;
+            }
+            if (firstRoot < 0) {
+                firstRoot = root;
+            } else if (root != firstRoot) {
+                // join smaller number to larger so numbering is stable
+                if (root < firstRoot) {
+                    whichRow_[firstRoot] = root;
+                    firstRoot = root;
+                } else {
+                    whichRow_[root] = firstRoot;
+                }
+            }
+        }
+    }
+    // number components in order of first row
+    int * component = new int [numberRows_];
+    for (int iRow = 0; iRow < numberRows_; iRow++)
+        component[iRow] = -1;
+    for (int iRow = 0; iRow < numberRows_; iRow++) {
+        if (rowCount[iRow]) {
+            int root = iRow;
+            while (whichRow_[root] != root)
+                root = whichRow_[root];
+            if (component[root] < 0)
+                component[root] = numberComponents_++;
+            rowCount[iRow] = component[root];
+        } else {
+            rowCount[iRow] = -1;
+        }
+    }
+    CoinMemcpyN(rowCount, numberRows_, whichRow_);
+    delete [] component;
+    delete [] rowCount;
+    for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+        if (columnLength[iColumn])
+            whichColumn_[iColumn] = whichRow_[row[columnStart[iColumn]]];
+        else
+            whichColumn_[iColumn] = -1;
+    }
+    // lists
+    startColumn_ = new int [numberComponents_+1];
+    startRow_ = new int [numberComponents_+1];
+    columns_ = new int [numberColumns_];
+    rows_ = new int [numberRows_];
+    CoinZeroN(startColumn_, numberComponents_ + 1);
+    CoinZeroN(startRow_, numberComponents_ + 1);
+    for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+        if (whichColumn_[iColumn] >= 0)
+            startColumn_[whichColumn_[iColumn]+1]++;
+    }
+    for (int iRow = 0; iRow < numberRows_; iRow++) {
+        if (whichRow_[iRow] >= 0)
+            startRow_[whichRow_[iRow]+1]++;
+    }
+    for (int i = 0; i < numberComponents_; i++) {
+        startColumn_[i+1] += startColumn_[i];
+        startRow_[i+1] += startRow_[i];
+    }
+    int * put = new int [numberComponents_];
+    CoinMemcpyN(startColumn_, numberComponents_, put);
+    for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+        int which = whichColumn_[iColumn];
+        if (which >= 0)
+            columns_[put[which]++] = iColumn;
+    }
+    CoinMemcpyN(startRow_, numberComponents_, put);
+    for (int iRow = 0; iRow < numberRows_; iRow++) {
+        int which = whichRow_[iRow];
+        if (which >= 0)
+            rows_[put[which]++] = iRow;
+    }
+    delete [] put;
+    return numberComponents_;
+}
+
+// See if only simple integers with same priority
+bool
+CbcComponents::simpleObjectsOnly(const CbcModel & model)
+{
+    int priority = -1;
+    for (int iWhich = 0; iWhich < 2; iWhich++) {
+        // model objects then any in solver
+        int numberObjects;
+        OsiObject ** objects;
+        if (!iWhich) {
+            numberObjects = model.numberObjects();
+            objects = model.objects();
+        } else {
+            numberObjects = model.solver()->numberObjects();
+            objects = model.solver()->objects();
+        }
+        for (int i = 0; i < numberObjects; i++) {
+            const OsiObject * object = objects[i];
+            if (!dynamic_cast<const CbcSimpleInteger *> (object) &&
+                    !dynamic_cast<const OsiSimpleInteger *> (object))
+                return false;
+            if (priority < 0)
+                priority = object->priority();
+            else if (object->priority() != priority)
+                return false;
+        }
+    }
+    return true;
+}
+
+// Create solver for one component
+OsiSolverInterface *
+CbcComponents::componentSolver(const OsiSolverInterface * solver,
+                               int which) const
+{
+    assert (which >= 0 && which < numberComponents_);
+    int numberColumns = numberComponentColumns(which);
+    int numberRows = numberComponentRows(which);
+    const int * columns = componentColumns(which);
+    const int * rows = componentRows(which);
+    CoinPackedMatrix matrix(*solver->getMatrixByCol(), numberRows, rows,
+                            numberColumns, columns);
+    const double * columnLower = solver->getColLower();
+    const double * columnUpper = solver->getColUpper();
+    const double * objective = solver->getObjCoefficients();
+    const double * rowLower = solver->getRowLower();
+    const double * rowUpper = solver->getRowUpper();
+    double * lower = new double [3*numberColumns];
+    double * upper = lower + numberColumns;
+    double * cost = upper + numberColumns;
+    for (int i = 0; i < numberColumns; i++) {
+        int iColumn = columns[i];
+        lower[i] = columnLower[iColumn];
+        upper[i] = columnUpper[iColumn];
+        cost[i] = objective[iColumn];
+    }
+    double * rowLo = new double [2*numberRows];
+    double * rowUp = rowLo + numberRows;
+    for (int i = 0; i < numberRows; i++) {
+        int iRow = rows[i];
+        rowLo[i] = rowLower[iRow];
+        rowUp[i] = rowUpper[iRow];
+    }
+    OsiSolverInterface * newSolver = solver->clone(false);
+    newSolver->loadProblem(matrix, lower, upper, cost, rowLo, rowUp);
+    newSolver->setObjSense(solver->getObjSense());
+    for (int i = 0; i < numberColumns; i++) {
+        if (solver->isInteger(columns[i]))
+            newSolver->setInteger(i);
+    }
+    newSolver->setHintParam(OsiDoReducePrint, true, OsiHintTry);
+    delete [] lower;
+    delete [] rowLo;
+    return newSolver;
+}
+
+#ifdef CBC_THREAD
+typedef struct {
+    CbcModel ** models;
+    int firstModel;
+    int increment;
+    int numberModels;
+} CbcComponentInfo;
+// Solves every increment'th model from firstModel
+static void * doComponentThread(void * voidInfo)
+{
+    CbcComponentInfo * info = reinterpret_cast<CbcComponentInfo *> (voidInfo);
+    for (int i = info->firstModel; i < info->numberModels; i += info->increment)
+        info->models[i]->branchAndBound();
+    return NULL;
+}
+#endif
+
+// Solve each component as its own model
+int
+CbcComponents::solve(CbcModel & model, double * solution, double & objectiveValue,
+                     double & bestPossible, int & secondaryStatus)
+{
+    OsiSolverInterface * solver = model.solver();
+    assert (solver->getNumCols() == numberColumns_);
+    const double * columnLower = solver->getColLower();
+    const double * columnUpper = solver->getColUpper();
+    const double * objective = solver->getObjCoefficients();
+    double direction = solver->getObjSense();
+    double offset;
+    solver->getDblParam(OsiObjOffset, offset);
+    // Columns in no row go to best bound
+    double fixedObjective = -offset;
+    for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+        if (whichColumn_[iColumn] >= 0)
+            continue;
+        double lower = columnLower[iColumn];
+        double upper = columnUpper[iColumn];
+        if (solver->isInteger(iColumn)) {
+            lower = ceil(lower - 1.0e-9);
+            upper = floor(upper + 1.0e-9);
+        }
+        double cost = direction * objective[iColumn];
+        double value;
+        if (cost > 0.0)
+            value = lower;
+        else if (cost < 0.0)
+            value = upper;
+        else if (lower > -COIN_DBL_MAX)
+            value = lower;
+        else if (upper < COIN_DBL_MAX)
+            value = upper;
+        else
+            value = 0.0;
+        if (fabs(value) >= 1.0e30)
+            return -1; // unbounded - leave to branch and bound
+        solution[iColumn] = value;
+        fixedObjective += objective[iColumn] * value;
+    }
+    fixedObjective *= direction;
+    // Create models
+    CbcModel ** models = new CbcModel * [numberComponents_];
+    for (int i = 0; i < numberComponents_; i++) {
+        OsiSolverInterface * componentSolver = this->componentSolver(solver, i);
+        CbcModel * modelC = new CbcModel(*componentSolver);
+        delete componentSolver;
+        modelC->setLogLevel(0);
+        modelC->setNumberThreads(0);
+        modelC->setUseElapsedTime(model.useElapsedTime());
+        modelC->setDblParam(CbcModel::CbcStartSeconds,
+                            model.getDblParam(CbcModel::CbcStartSeconds));
+        modelC->setMaximumSeconds(model.getMaximumSeconds());
+        modelC->setMaximumNodes(model.getMaximumNodes());
+        modelC->setIntegerTolerance(model.getIntegerTolerance());
+        modelC->setAllowableGap(model.getAllowableGap() / numberComponents_);
+        modelC->setAllowableFractionGap(model.getAllowableFractionGap());
+        modelC->setCutoffIncrement(model.getCutoffIncrement());
+        modelC->setNumberStrong(model.numberStrong());
+        modelC->setNumberBeforeTrust(model.numberBeforeTrust());
+        for (int j = 0; j < model.numberCutGenerators(); j++) {
+            CbcCutGenerator * generator = model.cutGenerator(j);
+            modelC->addCutGenerator(generator->generator(),
+                                    generator->howOften(),
+                                    generator->cutGeneratorName(),
+                                    generator->normal(),
+                                    generator->atSolution(),
+                                    generator->whenInfeasible(),
+                                    generator->howOftenInSub(),
+                                    generator->whatDepth(),
+                                    generator->whatDepthInSub());
+        }
+        // heuristics get pointed at new model in branchAndBound
+        for (int j = 0; j < model.numberHeuristics(); j++)
+            modelC->addHeuristic(model.heuristic(j));
+        models[i] = modelC;
+    }
+    int numberThreads = CoinMin(model.getNumberThreads(), numberComponents_);
+#ifdef CBC_THREAD
+    if (numberThreads > 1) {
+        Coin_pthread_t * threadId = new Coin_pthread_t [numberThreads];
+        CbcComponentInfo * info = new CbcComponentInfo [numberThreads];
+        for (int i = 0; i < numberThreads; i++) {
+            info[i].models = models;
+            info[i].firstModel = i;
+            info[i].increment = numberThreads;
+            info[i].numberModels = numberComponents_;
+            pthread_create(&(threadId[i].thr), NULL, doComponentThread,
+                           info + i);
+        }
+        // wait
+        for (int i = 0; i < numberThreads; i++)
+            pthread_join(threadId[i].thr, NULL);
+        delete [] info;
+        delete [] threadId;
+    } else {
+#endif
+        for (int i = 0; i < numberComponents_; i++)
+            models[i]->branchAndBound();
+#ifdef CBC_THREAD
+    }
+#endif
+    // Combine in component order
+    int returnCode = 0;
+    secondaryStatus = 0;
+    objectiveValue = fixedObjective;
+    bestPossible = fixedObjective;
+    for (int i = 0; i < numberComponents_; i++) {
+        CbcModel * modelC = models[i];
+        int status = modelC->status();
+        int secondary = modelC->secondaryStatus();
+        if (status == 0 && (secondary == 1 || secondary == 7)) {
+            // infeasible or unbounded - so is whole model
+            if (returnCode != 1) {
+                returnCode = 1;
+                secondaryStatus = secondary;
+            }
+        } else if (status != 0 && returnCode == 0) {
+            returnCode = 2;
+            secondaryStatus = secondary;
+        } else if (secondary == 2 && returnCode == 0) {
+            // stopped on gap
+            secondaryStatus = 2;
+        }
+        bestPossible += direction * modelC->getBestPossibleObjValue();
+        const double * bestSolution = modelC->bestSolution();
+        if (bestSolution && objectiveValue < COIN_DBL_MAX) {
+            int n = numberComponentColumns(i);
+            const int * columns = componentColumns(i);
+            for (int j = 0; j < n; j++)
+                solution[columns[j]] = bestSolution[j];
+            objectiveValue += modelC->getMinimizationObjValue();
+        } else {
+            objectiveValue = COIN_DBL_MAX;
+        }
+        delete modelC;
+    }
+    delete [] models;
+    if (returnCode == 1)
+        objectiveValue = COIN_DBL_MAX;
+    return returnCode;
+}
+
@@ -0,0 +1,126 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcComponents_H
+#define CbcComponents_H
+
+class OsiSolverInterface;
+class CbcModel;
+
+/** Independent components of a model.
+
+    Two columns are linked if they have elements in the same row.  Each
+    connected set of rows and columns is a component which shares
+    nothing with the others except the objective, so it can be solved
+    as its own CbcModel and the results added up.  This is the special
+    case of the block structure found by CbcHeuristicDW where no row is
+    in the master.  Columns in no row are not in any component - they
+    just go to their best bound.
+*/
+
+class CbcComponents {
+
+public:
+
+    /// Default Constructor
+    CbcComponents ();
+
+    /// Copy constructor
+    CbcComponents ( const CbcComponents &);
+
+    /// Assignment operator
+    CbcComponents & operator=( const CbcComponents& rhs);
+
+    /// Destructor
+    ~CbcComponents ();
+
+    /** Find components of solver.
+        Returns number of components (rows with no elements and columns
+        in no row are not in any component) */
+    int findComponents(const OsiSolverInterface * solver);
+
+    /// Number of components
+    inline int numberComponents() const {
+        return numberComponents_;
+    }
+    /// Component for each column (-1 if in no row)
+    inline const int * whichColumnComponent() const {
+        return whichColumn_;
+    }
+    /// Component for each row (-1 if empty)
+    inline const int * whichRowComponent() const {
+        return whichRow_;
+    }
+    /// Number of columns in component
+    inline int numberComponentColumns(int which) const {
+        return startColumn_[which+1] - startColumn_[which];
+    }
+    /// Columns in component (in order)
+    inline const int * componentColumns(int which) const {
+        return columns_ + startColumn_[which];
+    }
+    /// Number of rows in component
+    inline int numberComponentRows(int which) const {
+        return startRow_[which+1] - startRow_[which];
+    }
+    /// Rows in component (in order)
+    inline const int * componentRows(int which) const {
+        return rows_ + startRow_[which];
+    }
+
+    /** True if all branching objects of model (and of its solver) are
+        simple integers with same priority - otherwise splitting would
+        lose SOS etc and priorities */
+    static bool simpleObjectsOnly(const CbcModel & model);
+
+    /// Create solver for one component (user must delete)
+    OsiSolverInterface * componentSolver(const OsiSolverInterface * solver,
+                                         int which) const;
+
+    /** Solve each component as its own CbcModel - in parallel if
+        model has threads.  Parameters, cut generators and heuristics
+        are copied from model.  The absolute allowable gap is shared
+        between components.
+        Returns
+        -1 not done (columns in no row would be unbounded)
+        0 all components finished
+        1 infeasible or unbounded
+        2 stopped on limits
+        solution gets combined solution, objectiveValue its objective
+        (COIN_DBL_MAX if a component has no solution) and bestPossible
+        the sum of component bounds - both as minimization.
+        secondaryStatus is as CbcModel::secondaryStatus().
+    */
+    int solve(CbcModel & model, double * solution, double & objectiveValue,
+              double & bestPossible, int & secondaryStatus);
+
+private:
+
+    void gutsOfCopy(const CbcComponents & rhs);
+    void gutsOfDelete();
+
+private:
+    /// Component for each column
+    int * whichColumn_;
+    /// Component for each row
+    int * whichRow_;
+    /// Columns in each component
+    int * columns_;
+    /// Starts for columns_ (numberComponents_+1)
+    int * startColumn_;
+    /// Rows in each component
+    int * rows_;
+    /// Starts for rows_ (numberComponents_+1)
+    int * startRow_;
+    /// Number of columns
+    int numberColumns_;
+    /// Number of rows
+    int numberRows_;
+    /// Number of components
+    int numberComponents_;
+};
+
+#endif
+
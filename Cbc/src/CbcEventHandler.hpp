@@ -106,7 +106,9 @@ public:
         /*! When converting constraints to cuts. */
         convertToCuts,
         /*! End of search. */
-        endSearch
+        endSearch,
+        /*! Profile of search complete - see CbcModel::profile(). */
+        profileSummary
     } ;
 
     /*! \brief Action codes returned by the event handler.
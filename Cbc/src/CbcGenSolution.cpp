@@ -21,6 +21,7 @@
 
 #include "CbcGenCtlBlk.hpp"
 #include "CbcGenParam.hpp"
+#include "CbcSolutionWriter.hpp"
 
 namespace {
 
@@ -276,7 +277,6 @@ int CbcGenParamUtils::doSolutionParam (CoinParam *param)
         fp = stderr ;
     } else {
         fp = fopen(fileName.c_str(), "w") ;
-        fp = fopen(fileName.c_str(), "w") ;
     }
     if (!fp) {
         std::cout
@@ -398,14 +398,18 @@ int CbcGenParamUtils::doSolutionParam (CoinParam *param)
     osi->getDblParam(OsiPrimalTolerance, primalTolerance) ;
 
     int iRow ;
+    char header[200] ;
+    CbcSolutionWriter writer ;
+    writer.setTextLayout("** ", "   ", longestName, "%15.8g%15.8g\n") ;
     if (ctlBlk->printMode_ >= 3) {
         const double *dualRowSolution = osi->getRowPrice() ;
         const double *primalRowSolution = osi->getRowActivity() ;
         const double *rowLower = osi->getRowLower() ;
         const double *rowUpper = osi->getRowUpper() ;
 
-        fprintf(fp, "\n   %7s %-*s%15s%15s\n\n",
+        sprintf(header, "\n   %7s %-*s%15s%15s\n\n",
                 "Index", longestName, "Row", "Activity", "Dual") ;
+        writer.addText(header) ;
 
         for (iRow = 0 ; iRow < m ; iRow++) {
             bool violated = false ;
@@ -421,21 +425,16 @@ int CbcGenParamUtils::doSolutionParam (CoinParam *param)
                     print = true ;
                 }
             }
-            const char *name = osi->getRowName(iRow).c_str() ;
-            if (doMask && !maskMatches(maskStarts, masks, name)) {
+            std::string name = osi->getRowName(iRow) ;
+            if (doMask && !maskMatches(maskStarts, masks, name.c_str())) {
                 print = false ;
             }
             if (print) {
-                if (violated) {
-                    fprintf(fp, "** ") ;
-                } else {
-                    fprintf(fp, "%3s", " ") ;
-                }
-                fprintf(fp, "%7d %-*s%15.8g%15.8g\n", iRow, longestName, name,
-                        primalRowSolution[iRow], dualRowSolution[iRow]) ;
+                writer.addEntry(iRow, name.c_str(), primalRowSolution[iRow],
+                                dualRowSolution[iRow], violated) ;
             }
         }
-        fprintf(fp, "\n") ;
+        writer.addText("\n") ;
     }
     /*
       Now do the columns. This first block handles all modes except 2 (special).
@@ -448,8 +447,9 @@ int CbcGenParamUtils::doSolutionParam (CoinParam *param)
         const double *columnUpper = osi->getColUpper() ;
         const double *dualColSolution = osi->getReducedCost() ;
 
-        fprintf(fp, "\n   %7s %-*s%15s%15s\n\n",
+        sprintf(header, "\n   %7s %-*s%15s%15s\n\n",
                 "Index", longestName, "Column", "Value", "Reduced Cost") ;
+        writer.addText(header) ;
 
         for (iColumn = 0 ; iColumn < n ; iColumn++) {
             bool violated = false ;
@@ -469,24 +469,21 @@ int CbcGenParamUtils::doSolutionParam (CoinParam *param)
                     }
                 }
             }
-            const char *name = osi->getColName(iColumn).c_str() ;
-            if (doMask && !maskMatches(maskStarts, masks, name)) {
+            std::string name = osi->getColName(iColumn) ;
+            if (doMask && !maskMatches(maskStarts, masks, name.c_str())) {
                 print = false ;
             }
             if (print) {
-                if (violated) {
-                    fprintf(fp, "** ") ;
-                } else {
-                    fprintf(fp, "%3s", " ") ;
-                }
-                fprintf(fp, "%7d %-*s%15.8g%15.8g\n", iColumn, longestName, name,
-                        primalColSolution[iColumn], dualColSolution[iColumn]) ;
+                writer.addEntry(iColumn, name.c_str(), primalColSolution[iColumn],
+                                dualColSolution[iColumn], violated) ;
             }
         }
     }
     /*
-      Close out the file, but don't close stdout. Delete any masks.
+      Write it out in one go, close out the file, but don't close stdout.
+      Delete any masks.
     */
+    writer.write(fp) ;
     if (fp != stdout) {
         fclose(fp) ;
     }
@@ -36,6 +36,9 @@
 #include "CbcCutGenerator.hpp"
 //==============================================================================
 
+// Cost of a branching decision which only appears in one of two nodes
+static const double CbcHeuristicNodeSubsetWeight = 0.2;
+
 CbcHeuristicNode::CbcHeuristicNode(const CbcHeuristicNode& rhs)
 {
     numObjects_ = rhs.numObjects_;
@@ -43,6 +46,7 @@ CbcHeuristicNode::CbcHeuristicNode(const CbcHeuristicNode& rhs)
     for (int i = 0; i < numObjects_; ++i) {
         brObj_[i] = rhs.brObj_[i]->clone();
     }
+    signature_ = rhs.signature_;
 }
 
 void
@@ -51,6 +55,9 @@ CbcHeuristicNodeList::gutsOfDelete()
     for (int i = (static_cast<int>(nodes_.size())) - 1; i >= 0; --i) {
         delete nodes_[i];
     }
+    nodes_.clear();
+    keyIndex_.clear();
+    sizeIndex_.clear();
 }
 
 void
@@ -83,9 +90,97 @@ void
 CbcHeuristicNodeList::append(CbcHeuristicNode*& node)
 {
     nodes_.push_back(node);
+    addToIndex(static_cast<int>(nodes_.size()) - 1);
     node = NULL;
 }
 
+void
+CbcHeuristicNodeList::addToIndex(int iNode)
+{
+    const CbcHeuristicNode* node = nodes_[iNode];
+    sizeIndex_[node->numObjects()].push_back(iNode);
+    const std::vector<CoinUInt64>& signature = node->signature();
+    int n = static_cast<int>(signature.size());
+    int i = 0;
+    while (i < n) {
+        // signature is sorted so equal keys are together
+        int j = i + 1;
+        while (j < n && signature[j] == signature[i])
+            j++;
+        keyIndex_[signature[i]].push_back(std::make_pair(iNode, j - i));
+        i = j;
+    }
+}
+
+// Estimated bytes used by nodes and index
+double
+CbcHeuristicNodeList::memoryUsed() const
+{
+    double bytes = static_cast<double>(nodes_.capacity() * sizeof(CbcHeuristicNode *));
+    double numberObjects = 0.0;
+    for (int i = 0; i < static_cast<int>(nodes_.size()); i++) {
+        bytes += sizeof(CbcHeuristicNode);
+        numberObjects += nodes_[i]->numObjects();
+    }
+    // pointer, cloned branching object (guess) and signature key per object
+    // plus index entry (with guess at map overhead)
+    bytes += numberObjects * (sizeof(CbcBranchingObject *) + 64 +
+                              sizeof(CoinUInt64) + sizeof(std::pair<int, int>) + 48);
+    return bytes;
+}
+
+bool
+CbcHeuristicNodeList::anyWithin(const CbcHeuristicNode* node,
+                                const double threshold) const
+{
+    if (nodes_.empty())
+        return false;
+    const int numObjects = node->numObjects();
+    /* A node sharing no keys is at least subsetWeight*(numObjects+size)
+       away - so only short nodes need looking at */
+    std::map<int, std::vector<int> >::const_iterator itSize;
+    for (itSize = sizeIndex_.begin(); itSize != sizeIndex_.end(); ++itSize) {
+        if (CbcHeuristicNodeSubsetWeight * (numObjects + itSize->first) >= threshold)
+            break;
+        const std::vector<int>& which = itSize->second;
+        for (int k = 0; k < static_cast<int>(which.size()); k++) {
+            if (node->distance(nodes_[which[k]]) < threshold)
+                return true;
+        }
+    }
+    // Count shared keys for all nodes with at least one key in common
+    std::map<int, int> shared;
+    const std::vector<CoinUInt64>& signature = node->signature();
+    int n = static_cast<int>(signature.size());
+    int i = 0;
+    while (i < n) {
+        int j = i + 1;
+        while (j < n && signature[j] == signature[i])
+            j++;
+        std::map<CoinUInt64, std::vector<std::pair<int, int> > >::const_iterator
+        itKey = keyIndex_.find(signature[i]);
+        if (itKey != keyIndex_.end()) {
+            const std::vector<std::pair<int, int> >& postings = itKey->second;
+            for (int k = 0; k < static_cast<int>(postings.size()); k++)
+                shared[postings[k].first] += CoinMin(j - i, postings[k].second);
+        }
+        i = j;
+    }
+    std::map<int, int>::const_iterator itShared;
+    for (itShared = shared.begin(); itShared != shared.end(); ++itShared) {
+        const CbcHeuristicNode* other = nodes_[itShared->first];
+        // already done as short node
+        if (CbcHeuristicNodeSubsetWeight * (numObjects + other->numObjects()) < threshold)
+            continue;
+        int numberUnmatched = numObjects + other->numObjects() - 2 * itShared->second;
+        if (CbcHeuristicNodeSubsetWeight * numberUnmatched >= threshold)
+            continue;
+        if (node->distance(other) < threshold)
+            return true;
+    }
+    return false;
+}
+
 void
 CbcHeuristicNodeList::append(const CbcHeuristicNodeList& nodes)
 {
@@ -996,6 +1091,12 @@ CbcHeuristic::smallBranchAndBound(OsiSolverInterface * solver, int numberNodes,
                 CbcModel model(*solver2);
 		double startTime=model_->getDblParam(CbcModel::CbcStartSeconds);
 		model.setDblParam(CbcModel::CbcStartSeconds,startTime);
+		// or carry on with work clock
+		double startWork = model_->workUnits();
+		if (model_->useWorkClock()) {
+		  model.setUseWorkClock(true);
+		  model.setInitialWork(startWork);
+		}
 		// move seed across
 		model.randomNumberGenerator()->setSeed(model_->randomNumberGenerator()->getSeed());
                 if (numberNodes >= 0) {
@@ -1381,6 +1482,9 @@ CbcHeuristic::smallBranchAndBound(OsiSolverInterface * solver, int numberNodes,
 		    solverD->setHintParam(OsiDoDualInResolve, takeHint, strength);
 #endif
 		    numberNodesDone_ = model.getNodeCount();
+		    // work of sub-tree (if not added in as iterations and nodes)
+		    if (numberNodes >= 0)
+		      model_->addWork(model.workUnits() - startWork);
 #ifdef COIN_DEVELOP
                     printf("sub branch %d nodes, %d iterations - max %d\n",
                            model.getNodeCount(), model.getIterationCount(),
@@ -1564,6 +1668,16 @@ CbcHeuristic::setInputSolution(const double * solution, double objValue)
     }
 }
 
+// Estimated bytes used
+double
+CbcHeuristic::memoryUsed() const
+{
+    double bytes = runNodes_.memoryUsed();
+    if (inputSolution_ && model_)
+        bytes += (model_->getNumCols() + 1) * sizeof(double);
+    return bytes;
+}
+
 //##############################################################################
 
 inline int compare3BranchingObjects(const CbcBranchingObject* br0,
@@ -1590,6 +1704,28 @@ inline bool compareBranchingObjects(const CbcBranchingObject* br0,
 
 //==============================================================================
 
+/* Key used in signature.  Simple integer types are ordered on variable
+   (see CbcBranchingObject::compareOriginalObject) so key on that, other
+   types have their own ordering so just key on type. */
+static inline CoinUInt64 signatureKey(const CbcBranchingObject* br)
+{
+    const int type = br->type();
+    CoinUInt64 key = static_cast<CoinUInt64>(type) << 32;
+    switch (type) {
+    case SimpleIntegerBranchObj:
+    case SimpleIntegerDynamicPseudoCostBranchObj:
+    case LotsizeBranchObj:
+    case DynamicPseudoCostBranchObj:
+        key |= static_cast<unsigned int>(br->variable());
+        break;
+    default:
+        break;
+    }
+    return key;
+}
+
+//==============================================================================
+
 void
 CbcHeuristicNode::gutsOfConstructor(CbcModel& model)
 {
@@ -1646,6 +1782,23 @@ CbcHeuristicNode::gutsOfConstructor(CbcModel& model)
         }
         ++numObjects_;
     }
+    makeSignature();
+}
+
+//==============================================================================
+
+void
+CbcHeuristicNode::makeSignature()
+{
+    signature_.clear();
+    signature_.reserve(numObjects_);
+    for (int i = 0; i < numObjects_; ++i) {
+        // NULL after an overlap (see gutsOfConstructor)
+        if (brObj_[i])
+            signature_.push_back(signatureKey(brObj_[i]));
+    }
+    // brObj_ is sorted by type then original object so this is cheap
+    std::sort(signature_.begin(), signature_.end());
 }
 
 //==============================================================================
@@ -1663,7 +1816,7 @@ CbcHeuristicNode::distance(const CbcHeuristicNode* node) const
 
     const double disjointWeight = 1;
     const double overlapWeight = 0.4;
-    const double subsetWeight = 0.2;
+    const double subsetWeight = CbcHeuristicNodeSubsetWeight;
     int countDisjointWeight = 0;
     int countOverlapWeight = 0;
     int countSubsetWeight = 0;
@@ -1739,6 +1892,35 @@ CbcHeuristicNode::distance(const CbcHeuristicNode* node) const
 
 //==============================================================================
 
+double
+CbcHeuristicNode::distanceLowerBound(const CbcHeuristicNode* node) const
+{
+    /* Every decision not matched in the other node costs subsetWeight
+       and matched ones cost >= 0.  Decisions can only match if keys are
+       equal, so count keys in common. */
+    const std::vector<CoinUInt64>& other = node->signature_;
+    int n0 = static_cast<int>(signature_.size());
+    int n1 = static_cast<int>(other.size());
+    int i = 0;
+    int j = 0;
+    int numberShared = 0;
+    while (i < n0 && j < n1) {
+        if (signature_[i] < other[j]) {
+            ++i;
+        } else if (signature_[i] > other[j]) {
+            ++j;
+        } else {
+            numberShared++;
+            ++i;
+            ++j;
+        }
+    }
+    return CbcHeuristicNodeSubsetWeight *
+           (numObjects_ + node->numObjects_ - 2 * numberShared);
+}
+
+//==============================================================================
+
 CbcHeuristicNode::~CbcHeuristicNode()
 {
     for (int i = 0; i < numObjects_; ++i) {
@@ -1754,7 +1936,10 @@ CbcHeuristicNode::minDistance(const CbcHeuristicNodeList& nodeList) const
 {
     double minDist = COIN_DBL_MAX;
     for (int i = nodeList.size() - 1; i >= 0; --i) {
-        minDist = CoinMin(minDist, distance(nodeList.node(i)));
+        const CbcHeuristicNode* node = nodeList.node(i);
+        // skip exact comparison if can not improve
+        if (distanceLowerBound(node) < minDist)
+            minDist = CoinMin(minDist, distance(node));
     }
     return minDist;
 }
@@ -1765,14 +1950,7 @@ bool
 CbcHeuristicNode::minDistanceIsSmall(const CbcHeuristicNodeList& nodeList,
                                      const double threshold) const
 {
-    for (int i = nodeList.size() - 1; i >= 0; --i) {
-        if (distance(nodeList.node(i)) >= threshold) {
-            continue;
-        } else {
-            return true;
-        }
-    }
-    return false;
+    return nodeList.anyWithin(this, threshold);
 }
 
 //==============================================================================
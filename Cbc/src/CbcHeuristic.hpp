@@ -8,6 +8,8 @@
 
 #include <string>
 #include <vector>
+#include <map>
+#include "CoinTypes.hpp"
 #include "CoinPackedMatrix.hpp"
 #include "OsiCuts.hpp"
 #include "CoinHelperFunctions.hpp"
@@ -28,6 +30,7 @@ class CbcBranchingObject;
 class CbcHeuristicNode {
 private:
     void gutsOfConstructor(CbcModel& model);
+    void makeSignature();
     CbcHeuristicNode();
     CbcHeuristicNode& operator=(const CbcHeuristicNode&);
 private:
@@ -37,24 +40,52 @@ private:
         listed multiple times. E.g., a general integer variable that has
         been branched on multiple times. */
     CbcBranchingObject** brObj_;
+    /** Compact signature of the branching path - one key per entry in
+        brObj_ (type in high word, variable in low word for simple
+        integer types, type only otherwise).  Same order as brObj_ so it
+        is sorted.  Two objects which compare equal always have the same
+        key, so signatures give a cheap lower bound on distance(). */
+    std::vector<CoinUInt64> signature_;
 public:
     CbcHeuristicNode(CbcModel& model);
 
     CbcHeuristicNode(const CbcHeuristicNode& rhs);
     ~CbcHeuristicNode();
     double distance(const CbcHeuristicNode* node) const;
+    /** Lower bound on distance(node) computed from signatures only
+        (no branching object comparisons) */
+    double distanceLowerBound(const CbcHeuristicNode* node) const;
     double minDistance(const CbcHeuristicNodeList& nodeList) const;
     bool minDistanceIsSmall(const CbcHeuristicNodeList& nodeList,
                             const double threshold) const;
     double avgDistance(const CbcHeuristicNodeList& nodeList) const;
+    /// Number of (merged) branching decisions
+    inline int numObjects() const {
+        return numObjects_;
+    }
+    /// Signature of branching path (sorted)
+    inline const std::vector<CoinUInt64>& signature() const {
+        return signature_;
+    }
 };
 
+/** List of nodes where a heuristic was run.
+    Nodes are indexed by signature key and by number of branching
+    decisions so that "is any node within distance d" only has to look
+    at nodes which share keys or are short enough to be close anyway.
+*/
 class CbcHeuristicNodeList {
 private:
     void gutsOfDelete();
     void gutsOfCopy(const CbcHeuristicNodeList& rhs);
+    void addToIndex(int iNode);
 private:
     std::vector<CbcHeuristicNode*> nodes_;
+    /** Inverted index - for each signature key the nodes containing it
+        together with number of times it occurs in that node */
+    std::map<CoinUInt64, std::vector<std::pair<int, int> > > keyIndex_;
+    /// Nodes indexed by number of branching decisions
+    std::map<int, std::vector<int> > sizeIndex_;
 public:
     CbcHeuristicNodeList() {}
     CbcHeuristicNodeList(const CbcHeuristicNodeList& rhs);
@@ -63,12 +94,18 @@ public:
 
     void append(CbcHeuristicNode*& node);
     void append(const CbcHeuristicNodeList& nodes);
+    /** Returns true if some node in list is at distance < threshold
+        from node.  Only nodes whose signature lower bound is below
+        threshold have exact distance computed. */
+    bool anyWithin(const CbcHeuristicNode* node, const double threshold) const;
     inline const CbcHeuristicNode* node(int i) const {
         return nodes_[i];
     }
     inline int size() const {
         return static_cast<int>(nodes_.size());
     }
+    /// Estimated bytes used by nodes and index
+    double memoryUsed() const;
 };
 
 //#############################################################################
@@ -259,6 +296,8 @@ public:
     inline int whereFrom() const {
         return whereFrom_;
     }
+    /// Estimated bytes used (run nodes and input solution)
+    double memoryUsed() const;
     /** Upto this depth we call the tree shallow and the heuristic can be called
         multiple times. That is, the test whether the current node is far from
         the others where the jeuristic was invoked will not be done, only the
@@ -236,6 +236,17 @@ CbcHeuristicDINS::solution(double & solutionValue,
             int nEl = 0;
             double bias = localSpace;
             int okSame = numberKeptSolutions_ - 1;
+            /* If model keeps a solution pool use that rather than own
+               copies - count how many pool solutions differ from best */
+            const CbcSolutionPool * pool = model_->solutionPool();
+            int numberPool = CoinMin(maximumKeepSolutions_ - 1,
+                                     pool->numberSolutions());
+            int * numberDiffer = NULL;
+            if (numberPool > 0 && pool->numberColumns() == newSolver->getNumCols()) {
+                numberDiffer = new int [pool->numberColumns()];
+                pool->countDifferences(bestSolution, numberPool, numberDiffer, 0.5);
+                okSame = numberPool;
+            }
             for (i = 0; i < numberIntegers_; i++) {
                 int iColumn = integerVariable[i];
                 const OsiObject * object = model_->object(i);
@@ -275,10 +286,14 @@ CbcHeuristicDINS::solution(double & solutionValue,
                             canFix = true;
                         } else if (fabs(continuousValue - valueInt) < 10.0*primalTolerance) {
                             int nSame = 1;
-                            //assert (intValue==values_[0][i]);
-                            for (int k = 1; k < numberKeptSolutions_; k++) {
-                                if (intValue == values_[k][i])
-                                    nSame++;
+                            if (numberDiffer) {
+                                nSame += numberPool - numberDiffer[iColumn];
+                            } else {
+                                //assert (intValue==values_[0][i]);
+                                for (int k = 1; k < numberKeptSolutions_; k++) {
+                                    if (intValue == values_[k][i])
+                                        nSame++;
+                                }
                             }
                             if (nSame >= okSame) {
                                 // can fix
@@ -392,6 +407,7 @@ CbcHeuristicDINS::solution(double & solutionValue,
             }
             delete [] element;
             delete [] column;
+            delete [] numberDiffer;
             delete newSolver;
         }
         numberTries_++;
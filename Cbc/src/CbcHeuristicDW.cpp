@@ -20,6 +20,9 @@
 #include "CbcStrategy.hpp"
 #include "ClpPresolve.hpp"
 #include "CglProbing.hpp"
+#ifdef CBC_THREAD
+#include "CbcThread.hpp"
+#endif
 
 static int dummyCallBack(CbcHeuristicDW * /*heuristic*/, 
 			 CbcModel * /*thisModel*/ , int /*whereFrom*/)
@@ -74,6 +77,7 @@ CbcHeuristicDW::setDefaults()
   functionPointer_ = NULL;
   solver_=NULL;
   dwSolver_=NULL;
+  blockSolver_=NULL;
   bestSolution_=NULL;
   continuousSolution_ = NULL;
   fixedDj_ = NULL;
@@ -151,6 +155,8 @@ CbcHeuristicDW::gutsOfCopy(const CbcHeuristicDW & rhs)
     dwSolver_ = rhs.dwSolver_->clone();
   else
     dwSolver_=NULL;
+  // block solvers are created again when needed
+  blockSolver_=NULL;
   if (rhs.saveLower_) {
     int numberColumns = solver_->getNumCols();
     int numberRows = solver_->getNumRows();
@@ -223,6 +229,11 @@ CbcHeuristicDW::gutsOfDelete()
 {
   delete solver_;
   delete dwSolver_;
+  if (blockSolver_) {
+    for (int iBlock=0;iBlock<numberBlocks_;iBlock++)
+      delete blockSolver_[iBlock];
+    delete [] blockSolver_;
+  }
   delete [] bestSolution_;
   delete [] continuousSolution_;
   delete [] fixedDj_;
@@ -246,6 +257,7 @@ CbcHeuristicDW::gutsOfDelete()
   //functionPointer_ = NULL;
   solver_ = NULL;
   dwSolver_=NULL;
+  blockSolver_=NULL;
   bestSolution_=NULL;
   continuousSolution_ = NULL;
   fixedDj_ = NULL;
@@ -638,62 +650,17 @@ int
 	const double * duals = solver->getRowPrice();
 	double * bestSolution2 = CoinCopyOfArray(bestSolution_,
 						 numberColumns);
-	// Column copy
-	const double * element = solver->getMatrixByCol()->getElements();
-	const int * row = solver->getMatrixByCol()->getIndices();
-	const CoinBigIndex * columnStart = solver->getMatrixByCol()->getVectorStarts();
-	const int * columnLength = solver->getMatrixByCol()->getVectorLengths();
-	int numberUsed=0;
-	for (int iBlock=0;iBlock<numberBlocks_;iBlock++) {
-	  int start=startColumnBlock_[iBlock];
-	  int end=startColumnBlock_[iBlock+1];
-	  ClpSimplex * tempModel = new
-	    ClpSimplex(solver->getModelPtr(),
-		       startRowBlock_[iBlock+1]-startRowBlock_[iBlock],
-		       rowsInBlock_+startRowBlock_[iBlock],
-		       end-start,
-		       columnsInBlock_+startColumnBlock_[iBlock]);
-	  tempModel->setLogLevel(0);
-	  tempModel->setDualObjectiveLimit(COIN_DBL_MAX);
-	  double * objectiveX = tempModel->objective();
-	  double * columnLowerX = tempModel->columnLower();
-	  double * columnUpperX = tempModel->columnUpper();
-	  for (int i=start;i<end;i++) {
-	    int jColumn=i-start;
-	    int iColumn=columnsInBlock_[i];
-	    columnLowerX[jColumn]=CoinMax(saveLower_[iColumn],-1.0e12);
-	    columnUpperX[jColumn]=CoinMin(saveUpper_[iColumn],1.0e12);
-	    if (solver->isInteger(iColumn))
-	      tempModel->setInteger(jColumn);
-	    double cost=objectiveX[jColumn];
-	    for (CoinBigIndex j=columnStart[iColumn];
-		 j<columnStart[iColumn]+columnLength[iColumn];j++) {
-	      int iRow = row[j];
-	      double elementValue=element[j];
-	      if (backwardRow_[iRow]>=0) {
-		cost -= elementValue * duals[iRow]; 
-	      }
-	    }
-	    objectiveX[jColumn]=cost;
-	  }
-	  OsiClpSolverInterface solverX(tempModel,true);
-	  CbcModel modelX(solverX);
-	  modelX.setLogLevel(1);
-	  modelX.setMoreSpecialOptions2(57);
-	  // need to stop after solutions and nodes
-	  //modelX.setMaximumNodes(nNodes_);
-	  modelX.setMaximumSolutions(1); 
-	  modelX.branchAndBound();
-	  const double * bestSolutionX = modelX.bestSolution();
-	  if (bestSolutionX) {
-	    whichBlock[numberUsed++]=iBlock;
-	    for (int i=start;i<end;i++) {
-	      int jColumn = i-start;
-	      int iColumn=columnsInBlock_[i];
-	      bestSolution2[iColumn]=bestSolutionX[jColumn];
-	    }
-	  }
+	// Block solves use duals indexed by master row
+	int numberRows = solver->getNumRows();
+	double * masterDuals = new double [numberMasterRows_];
+	for (int iRow=0;iRow<numberRows;iRow++) {
+	  if (backwardRow_[iRow]>=0)
+	    masterDuals[backwardRow_[iRow]]=duals[iRow];
 	}
+	double * blockObjective = new double [2*numberBlocks_];
+	int numberUsed=solveBlocks(masterDuals,bestSolution2,whichBlock,
+				   blockObjective,blockObjective+numberBlocks_);
+	delete [] masterDuals;
 	addDW(bestSolution2,numberUsed,whichBlock);
 	if (!pass_&&false) {
 	  // see if gives a solution
@@ -720,63 +687,18 @@ int
 	dwSolver_->resolve();
 	dwSolver_->setHintParam(OsiDoDualInResolve, takeHint, OsiHintDo);
 	duals = dwSolver_->getRowPrice();
-	numberUsed=0;
+	numberUsed=solveBlocks(duals,bestSolution2,whichBlock,
+			       blockObjective,blockObjective+numberBlocks_);
 	for (int iBlock=0;iBlock<numberBlocks_;iBlock++) {
-	  int start=startColumnBlock_[iBlock];
-	  int end=startColumnBlock_[iBlock+1];
-	  ClpSimplex * tempModel = new
-	    ClpSimplex(solver->getModelPtr(),
-		       startRowBlock_[iBlock+1]-startRowBlock_[iBlock],
-		       rowsInBlock_+startRowBlock_[iBlock],
-		       end-start,
-		       columnsInBlock_+startColumnBlock_[iBlock]);
-	  tempModel->setLogLevel(0);
-	  tempModel->setDualObjectiveLimit(COIN_DBL_MAX);
-	  double * objectiveX = tempModel->objective();
-	  double * columnLowerX = tempModel->columnLower();
-	  double * columnUpperX = tempModel->columnUpper();
 	  double convexityDual = duals[numberMasterRows_+iBlock];
-	  for (int i=start;i<end;i++) {
-	    int jColumn=i-start;
-	    int iColumn=columnsInBlock_[i];
-	    columnLowerX[jColumn]=CoinMax(saveLower_[iColumn],-1.0e12);
-	    columnUpperX[jColumn]=CoinMin(saveUpper_[iColumn],1.0e12);
-	    if (solver->isInteger(iColumn))
-	      tempModel->setInteger(jColumn);
-	    double cost=objectiveX[jColumn];
-	    for (CoinBigIndex j=columnStart[iColumn];
-		 j<columnStart[iColumn]+columnLength[iColumn];j++) {
-	      int iRow = row[j];
-	      double elementValue=element[j];
-	      if (backwardRow_[iRow]>=0) {
-		// duals are from dw
-		cost -= elementValue * duals[backwardRow_[iRow]]; 
-	      }
-	    }
-	    objectiveX[jColumn]=cost;
-	  }
-	  OsiClpSolverInterface solverX(tempModel,true);
-	  solverX.initialSolve();
-	  double cObj=solverX.getObjValue();
-	  CbcModel modelX(solverX);
-	  modelX.setLogLevel(1);
-	  modelX.setMoreSpecialOptions2(57);
-	  modelX.setMaximumSolutions(1); 
-	  modelX.branchAndBound();
 	  sprintf(dwPrint,"Block %d contobj %g intobj %g convdual %g",
-		  iBlock,cObj,modelX.getObjValue(),convexityDual);
+		  iBlock,blockObjective[iBlock],
+		  blockObjective[numberBlocks_+iBlock],convexityDual);
 	  model_->messageHandler()->message(CBC_FPUMP2, model_->messages())
 	    << dwPrint
 	    << CoinMessageEol;
-	  const double * bestSolutionX = modelX.bestSolution();
-	  if (bestSolutionX) {
-	    whichBlock[numberUsed++]=iBlock;
-	    for (int i=start;i<end;i++) {
-	      int iColumn=columnsInBlock_[i];
-	      bestSolution2[iColumn]=bestSolutionX[i-start];
-	    }
-	  }
 	}
+	delete [] blockObjective;
 	addDW(bestSolution2,numberUsed,whichBlock);
 	if (!pass_&&false) {
 	  // see if gives a solution
@@ -2032,6 +1954,168 @@ CbcHeuristicDW::addDW(const double * solution,int numberBlocksUsed,
   }
   return nTotalAdded;
 }
+// Create solvers for blocks (if not already there)
+void 
+CbcHeuristicDW::setupBlockSolvers()
+{
+  if (blockSolver_)
+    return;
+  OsiClpSolverInterface * solver = dynamic_cast<OsiClpSolverInterface *>
+    (solver_);
+  assert (solver);
+  blockSolver_ = new OsiSolverInterface * [numberBlocks_];
+  for (int iBlock=0;iBlock<numberBlocks_;iBlock++) {
+    int start=startColumnBlock_[iBlock];
+    int end=startColumnBlock_[iBlock+1];
+    ClpSimplex * tempModel = new
+      ClpSimplex(solver->getModelPtr(),
+		 startRowBlock_[iBlock+1]-startRowBlock_[iBlock],
+		 rowsInBlock_+startRowBlock_[iBlock],
+		 end-start,
+		 columnsInBlock_+startColumnBlock_[iBlock]);
+    tempModel->setLogLevel(0);
+    tempModel->setDualObjectiveLimit(COIN_DBL_MAX);
+    double * columnLowerX = tempModel->columnLower();
+    double * columnUpperX = tempModel->columnUpper();
+    for (int i=start;i<end;i++) {
+      int jColumn=i-start;
+      int iColumn=columnsInBlock_[i];
+      columnLowerX[jColumn]=CoinMax(saveLower_[iColumn],-1.0e12);
+      columnUpperX[jColumn]=CoinMin(saveUpper_[iColumn],1.0e12);
+      if (solver->isInteger(iColumn))
+	tempModel->setInteger(jColumn);
+    }
+    blockSolver_[iBlock] = new OsiClpSolverInterface(tempModel,true);
+  }
+}
+/* Solve one block subproblem with costs reduced by master duals.
+   Only touches block solver and block part of solution */
+int 
+CbcHeuristicDW::solveBlock(int iBlock, const double * duals, double * solution,
+			   double & continuousObjective, double & integerObjective)
+{
+  OsiSolverInterface * solverX = blockSolver_[iBlock];
+  int start=startColumnBlock_[iBlock];
+  int end=startColumnBlock_[iBlock+1];
+  // Column copy
+  const double * element = solver_->getMatrixByCol()->getElements();
+  const int * row = solver_->getMatrixByCol()->getIndices();
+  const CoinBigIndex * columnStart = solver_->getMatrixByCol()->getVectorStarts();
+  const int * columnLength = solver_->getMatrixByCol()->getVectorLengths();
+  const double * objective = solver_->getObjCoefficients();
+  double * objectiveX = new double [end-start];
+  for (int i=start;i<end;i++) {
+    int iColumn=columnsInBlock_[i];
+    double cost=objective[iColumn];
+    for (CoinBigIndex j=columnStart[iColumn];
+	 j<columnStart[iColumn]+columnLength[iColumn];j++) {
+      int iRow = backwardRow_[row[j]];
+      if (iRow>=0) 
+	cost -= element[j] * duals[iRow]; 
+    }
+    objectiveX[i-start]=cost;
+  }
+  solverX->setObjective(objectiveX);
+  delete [] objectiveX;
+  // warm starts from basis left by last time
+  solverX->resolve();
+  continuousObjective=solverX->getObjValue();
+  CbcModel modelX(*solverX);
+  modelX.setLogLevel(0);
+  modelX.setMoreSpecialOptions2(57);
+  // need to stop after solutions and nodes
+  //modelX.setMaximumNodes(nNodes_);
+  modelX.setMaximumSolutions(1); 
+  modelX.branchAndBound();
+  integerObjective=modelX.getObjValue();
+  const double * bestSolutionX = modelX.bestSolution();
+  if (bestSolutionX) {
+    for (int i=start;i<end;i++) {
+      int iColumn=columnsInBlock_[i];
+      solution[iColumn]=bestSolutionX[i-start];
+    }
+    return 1;
+  } else {
+    return 0;
+  }
+}
+#ifdef CBC_THREAD
+typedef struct {
+  CbcHeuristicDW * heuristic;
+  const double * duals;
+  double * solution;
+  int * found;
+  double * continuousObjective;
+  double * integerObjective;
+  int firstBlock;
+  int increment;
+  int numberBlocks;
+} CbcDWBlockInfo;
+// Solves every increment'th block from firstBlock
+static void * doDWBlockThread(void * voidInfo)
+{
+  CbcDWBlockInfo * info = reinterpret_cast<CbcDWBlockInfo *> (voidInfo);
+  for (int iBlock=info->firstBlock;iBlock<info->numberBlocks;
+       iBlock+=info->increment) 
+    info->found[iBlock] = 
+      info->heuristic->solveBlock(iBlock,info->duals,info->solution,
+				  info->continuousObjective[iBlock],
+				  info->integerObjective[iBlock]);
+  return NULL;
+}
+#endif
+/* Solve all block subproblems.  Blocks write to disjoint parts of
+   solution and results are collected in block order so answer does
+   not depend on number of threads */
+int 
+CbcHeuristicDW::solveBlocks(const double * duals, double * solution,
+			    int * whichBlocks, double * continuousObjective,
+			    double * integerObjective)
+{
+  setupBlockSolvers();
+  // make sure column copy exists before threads look at it
+  solver_->getMatrixByCol();
+  int * found = new int [numberBlocks_];
+  int numberThreads = CoinMin(model_->getNumberThreads(),numberBlocks_);
+#ifdef CBC_THREAD
+  if (numberThreads>1) {
+    Coin_pthread_t * threadId = new Coin_pthread_t [numberThreads];
+    CbcDWBlockInfo * info = new CbcDWBlockInfo [numberThreads];
+    for (int i=0;i<numberThreads;i++) {
+      info[i].heuristic=this;
+      info[i].duals=duals;
+      info[i].solution=solution;
+      info[i].found=found;
+      info[i].continuousObjective=continuousObjective;
+      info[i].integerObjective=integerObjective;
+      info[i].firstBlock=i;
+      info[i].increment=numberThreads;
+      info[i].numberBlocks=numberBlocks_;
+      pthread_create(&(threadId[i].thr), NULL, doDWBlockThread,
+		     info+i);
+    }
+    // wait
+    for (int i=0;i<numberThreads;i++)
+      pthread_join(threadId[i].thr, NULL);
+    delete [] info;
+    delete [] threadId;
+  } else {
+#endif
+    for (int iBlock=0;iBlock<numberBlocks_;iBlock++) 
+      found[iBlock] = solveBlock(iBlock,duals,solution,
+				 continuousObjective[iBlock],
+				 integerObjective[iBlock]);
+#ifdef CBC_THREAD
+  }
+#endif
+  int numberUsed=0;
+  for (int iBlock=0;iBlock<numberBlocks_;iBlock++) {
+    if (found[iBlock])
+      whichBlocks[numberUsed++]=iBlock;
+  }
+  delete [] found;
+  return numberUsed;
+}
 // Pass in a solution
 void 
 CbcHeuristicDW::passInSolution(const double * solution)
@@ -176,6 +176,14 @@ public:
     { return intsInBlock_;}
     /// Objective value (could also check validity)
     double objectiveValue(const double * solution);
+    /** Solve one block subproblem with costs reduced by master duals
+        (indexed by master row).  Puts block part of solution into
+        solution and returns 1 if integer solution found.
+        Each block has its own solver so this can be called for
+        different blocks in parallel.
+    */
+    int solveBlock(int iBlock, const double * duals, double * solution,
+		   double & continuousObjective, double & integerObjective);
 private:
     /// Guts of copy
     void gutsOfCopy(const CbcHeuristicDW & rhs);
@@ -190,6 +198,14 @@ private:
     /// Add DW proposals
     int addDW(const double * solution,int numberBlocksUsed, 
 	      const int * whichBlocks);
+    /// Create solvers for blocks (if not already there)
+    void setupBlockSolvers();
+    /** Solve all block subproblems (in parallel if threads).
+	Returns number of blocks with solutions - in whichBlocks in
+	block order */
+    int solveBlocks(const double * duals, double * solution,
+		    int * whichBlocks, double * continuousObjective,
+		    double * integerObjective);
 protected:
     typedef int (*heuristicCallBack) (CbcHeuristicDW * ,CbcModel *, int) ;
     // Data
@@ -222,6 +238,8 @@ protected:
     OsiSolverInterface * solver_;
     /// DW solver
     OsiSolverInterface * dwSolver_;
+    /// Solver for each block (kept so can warm start)
+    OsiSolverInterface ** blockSolver_;
     /// Best solution found so far
     double * bestSolution_;
     /// Continuous solution
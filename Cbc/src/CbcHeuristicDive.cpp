@@ -905,7 +905,8 @@ CbcHeuristicDive::solution(double & solutionValue, int & numberNodes,
             reasonToStop += 1;
         } else if (iteration > maxIterations_) {
             reasonToStop += 2;
-        } else if (CoinCpuTime() - time1 > maxTime_) {
+        } else if (!model_->useWorkClock() &&
+                   CoinCpuTime() - time1 > maxTime_) {
             reasonToStop += 3;
         } else if (numberSimplexIterations > maxSimplexIterations) {
             reasonToStop += 4;
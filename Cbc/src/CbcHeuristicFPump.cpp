@@ -793,7 +793,8 @@ CbcHeuristicFPump::solution(double & solutionValue,
                 // too many passes anyway
                 exitAll = true;
             }
-            if (maximumTime_ > 0.0 && CoinCpuTime() >= startTime_ + maximumTime_) {
+            if (maximumTime_ > 0.0 && !model_->useWorkClock() &&
+                    CoinCpuTime() >= startTime_ + maximumTime_) {
                 exitAll = true;
                 // force exit
                 switches_ |= 2048;
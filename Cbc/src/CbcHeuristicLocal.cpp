@@ -1632,21 +1632,21 @@ CbcHeuristicCrossover::solution(double & solutionValue,
     double * fixed = new double [numberColumns];
     for (int i = 0; i < numberColumns; i++)
         fixed[i] = -COIN_DBL_MAX;
-    int whichSolution[10];
-    for (int i = 0; i < useNumber; i++)
-        whichSolution[i] = i;
-    for (int i = 0; i < useNumber; i++) {
-        int k = whichSolution[i];
-        const double * solution = model_->savedSolution(k);
-        for (int j = 0; j < numberColumns; j++) {
-            if (solver->isInteger(j)) {
-                if (fixed[j] == -COIN_DBL_MAX)
-                    fixed[j] = floor(solution[j] + 0.5);
-                else if (fabs(fixed[j] - solution[j]) > 1.0e-7)
-                    fixed[j] = COIN_DBL_MAX;
-            }
+    // Best solution and first useNumber-1 in pool - just look at differences
+    const double * bestSolution = model_->bestSolution();
+    const CbcSolutionPool * pool = model_->solutionPool();
+    assert (pool->numberColumns() == numberColumns);
+    int * numberDiffer = new int [numberColumns];
+    pool->countDifferences(bestSolution, useNumber - 1, numberDiffer);
+    for (int j = 0; j < numberColumns; j++) {
+        if (solver->isInteger(j)) {
+            if (!numberDiffer[j])
+                fixed[j] = floor(bestSolution[j] + 0.5);
+            else
+                fixed[j] = COIN_DBL_MAX;
         }
     }
+    delete [] numberDiffer;
     const double * colLower = solver->getColLower();
     for (int i = 0; i < numberColumns; i++) {
         if (solver->isInteger(i)) {
@@ -1685,3 +1685,366 @@ void CbcHeuristicCrossover::setModel(CbcModel * model)
 }
 
 
+
+// Default Constructor
+CbcHeuristicGenetic::CbcHeuristicGenetic()
+        : CbcHeuristic(),
+        timeLimit_(60.0),
+        gapLimit_(-1.0),
+        populationSize_(10),
+        maximumStall_(5),
+        maximumPhases_(1),
+        numberPhases_(0),
+        numberSolutions_(0),
+        localBranchSize_(10),
+        operation_(0)
+{
+    setWhen(3);
+    switches_ |= 16; // needs a solution
+}
+
+// Constructor with model - assumed before cuts
+
+CbcHeuristicGenetic::CbcHeuristicGenetic(CbcModel & model)
+        : CbcHeuristic(model),
+        timeLimit_(60.0),
+        gapLimit_(-1.0),
+        populationSize_(10),
+        maximumStall_(5),
+        maximumPhases_(1),
+        numberPhases_(0),
+        numberSolutions_(0),
+        localBranchSize_(10),
+        operation_(0)
+{
+    setWhen(3);
+    switches_ |= 16; // needs a solution
+}
+
+// Destructor
+CbcHeuristicGenetic::~CbcHeuristicGenetic ()
+{
+}
+
+// Clone
+CbcHeuristic *
+CbcHeuristicGenetic::clone() const
+{
+    return new CbcHeuristicGenetic(*this);
+}
+// Create C++ lines to get to current state
+void
+CbcHeuristicGenetic::generateCpp( FILE * fp)
+{
+    CbcHeuristicGenetic other;
+    fprintf(fp, "0#include \"CbcHeuristicLocal.hpp\"\n");
+    fprintf(fp, "3  CbcHeuristicGenetic genetic(*cbcModel);\n");
+    CbcHeuristic::generateCpp(fp, "genetic");
+    if (timeLimit_ != other.timeLimit_)
+        fprintf(fp, "3  genetic.setTimeLimit(%g);\n", timeLimit_);
+    else
+        fprintf(fp, "4  genetic.setTimeLimit(%g);\n", timeLimit_);
+    if (gapLimit_ != other.gapLimit_)
+        fprintf(fp, "3  genetic.setGapLimit(%g);\n", gapLimit_);
+    else
+        fprintf(fp, "4  genetic.setGapLimit(%g);\n", gapLimit_);
+    if (populationSize_ != other.populationSize_)
+        fprintf(fp, "3  genetic.setPopulationSize(%d);\n", populationSize_);
+    else
+        fprintf(fp, "4  genetic.setPopulationSize(%d);\n", populationSize_);
+    if (maximumStall_ != other.maximumStall_)
+        fprintf(fp, "3  genetic.setMaximumStall(%d);\n", maximumStall_);
+    else
+        fprintf(fp, "4  genetic.setMaximumStall(%d);\n", maximumStall_);
+    if (maximumPhases_ != other.maximumPhases_)
+        fprintf(fp, "3  genetic.setMaximumPhases(%d);\n", maximumPhases_);
+    else
+        fprintf(fp, "4  genetic.setMaximumPhases(%d);\n", maximumPhases_);
+    if (localBranchSize_ != other.localBranchSize_)
+        fprintf(fp, "3  genetic.setLocalBranchSize(%d);\n", localBranchSize_);
+    else
+        fprintf(fp, "4  genetic.setLocalBranchSize(%d);\n", localBranchSize_);
+    fprintf(fp, "3  cbcModel->addHeuristic(&genetic);\n");
+}
+
+// Copy constructor
+CbcHeuristicGenetic::CbcHeuristicGenetic(const CbcHeuristicGenetic & rhs)
+        :
+        CbcHeuristic(rhs),
+        timeLimit_(rhs.timeLimit_),
+        gapLimit_(rhs.gapLimit_),
+        populationSize_(rhs.populationSize_),
+        maximumStall_(rhs.maximumStall_),
+        maximumPhases_(rhs.maximumPhases_),
+        numberPhases_(rhs.numberPhases_),
+        numberSolutions_(rhs.numberSolutions_),
+        localBranchSize_(rhs.localBranchSize_),
+        operation_(rhs.operation_)
+{
+}
+
+// Assignment operator
+CbcHeuristicGenetic &
+CbcHeuristicGenetic::operator=( const CbcHeuristicGenetic & rhs)
+{
+    if (this != &rhs) {
+        CbcHeuristic::operator=(rhs);
+        timeLimit_ = rhs.timeLimit_;
+        gapLimit_ = rhs.gapLimit_;
+        populationSize_ = rhs.populationSize_;
+        maximumStall_ = rhs.maximumStall_;
+        maximumPhases_ = rhs.maximumPhases_;
+        numberPhases_ = rhs.numberPhases_;
+        numberSolutions_ = rhs.numberSolutions_;
+        localBranchSize_ = rhs.localBranchSize_;
+        operation_ = rhs.operation_;
+    }
+    return *this;
+}
+
+// Resets stuff if model changes
+void
+CbcHeuristicGenetic::resetModel(CbcModel * model)
+{
+    CbcHeuristic::resetModel(model);
+}
+// update model
+void CbcHeuristicGenetic::setModel(CbcModel * model)
+{
+    model_ = model;
+}
+int
+CbcHeuristicGenetic::solution(double & solutionValue,
+                              double * betterSolution)
+{
+    if (operation_ == 2)
+        return localBranch(solutionValue, betterSolution);
+    if (when_ == 0)
+        return 0;
+    numCouldRun_++;
+    if (!model_->bestSolution() || !model_->continuousSolver())
+        return 0;
+    // Only after new incumbent
+    if (numberSolutions_ == model_->getSolutionCount() ||
+            numberPhases_ >= maximumPhases_)
+        return 0;
+    numberSolutions_ = model_->getSolutionCount();
+    numberPhases_++;
+    numRuns_++;
+    int numberColumns = model_->solver()->getNumCols();
+    int numberIntegers = model_->numberIntegers();
+    const int * integerVariable = model_->integerVariable();
+    // Population is incumbent and any saved solutions
+    CbcSolutionPool population;
+    population.setMaximumSolutions(populationSize_);
+    int numberSaved = model_->numberSavedSolutions();
+    for (int i = 0; i < numberSaved; i++)
+        population.addSolution(model_->savedSolution(i),
+                               model_->savedSolutionObjective(i),
+                               numberColumns, numberIntegers, integerVariable);
+    double bestValue = CoinMin(solutionValue, model_->getMinimizationObjValue());
+    double endTime = CoinMin(model_->getCurrentSeconds() + timeLimit_,
+                             model_->getMaximumSeconds());
+    double gapLimit = (gapLimit_ >= 0.0) ? gapLimit_ :
+                      model_->getAllowableFractionGap();
+    int numberThreads = CoinMax(1, model_->getNumberThreads());
+    typedef struct {
+        double solutionValue;
+        CbcModel * model;
+        double * solution;
+        int foundSol;
+    } argBundle;
+    argBundle * parameters = new argBundle [numberThreads];
+    int returnCode = 0;
+    int numberStalled = 0;
+    int numberGenerations = 0;
+    int numberImproved = 0;
+    while (numberStalled < maximumStall_) {
+        if (model_->getCurrentSeconds() >= endTime ||
+                model_->maximumSecondsReached())
+            break;
+        double bestPossible = model_->getBestPossibleObjValue();
+        if (bestValue < 1.0e50 && bestPossible > -1.0e50 &&
+                bestValue - bestPossible <=
+                gapLimit * CoinMax(fabs(bestValue), fabs(bestPossible)))
+            break;
+        // Set up one task per thread
+        for (int i = 0; i < numberThreads; i++) {
+            int type = (numberGenerations * numberThreads + i) % 3;
+            if (!type && population.numberSolutions() < 2)
+                type = 1;
+            CbcModel * newModel = createTaskModel(type, population, endTime);
+            parameters[i].solutionValue = newModel->getMinimizationObjValue();
+            parameters[i].model = newModel;
+            parameters[i].solution = new double [numberColumns];
+            parameters[i].foundSol = 0;
+        }
+#ifdef CBC_THREAD
+        if (numberThreads > 1) {
+            void
+            parallelHeuristics (int numberThreads,
+                                int sizeOfData,
+                                void * argBundle);
+            parallelHeuristics(numberThreads,
+                               static_cast<int>(sizeof(argBundle)),
+                               parameters);
+        } else
+#endif
+        {
+            for (int i = 0; i < numberThreads; i++)
+                parameters[i].foundSol =
+                    parameters[i].model->heuristic(0)->solution(parameters[i].solutionValue,
+                                                                parameters[i].solution);
+        }
+        // Merge in task order so result does not depend on timing
+        bool improved = false;
+        for (int i = 0; i < numberThreads; i++) {
+            if (parameters[i].foundSol > 0) {
+                double value = parameters[i].solutionValue;
+                population.addSolution(parameters[i].solution, value,
+                                       numberColumns, numberIntegers,
+                                       integerVariable);
+                if (value < bestValue) {
+                    bestValue = value;
+                    memcpy(betterSolution, parameters[i].solution,
+                           numberColumns*sizeof(double));
+                    returnCode = 1;
+                    improved = true;
+                }
+            }
+            delete [] parameters[i].solution;
+            delete parameters[i].model;
+        }
+        if (improved) {
+            numberImproved++;
+            numberStalled = 0;
+        } else {
+            numberStalled++;
+        }
+        numberGenerations++;
+    }
+    delete [] parameters;
+    if (returnCode)
+        solutionValue = bestValue;
+    char geneticPrint[200];
+    sprintf(geneticPrint, "Genetic phase ran %d generations of %d tasks - %d improvements, population %d",
+            numberGenerations, numberThreads, numberImproved,
+            population.numberSolutions());
+    model_->messageHandler()->message(CBC_FPUMP1, model_->messages())
+    << geneticPrint
+    << CoinMessageEol;
+    return returnCode;
+}
+// Create copy of model to run one task
+CbcModel *
+CbcHeuristicGenetic::createTaskModel(int type, const CbcSolutionPool & population,
+                                     double endTime)
+{
+    int numberColumns = model_->solver()->getNumCols();
+    int numberPopulation = population.numberSolutions();
+    CbcModel * newModel = new CbcModel(*model_);
+    newModel->setContinuousSolver(model_->continuousSolver()->clone());
+    for (int i = 0; i < newModel->numberHeuristics(); i++)
+        delete newModel->heuristic(i);
+    newModel->setNumberHeuristics(0);
+    newModel->setNumberThreads(0);
+    newModel->setMaximumSeconds(endTime);
+    // Start from random member of population
+    int which = static_cast<int> (randomNumberGenerator_.randomDouble() * numberPopulation);
+    which = CoinMin(which, numberPopulation - 1);
+    newModel->deleteSolutions();
+    if (type == 0) {
+        // Parents are random other members
+        int numberParents = CoinMin(numberPopulation - 1, 2);
+        newModel->setMaximumSavedSolutions(numberParents);
+        int start = static_cast<int> (randomNumberGenerator_.randomDouble() * numberPopulation);
+        for (int i = 0; i < numberPopulation && numberParents; i++) {
+            int iParent = (start + i) % numberPopulation;
+            if (iParent == which)
+                continue;
+            newModel->saveExtraSolution(population.solution(iParent),
+                                        population.objectiveValue(iParent));
+            numberParents--;
+        }
+    }
+    // May reduce cutoff so tasks look for better than their member
+    newModel->setBestSolution(population.solution(which), numberColumns,
+                              population.objectiveValue(which));
+    if (type == 0) {
+        CbcHeuristicCrossover crossover(*newModel);
+        crossover.setHeuristicName("genetic crossover");
+        crossover.setFractionSmall(0.3);
+        crossover.setNumberNodes(numberNodes_);
+        crossover.setNumberSolutions(newModel->numberSavedSolutions());
+        newModel->addHeuristic(&crossover);
+    } else if (type == 1) {
+        CbcHeuristicProximity proximity(*newModel);
+        proximity.setHeuristicName("genetic mutation");
+        proximity.setFractionSmall(9999999.0);
+        proximity.setNumberNodes(numberNodes_);
+        proximity.setFeasibilityPumpOptions(-2);
+        newModel->addHeuristic(&proximity);
+    } else {
+        CbcHeuristicGenetic local(*this);
+        local.setHeuristicName("genetic local branching");
+        local.operation_ = 2;
+        local.setModel(newModel);
+        newModel->addHeuristic(&local);
+    }
+    return newModel;
+}
+// Local branching round model best solution
+int
+CbcHeuristicGenetic::localBranch(double & solutionValue,
+                                 double * betterSolution)
+{
+    const double * bestSolution = model_->bestSolution();
+    OsiSolverInterface * continuousSolver = model_->continuousSolver();
+    if (!bestSolution || !continuousSolver)
+        return 0;
+    numRuns_++;
+    double cutoff;
+    model_->solver()->getDblParam(OsiDualObjectiveLimit, cutoff);
+    double direction = model_->solver()->getObjSense();
+    cutoff *= direction;
+    cutoff = CoinMin(cutoff, solutionValue);
+    OsiSolverInterface * solver = continuousSolver->clone();
+    const double * colLower = solver->getColLower();
+    const double * colUpper = solver->getColUpper();
+    int numberIntegers = model_->numberIntegers();
+    const int * integerVariable = model_->integerVariable();
+    // sum of x (at 0) + sum of 1-x (at 1) <= localBranchSize_
+    int * which = new int [numberIntegers];
+    double * element = new double [numberIntegers];
+    double rhs = localBranchSize_;
+    int n = 0;
+    for (int i = 0; i < numberIntegers; i++) {
+        int iColumn = integerVariable[i];
+        if (colLower[iColumn] == 0.0 && colUpper[iColumn] == 1.0) {
+            if (bestSolution[iColumn] > 0.5) {
+                element[n] = -1.0;
+                rhs -= 1.0;
+            } else {
+                element[n] = 1.0;
+            }
+            which[n++] = iColumn;
+        }
+    }
+    int returnCode = 0;
+    if (n > localBranchSize_) {
+        solver->addRow(n, which, element, -COIN_DBL_MAX, rhs);
+        returnCode = smallBranchAndBound(solver, numberNodes_, betterSolution,
+                                         solutionValue, cutoff,
+                                         "CbcHeuristicGenetic");
+        if (returnCode < 0)
+            returnCode = 0; // returned on size
+        if ((returnCode&2) != 0) {
+            // could add cut
+            returnCode &= ~2;
+        }
+    }
+    delete [] which;
+    delete [] element;
+    delete solver;
+    return returnCode;
+}
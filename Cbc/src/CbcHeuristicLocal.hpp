@@ -7,6 +7,7 @@
 #define CbcHeuristicLocal_H
 
 #include "CbcHeuristic.hpp"
+class CbcSolutionPool;
 /** LocalSearch class
  */
 
@@ -267,5 +268,136 @@ protected:
     int useNumber_;
 };
 
+/** Genetic (population based) improvement phase
+
+    Once there is an incumbent this stays in an improvement phase until
+    timeLimit() seconds are used, the gap is below gapLimit() or there
+    is no improvement for maximumStall() generations.  Each generation
+    runs one task per thread (CbcModel::getNumberThreads()), each on its
+    own copy of the model, cycling through
+      crossover of random parents from the population (CbcHeuristicCrossover),
+      mutation by proximity search round a random member (CbcHeuristicProximity),
+      local branching round a random member.
+    Population is kept in a CbcSolutionPool so is free of duplicates
+    and diverse.
+ */
+
+class CbcHeuristicGenetic : public CbcHeuristic {
+public:
+
+    // Default Constructor
+    CbcHeuristicGenetic ();
+
+    /* Constructor with model - assumed before cuts
+    */
+    CbcHeuristicGenetic (CbcModel & model);
+
+    // Copy constructor
+    CbcHeuristicGenetic ( const CbcHeuristicGenetic &);
+
+    // Destructor
+    ~CbcHeuristicGenetic ();
+
+    /// Clone
+    virtual CbcHeuristic * clone() const;
+
+    /// Assignment operator
+    CbcHeuristicGenetic & operator=(const CbcHeuristicGenetic& rhs);
+
+    /// Create C++ lines to get to current state
+    virtual void generateCpp( FILE * fp) ;
+
+    /// Resets stuff if model changes
+    virtual void resetModel(CbcModel * model);
+
+    /// update model (This is needed if cliques update matrix etc)
+    virtual void setModel(CbcModel * model);
+
+    using CbcHeuristic::solution ;
+    /** returns 0 if no solution, 1 if valid solution.
+        Runs improvement phase (at most maximumPhases() times, each
+        after a new incumbent)
+    */
+    virtual int solution(double & objectiveValue,
+                         double * newSolution);
+
+    /// Set seconds to stay in improvement phase
+    inline void setTimeLimit(double value) {
+        timeLimit_ = value;
+    }
+    /// Seconds to stay in improvement phase
+    inline double timeLimit() const {
+        return timeLimit_;
+    }
+    /// Set fractional gap at which to leave phase (-1 use model allowable gap)
+    inline void setGapLimit(double value) {
+        gapLimit_ = value;
+    }
+    /// Fractional gap at which to leave phase
+    inline double gapLimit() const {
+        return gapLimit_;
+    }
+    /// Set maximum size of population
+    inline void setPopulationSize(int value) {
+        populationSize_ = CoinMax(2, value);
+    }
+    /// Maximum size of population
+    inline int populationSize() const {
+        return populationSize_;
+    }
+    /// Set number of generations without improvement before leaving phase
+    inline void setMaximumStall(int value) {
+        maximumStall_ = value;
+    }
+    /// Number of generations without improvement before leaving phase
+    inline int maximumStall() const {
+        return maximumStall_;
+    }
+    /// Set maximum number of phases
+    inline void setMaximumPhases(int value) {
+        maximumPhases_ = value;
+    }
+    /// Maximum number of phases
+    inline int maximumPhases() const {
+        return maximumPhases_;
+    }
+    /// Set number of integers which may change in local branching
+    inline void setLocalBranchSize(int value) {
+        localBranchSize_ = value;
+    }
+    /// Number of integers which may change in local branching
+    inline int localBranchSize() const {
+        return localBranchSize_;
+    }
+
+protected:
+    /// Create copy of model to run one task (0 crossover, 1 proximity, 2 local branching)
+    CbcModel * createTaskModel(int type, const CbcSolutionPool & population,
+                               double endTime) ;
+    /// Local branching round model best solution (when used as task)
+    int localBranch(double & objectiveValue, double * newSolution);
+
+protected:
+    // Data
+    /// Seconds to stay in phase
+    double timeLimit_;
+    /// Fractional gap at which to leave phase
+    double gapLimit_;
+    /// Maximum size of population
+    int populationSize_;
+    /// Generations without improvement before leaving phase
+    int maximumStall_;
+    /// Maximum number of phases
+    int maximumPhases_;
+    /// Number of phases done
+    int numberPhases_;
+    /// Number of solutions so we only do after new solution
+    int numberSolutions_;
+    /// Number of integers which may change in local branching
+    int localBranchSize_;
+    /// 0 driver, 2 local branching task
+    int operation_;
+};
+
 #endif
 
@@ -0,0 +1,187 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include "CbcConfig.h"
+
+#include <vector>
+#ifdef CBC_THREAD
+#include <pthread.h>
+#endif
+
+#include "CbcModel.hpp"
+#include "CbcHeuristic.hpp"
+#include "CbcIncumbentStream.hpp"
+
+// Stream shared by all copies of handler
+class CbcIncumbentStream::Stream {
+public:
+    Stream(CbcIncumbentCallBack callBack, void * userData)
+        : callBack_(callBack),
+          userData_(userData),
+          referenceCount_(1),
+          numberIncumbents_(0),
+          objectiveValue_(COIN_DBL_MAX) {
+#ifdef CBC_THREAD
+        pthread_mutex_init(&mutex_, NULL);
+#endif
+    }
+    ~Stream() {
+#ifdef CBC_THREAD
+        pthread_mutex_destroy(&mutex_);
+#endif
+    }
+    inline void lock() {
+#ifdef CBC_THREAD
+        pthread_mutex_lock(&mutex_);
+#endif
+    }
+    inline void unlock() {
+#ifdef CBC_THREAD
+        pthread_mutex_unlock(&mutex_);
+#endif
+    }
+    CbcIncumbentCallBack callBack_;
+    void * userData_;
+    int referenceCount_;
+    int numberIncumbents_;
+    double objectiveValue_;
+    /// Last incumbent passed on
+    std::vector<double> solution_;
+    /// Work arrays for changes
+    std::vector<int> which_;
+    std::vector<double> values_;
+#ifdef CBC_THREAD
+    pthread_mutex_t mutex_;
+#endif
+};
+
+// Constructor with call back
+CbcIncumbentStream::CbcIncumbentStream (CbcIncumbentCallBack callBack,
+                                        void * userData)
+    : CbcEventHandler(),
+      stream_(new Stream(callBack, userData))
+{
+}
+
+// Copy constructor
+CbcIncumbentStream::CbcIncumbentStream (const CbcIncumbentStream & rhs)
+    : CbcEventHandler(rhs),
+      stream_(rhs.stream_)
+{
+    stream_->lock();
+    stream_->referenceCount_++;
+    stream_->unlock();
+}
+
+// Assignment operator
+CbcIncumbentStream &
+CbcIncumbentStream::operator=( const CbcIncumbentStream & rhs)
+{
+    if (this != &rhs) {
+        CbcEventHandler::operator=(rhs);
+        rhs.stream_->lock();
+        rhs.stream_->referenceCount_++;
+        rhs.stream_->unlock();
+        stream_->lock();
+        bool last = (--stream_->referenceCount_ == 0);
+        stream_->unlock();
+        if (last)
+            delete stream_;
+        stream_ = rhs.stream_;
+    }
+    return *this;
+}
+
+// Clone
+CbcEventHandler *
+CbcIncumbentStream::clone() const
+{
+    return new CbcIncumbentStream(*this);
+}
+
+// Destructor
+CbcIncumbentStream::~CbcIncumbentStream ()
+{
+    stream_->lock();
+    bool last = (--stream_->referenceCount_ == 0);
+    stream_->unlock();
+    if (last)
+        delete stream_;
+}
+
+// Number of incumbents passed on
+int
+CbcIncumbentStream::numberIncumbents() const
+{
+    return stream_->numberIncumbents_;
+}
+
+// Event
+CbcEventHandler::CbcAction
+CbcIncumbentStream::event(CbcEvent whichEvent)
+{
+    if ((whichEvent == solution || whichEvent == heuristicSolution) &&
+            stream_->callBack_ && model_ && !model_->parentModel())
+        newSolution(whichEvent);
+    return CbcEventHandler::event(whichEvent);
+}
+
+// Look at current best solution
+void
+CbcIncumbentStream::newSolution(CbcEvent whichEvent)
+{
+    const double * bestSolution = model_->bestSolution();
+    if (!bestSolution)
+        return;
+    int numberColumns = model_->getNumCols();
+    const int * originalColumns = model_->originalColumns();
+    double objectiveValue = model_->getObjValue();
+    Stream & stream = *stream_;
+    stream.lock();
+    if (static_cast<int>(stream.solution_.size()) != numberColumns) {
+        // first (or model changed) - against zero
+        stream.solution_.assign(numberColumns, 0.0);
+        stream.which_.resize(numberColumns);
+        stream.values_.resize(numberColumns);
+    }
+    double * previous = &stream.solution_[0];
+    int * which = &stream.which_[0];
+    double * values = &stream.values_[0];
+    int numberChanged = 0;
+    for (int i = 0; i < numberColumns; i++) {
+        double value = bestSolution[i];
+        if (value != previous[i]) {
+            previous[i] = value;
+            which[numberChanged] = originalColumns ? originalColumns[i] : i;
+            values[numberChanged++] = value;
+        }
+    }
+    // same solution may come as more than one event
+    if (numberChanged || objectiveValue != stream.objectiveValue_) {
+        stream.objectiveValue_ = objectiveValue;
+        stream.numberIncumbents_++;
+        CbcIncumbentDelta delta;
+        delta.solutionNumber = stream.numberIncumbents_;
+        delta.numberChanged = numberChanged;
+        delta.which = which;
+        delta.values = values;
+        delta.objectiveValue = objectiveValue;
+        if (whichEvent == heuristicSolution && model_->lastHeuristic())
+            delta.source = model_->lastHeuristic()->heuristicName();
+        else if (whichEvent == heuristicSolution)
+            delta.source = "heuristic";
+        else
+            delta.source = "branching";
+        delta.seconds = model_->getCurrentSeconds();
+        stream.callBack_(delta, stream.userData_);
+    }
+    stream.unlock();
+}
+
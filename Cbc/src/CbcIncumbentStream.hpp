@@ -0,0 +1,86 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcIncumbentStream_H
+#define CbcIncumbentStream_H
+
+#include "CbcEventHandler.hpp"
+
+/** One new incumbent given as changes from the previous one.
+
+    The first incumbent is given as changes from all zero, so
+    which/values are the nonzeros.  Arrays are only valid during
+    the call back.
+*/
+struct CbcIncumbentDelta {
+    /// Number of incumbent (1 for first)
+    int solutionNumber;
+    /// Number of values which changed
+    int numberChanged;
+    /** Columns which changed - original column numbers if preprocessing
+        gave original columns (columns removed by preprocessing
+        are never given) */
+    const int * which;
+    /// New values
+    const double * values;
+    /// Objective value (with sense)
+    double objectiveValue;
+    /// Heuristic name or "branching"
+    const char * source;
+    /// Seconds from start of solve (as CbcModel::getCurrentSeconds)
+    double seconds;
+};
+
+/// Call back for new incumbents
+typedef void (*CbcIncumbentCallBack)(const CbcIncumbentDelta & delta,
+                                     void * userData);
+
+/** Event handler which passes each new incumbent to a call back
+    as a sparse change from the previous one.
+
+    Copies (CbcModel clones its event handler) share one stream so
+    changes are always against the last incumbent passed on.  Solutions
+    of sub-models (e.g. from heuristics) are not passed on.  Events are
+    otherwise treated as in CbcEventHandler.
+*/
+
+class CbcIncumbentStream : public CbcEventHandler {
+
+public:
+
+    /// Constructor with call back
+    CbcIncumbentStream (CbcIncumbentCallBack callBack = NULL,
+                        void * userData = NULL);
+
+    /// Copy constructor - shares stream
+    CbcIncumbentStream (const CbcIncumbentStream & rhs);
+
+    /// Assignment operator - shares stream
+    CbcIncumbentStream & operator=(const CbcIncumbentStream & rhs);
+
+    /// Clone
+    virtual CbcEventHandler * clone() const;
+
+    /// Destructor
+    virtual ~CbcIncumbentStream ();
+
+    /// Event - passes on new incumbents
+    virtual CbcAction event(CbcEvent whichEvent);
+
+    /// Number of incumbents passed on
+    int numberIncumbents() const;
+
+private:
+    /// Look at current best solution
+    void newSolution(CbcEvent whichEvent);
+
+private:
+    /// Shared by all copies
+    class Stream;
+    Stream * stream_;
+};
+
+#endif
+
@@ -0,0 +1,75 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include <cstdio>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include "CbcMemory.hpp"
+
+// Default Constructor
+CbcMemory::CbcMemory ()
+{
+    clear();
+}
+
+// Zero all
+void
+CbcMemory::clear()
+{
+    for (int i = 0; i < numberParts; i++)
+        bytes_[i] = 0.0;
+    processBytes_ = 0.0;
+}
+
+// Sum of all parts
+double
+CbcMemory::totalBytes() const
+{
+    double total = 0.0;
+    for (int i = 0; i < numberParts; i++)
+        total += bytes_[i];
+    return total;
+}
+
+// Name of part
+const char *
+CbcMemory::name(int part)
+{
+    static const char * names[] = {
+        "tree nodes", "node information", "node cuts", "global cuts",
+        "solutions", "heuristics", "thread solvers"
+    };
+    if (part >= 0 && part < numberParts)
+        return names[part];
+    else
+        return "unknown";
+}
+
+// Resident size of process now
+double
+CbcMemory::residentBytes()
+{
+    double bytes = 0.0;
+#ifdef __linux__
+    FILE * fp = fopen("/proc/self/statm", "r");
+    if (fp) {
+        long size = 0;
+        long resident = 0;
+        if (fscanf(fp, "%ld %ld", &size, &resident) == 2)
+            bytes = static_cast<double>(resident) *
+                    static_cast<double>(sysconf(_SC_PAGESIZE));
+        fclose(fp);
+    }
+#endif
+    return bytes;
+}
+
@@ -0,0 +1,79 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcMemory_H
+#define CbcMemory_H
+
+/** Estimated bytes used by each part of branch and bound.
+
+    Filled in by CbcModel::memoryUsage from the sizes of what is
+    held (not by counting allocations) so it is only as good as
+    those estimates - e.g. a basis diff is taken as its worst case.
+    Process is the resident size from the operating system (0.0 if
+    not known) so the difference is memory used elsewhere
+    (solver, preprocessing, fragmentation ...).
+*/
+
+class CbcMemory {
+
+public:
+
+    /// Parts
+    enum Part {
+        /// Nodes on tree (including branching objects)
+        treeNodes = 0,
+        /// Node information (bounds and basis diffs)
+        nodeInfo,
+        /// Cuts held by node information
+        nodeCuts,
+        /// Global cut pool
+        globalCuts,
+        /// Best and saved solutions
+        solutions,
+        /// Heuristics (run node lists and input solutions)
+        heuristics,
+        /// Solvers of thread models
+        threads,
+        numberParts
+    };
+
+    /// Default Constructor
+    CbcMemory ();
+
+    /// Zero all
+    void clear();
+    /// Add bytes to part
+    inline void add(Part part, double bytes) {
+        bytes_[part] += bytes;
+    }
+    /// Bytes in part
+    inline double bytes(int part) const {
+        return bytes_[part];
+    }
+    /// Sum of all parts
+    double totalBytes() const;
+    /// Resident size of process when filled in
+    inline double processBytes() const {
+        return processBytes_;
+    }
+    /// Set resident size of process
+    inline void setProcessBytes(double value) {
+        processBytes_ = value;
+    }
+    /// Name of part
+    static const char * name(int part);
+
+    /// Resident size of process now (0.0 if not known)
+    static double residentBytes();
+
+private:
+    /// Bytes in each part
+    double bytes_[numberParts];
+    /// Resident size of process
+    double processBytes_;
+};
+
+#endif
+
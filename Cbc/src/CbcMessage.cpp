@@ -69,6 +69,8 @@ static Cbc_message us_english[] = {
     {CBC_FATHOM_CHANGE, 49, 1, "Complete fathoming at depth >= %d"},
 #endif
     {CBC_MAXITERS, 50, 1, "Exiting on maximum number of iterations"},
+    {CBC_MAXMEMORY, 51, 1, "Exiting on maximum memory"},
+    {CBC_ESTIMATE, 52, 1, "Estimated %.0f nodes remaining (%.0f seconds) - tree size %.0f from backtrack %.0f, leaf frequency %.0f, gap closure %.0f"},
     {CBC_NOINT, 3007, 1, "No integer variables - nothing to do"},
     {CBC_WARNING_STRONG, 3008, 1, "Strong branching is fixing too many variables, too expensively!"},
     {CBC_DUMMY_END, 999999, 0, ""}
@@ -28,6 +28,8 @@ enum CBC_Message {
     CBC_MAXSOLS,
     CBC_EVENT,
     CBC_MAXITERS,
+    CBC_MAXMEMORY,
+    CBC_ESTIMATE,
     CBC_SOLUTION,
     CBC_END_SOLUTION,
     CBC_SOLUTION2,
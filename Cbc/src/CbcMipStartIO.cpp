@@ -1,3 +1,5 @@
+#include "CbcConfig.h"
+
 #include <cstdlib>
 #include <cmath>
 #include <ctime>
@@ -7,8 +9,13 @@
 #include <algorithm>
 #include <vector>
 #include <string>
-#include <map>
+#ifdef CBC_THREAD
+#include <pthread.h>
+#endif
 #include <OsiSolverInterface.hpp>
+#include "CoinTypes.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinPackedMatrix.hpp"
 #include "CbcMessage.hpp"
 #include "CbcHeuristic.hpp"
 #include <CbcModel.hpp>
@@ -29,47 +36,250 @@ bool isNumericStr( const char *str )
    return true;
 }
 
+namespace {
+
+/* binary mipstart - header then values then names
+   (each null terminated) */
+struct CbcStartHeader {
+   char magic[8];
+   int version;
+   int numberValues;
+   double objectiveValue;
+   CoinInt64 lengthNames;
+};
+const char startMagic[8] = {'C','b','c','S','t','a','r','t'};
+
+/* open addressing hash of column names - much less
+   memory and time than a map for millions of columns */
+class CbcNameIndex {
+public:
+   CbcNameIndex( const vector< string > &names )
+      : names_(names)
+   {
+      size_t size = 4;
+      while (size < 2*names.size())
+         size *= 2;
+      mask_ = size-1;
+      slot_ = new int [size];
+      for ( size_t i=0 ; i<size ; ++i )
+         slot_[i] = -1;
+      for ( int i=0 ; i<static_cast<int>(names.size()) ; ++i )
+      {
+         size_t j = hashName( names[i].c_str(), names[i].size() ) & mask_;
+         while (slot_[j]>=0)
+         {
+            if (names[slot_[j]]==names[i])
+               break; // duplicate - keep first
+            j = (j+1) & mask_;
+         }
+         if (slot_[j]<0)
+            slot_[j] = i;
+      }
+   }
+   ~CbcNameIndex()
+   {
+      delete [] slot_;
+   }
+   // index of name or -1
+   int find( const char *name, size_t length ) const
+   {
+      size_t j = hashName( name, length ) & mask_;
+      while (slot_[j]>=0)
+      {
+         const string &thisName = names_[slot_[j]];
+         if (thisName.size()==length&&!memcmp(thisName.c_str(),name,length))
+            return slot_[j];
+         j = (j+1) & mask_;
+      }
+      return -1;
+   }
+   int find( const string &name ) const
+   {
+      return find( name.c_str(), name.size() );
+   }
+private:
+   CbcNameIndex( const CbcNameIndex & );
+   CbcNameIndex & operator=( const CbcNameIndex & );
+   static size_t hashName( const char *name, size_t length )
+   {
+      // FNV-1a
+      unsigned int hash = 2166136261u;
+      for ( size_t i=0 ; i<length ; ++i )
+      {
+         hash ^= static_cast<unsigned char>(name[i]);
+         hash *= 16777619u;
+      }
+      return hash;
+   }
+   const vector< string > &names_;
+   int *slot_;
+   size_t mask_;
+};
+
+/* one line of text mipstart - split in place and
+   add value if line looks like "index name value ..." */
+void parseStartLine( CbcModel * model, const char *fileName, int nLine, char *line,
+                     vector< pair< string, double > > &colValues )
+{
+   char *col[4];
+   int nread = 0;
+   char *p = line;
+   while (*p&&nread<4)
+   {
+      while (*p==' '||*p=='\t'||*p=='\r')
+         p++;
+      if (!*p)
+         break;
+      col[nread++] = p;
+      while (*p&&*p!=' '&&*p!='\t'&&*p!='\r')
+         p++;
+      if (*p)
+         *p++ = '\0';
+   }
+   /* line with variable value */
+   if (nread>=3&&isdigit(col[0][0]))
+   {
+      char printLine[256];
+      if (!isNumericStr(col[0]))
+      {
+         sprintf( printLine, "Reading: %s, line %d - first column in mipstart file should be numeric, ignoring.", fileName, nLine );
+         model->messageHandler()->message(CBC_GENERAL, model->messages()) << printLine << CoinMessageEol;
+         return;
+      }
+      if (!isNumericStr(col[2]))
+      {
+         sprintf( printLine, "Reading: %s, line %d - Third column in mipstart file should be numeric, ignoring.", fileName, nLine  );
+         model->messageHandler()->message(CBC_GENERAL, model->messages()) << printLine << CoinMessageEol;
+         return;
+      }
+      colValues.push_back( pair<string, double>(string(col[1]),strtod(col[2],NULL)) );
+   }
+}
+
+/* reads binary mipstart - file positioned after magic
+   returns 0 if OK */
+int readBinaryStart( FILE *f, vector< pair< string, double > > &colValues,
+                     double &solObj )
+{
+   CbcStartHeader header;
+   memcpy( header.magic, startMagic, 8 );
+   if (fread( &header.version, sizeof(CbcStartHeader)-8, 1, f )!=1)
+      return 1;
+   if (header.version!=1||header.numberValues<0||header.lengthNames<0)
+      return 1;
+   /* check counts against what is left in file before allocating */
+   long position = ftell( f );
+   if (position<0||fseek( f, 0, SEEK_END ))
+      return 1;
+   long endFile = ftell( f );
+   if (endFile<position||fseek( f, position, SEEK_SET ))
+      return 1;
+   double remaining = static_cast<double>(endFile-position);
+   if (static_cast<double>(header.numberValues)*sizeof(double)+
+       static_cast<double>(header.lengthNames)>remaining)
+      return 1;
+   int n = header.numberValues;
+   double *values = new double [CoinMax(n,1)];
+   size_t lengthNames = static_cast<size_t>(header.lengthNames);
+   char *names = new char [lengthNames+1];
+   int returnCode = 0;
+   if (fread( values, sizeof(double), n, f )!=static_cast<size_t>(n)||
+       fread( names, 1, lengthNames, f )!=lengthNames)
+   {
+      returnCode = 1;
+   }
+   else
+   {
+      names[lengthNames] = '\0';
+      colValues.reserve( colValues.size()+n );
+      const char *name = names;
+      const char *endNames = names+lengthNames;
+      for ( int i=0 ; i<n&&name<endNames ; ++i )
+      {
+         size_t length = strlen(name);
+         colValues.push_back( pair<string, double>(string(name,length),values[i]) );
+         name += length+1;
+      }
+      solObj = header.objectiveValue;
+   }
+   delete [] values;
+   delete [] names;
+   return returnCode;
+}
+
+}
+
 int readMIPStart( CbcModel * model, const char *fileName,
                   vector< pair< string, double > > &colValues,
-                  double &/*solObj*/ )
+                  double &solObj )
 {
-#define STR_SIZE 256
-   FILE *f = fopen( fileName, "r" );
+   FILE *f = fopen( fileName, "rb" );
    if (!f)
       return 1;
-   char line[STR_SIZE];
-
-   int nLine = 0;
-   char printLine[STR_SIZE];
-   while (fgets( line, STR_SIZE, f ))
+   char printLine[256];
+   char magic[8];
+   if (fread( magic, 1, 8, f )==8&&!memcmp(magic,startMagic,8))
    {
-      ++nLine;
-      char col[4][STR_SIZE];
-      int nread = sscanf( line, "%s %s %s %s", col[0], col[1], col[2], col[3] );
-      if (!nread)
-         continue;
-      /* line with variable value */
-      if (strlen(col[0])&&isdigit(col[0][0])&&(nread>=3))
+      if (readBinaryStart( f, colValues, solObj ))
+      {
+         sprintf( printLine, "Bad binary mipstart file %s", fileName );
+         model->messageHandler()->message(CBC_GENERAL, model->messages()) << printLine << CoinMessageEol;
+         colValues.clear();
+      }
+   }
+   else
+   {
+      /* text - read in large blocks and split lines in place */
+      rewind(f);
+      size_t blockSize = 1048576;
+      char *buffer = new char [blockSize+1];
+      size_t nInBuffer = 0;
+      int nLine = 0;
+      bool endOfFile = false;
+      while (!endOfFile)
       {
-         if (!isNumericStr(col[0]))
+         if (nInBuffer==blockSize)
          {
-            sprintf( printLine, "Reading: %s, line %d - first column in mipstart file should be numeric, ignoring.", fileName, nLine );
-            model->messageHandler()->message(CBC_GENERAL, model->messages()) << printLine << CoinMessageEol;
-            continue;
+            // one line fills buffer - make bigger
+            char *temp = new char [2*blockSize+1];
+            memcpy( temp, buffer, nInBuffer );
+            delete [] buffer;
+            buffer = temp;
+            blockSize *= 2;
          }
-         if (!isNumericStr(col[2]))
+         size_t nRead = fread( buffer+nInBuffer, 1, blockSize-nInBuffer, f );
+         nInBuffer += nRead;
+         endOfFile = (nRead==0);
+         char *line = buffer;
+         char *end = buffer+nInBuffer;
+         while (line<end)
          {
-            sprintf( printLine, "Reading: %s, line %d - Third column in mipstart file should be numeric, ignoring.", fileName, nLine  );
-            model->messageHandler()->message(CBC_GENERAL, model->messages()) << printLine << CoinMessageEol;
-            continue;
+            char *endLine = static_cast<char *>(memchr( line, '\n', end-line ));
+            if (!endLine)
+            {
+               // partial line - keep for next block unless nothing more to come
+               if (!endOfFile)
+                  break;
+               endLine = end;
+            }
+            *endLine = '\0';
+            ++nLine;
+            parseStartLine( model, fileName, nLine, line, colValues );
+            line = endLine+1;
+         }
+         if (line<end)
+         {
+            nInBuffer = end-line;
+            memmove( buffer, line, nInBuffer );
+         }
+         else
+         {
+            nInBuffer = 0;
          }
-
-         char *name = col[1];
-         double value = atof( col[2] );
-
-         colValues.push_back( pair<string, double>(string(name),value) );
       }
+      delete [] buffer;
    }
+   fclose(f);
 
    if (colValues.size()) {
       sprintf( printLine,"MIPStart values read for %d variables.", static_cast<int>(colValues.size()) );
@@ -78,98 +288,435 @@ int readMIPStart( CbcModel * model, const char *fileName,
           int numberColumns = model->getNumCols();
           OsiSolverInterface *solver = model->solver();
           vector< pair< string, double > > fullValues;
-          /* for fast search of column names */
-          map< string, int > colIdx;
-          for (int i=0;i<numberColumns;i++) {
+          fullValues.reserve(numberColumns);
+          for (int i=0;i<numberColumns;i++)
               fullValues.push_back( pair<string, double>(solver->getColName(i),0.0) );
-              colIdx[solver->getColName(i)] = i;
-          }
+          /* for fast search of column names */
+          vector< string > colNames(numberColumns);
+          for (int i=0;i<numberColumns;i++)
+              colNames[i] = fullValues[i].first;
+          CbcNameIndex colIdx(colNames);
           for ( int i=0 ; (i<static_cast<int>(colValues.size())) ; ++i ) {
-              map< string, int >::const_iterator mIt = colIdx.find( colValues[i].first );
-              if ( mIt != colIdx.end() ) {
-                  const int idx = mIt->second;
-                  double v = colValues[i].second;
-                  fullValues[idx].second=v;
-              }
+              int idx = colIdx.find( colValues[i].first );
+              if ( idx >= 0 )
+                  fullValues[idx].second=colValues[i].second;
           }
-          colValues=fullValues;
+          colValues.swap(fullValues);
       }
-   } 
+   }
    else {
       sprintf( printLine, "No mipstart solution read from %s", fileName );
       model->messageHandler()->message(CBC_GENERAL, model->messages()) << printLine << CoinMessageEol;
       return 1;
    }
 
-   fclose(f);
    return 0;
 }
 
+int writeBinaryMIPStart( const char *fileName, int numberValues,
+                         const double *values, const char *names,
+                         size_t lengthNames, double objectiveValue )
+{
+   FILE *f = fopen( fileName, "wb" );
+   if (!f)
+      return 1;
+   CbcStartHeader header;
+   memset( &header, 0, sizeof(CbcStartHeader) );
+   memcpy( header.magic, startMagic, 8 );
+   header.version = 1;
+   header.numberValues = numberValues;
+   header.objectiveValue = objectiveValue;
+   header.lengthNames = static_cast<CoinInt64>(lengthNames);
+   int returnCode = 0;
+   if (fwrite( &header, sizeof(CbcStartHeader), 1, f )!=1||
+       (numberValues&&fwrite( values, sizeof(double), numberValues, f )!=static_cast<size_t>(numberValues))||
+       (lengthNames&&fwrite( names, 1, lengthNames, f )!=lengthNames))
+      returnCode = 1;
+   if (fclose(f))
+      returnCode = 1;
+   return returnCode;
+}
+
+int writeBinaryMIPStart( const char *fileName, const OsiSolverInterface *solver,
+                         const double *solution, double objectiveValue )
+{
+   int numberColumns = solver->getNumCols();
+   vector< double > values;
+   string names;
+   for ( int i=0 ; i<numberColumns ; ++i )
+   {
+      double value = solution[i];
+      if (solver->isInteger(i))
+         value = floor( value+0.5 );
+      /* columns not in file are taken as zero */
+      if (fabs(value)<1.0e-12)
+         continue;
+      values.push_back(value);
+      names += solver->getColName(i);
+      names += '\0';
+   }
+   return writeBinaryMIPStart( fileName, static_cast<int>(values.size()),
+                               values.size() ? &values[0] : NULL,
+                               names.c_str(), names.size(), objectiveValue );
+}
+
+namespace {
+
+/* Tightens bounds using row activities.
+   Returns -1 if infeasible, otherwise number of integer
+   columns fixed */
+int propagateBounds( const CoinPackedMatrix *rowCopy,
+                     const double *rowLower, const double *rowUpper,
+                     const char *integer, double *lower, double *upper )
+{
+   const double infinity = 1.0e30;
+   const double tolerance = 1.0e-7;
+   const int numberRows = rowCopy->getNumRows();
+   const int numberColumns = rowCopy->getNumCols();
+   const int *column = rowCopy->getIndices();
+   const CoinBigIndex *rowStart = rowCopy->getVectorStarts();
+   const int *rowLength = rowCopy->getVectorLengths();
+   const double *element = rowCopy->getElements();
+   int numberFixedBefore = 0;
+   for ( int i=0 ; i<numberColumns ; ++i )
+      if (integer[i]&&lower[i]==upper[i])
+         numberFixedBefore++;
+   for ( int pass=0 ; pass<10 ; ++pass )
+   {
+      int numberChanged = 0;
+      for ( int iRow=0 ; iRow<numberRows ; ++iRow )
+      {
+         /* minimum and maximum activity with count of infinite terms */
+         double minActivity = 0.0;
+         double maxActivity = 0.0;
+         int nInfiniteMin = 0;
+         int nInfiniteMax = 0;
+         CoinBigIndex start = rowStart[iRow];
+         CoinBigIndex end = start+rowLength[iRow];
+         for ( CoinBigIndex j=start ; j<end ; ++j )
+         {
+            int iColumn = column[j];
+            double value = element[j];
+            if (value>0.0)
+            {
+               if (lower[iColumn]>-infinity)
+                  minActivity += value*lower[iColumn];
+               else
+                  nInfiniteMin++;
+               if (upper[iColumn]<infinity)
+                  maxActivity += value*upper[iColumn];
+               else
+                  nInfiniteMax++;
+            }
+            else
+            {
+               if (upper[iColumn]<infinity)
+                  minActivity += value*upper[iColumn];
+               else
+                  nInfiniteMin++;
+               if (lower[iColumn]>-infinity)
+                  maxActivity += value*lower[iColumn];
+               else
+                  nInfiniteMax++;
+            }
+         }
+         if ((!nInfiniteMin&&minActivity>rowUpper[iRow]+1.0e-6*(1.0+fabs(rowUpper[iRow])))||
+             (!nInfiniteMax&&maxActivity<rowLower[iRow]-1.0e-6*(1.0+fabs(rowLower[iRow]))))
+            return -1;
+         bool useUpper = rowUpper[iRow]<infinity&&nInfiniteMin<=1;
+         bool useLower = rowLower[iRow]>-infinity&&nInfiniteMax<=1;
+         if (!useUpper&&!useLower)
+            continue;
+         for ( CoinBigIndex j=start ; j<end ; ++j )
+         {
+            int iColumn = column[j];
+            double value = element[j];
+            if (lower[iColumn]==upper[iColumn])
+               continue;
+            double newLower = -COIN_DBL_MAX;
+            double newUpper = COIN_DBL_MAX;
+            if (useUpper)
+            {
+               /* activity of rest of row at minimum */
+               double contribution = (value>0.0) ? lower[iColumn] : upper[iColumn];
+               double rest;
+               if (fabs(contribution)>=infinity)
+                  rest = (nInfiniteMin==1) ? minActivity : COIN_DBL_MAX;
+               else
+                  rest = nInfiniteMin ? COIN_DBL_MAX : minActivity-value*contribution;
+               if (rest<COIN_DBL_MAX)
+               {
+                  double bound = (rowUpper[iRow]-rest)/value;
+                  if (value>0.0)
+                     newUpper = bound;
+                  else
+                     newLower = bound;
+               }
+            }
+            if (useLower)
+            {
+               /* activity of rest of row at maximum */
+               double contribution = (value>0.0) ? upper[iColumn] : lower[iColumn];
+               double rest;
+               if (fabs(contribution)>=infinity)
+                  rest = (nInfiniteMax==1) ? maxActivity : -COIN_DBL_MAX;
+               else
+                  rest = nInfiniteMax ? -COIN_DBL_MAX : maxActivity-value*contribution;
+               if (rest>-COIN_DBL_MAX)
+               {
+                  double bound = (rowLower[iRow]-rest)/value;
+                  if (value>0.0)
+                     newLower = CoinMax(newLower,bound);
+                  else
+                     newUpper = CoinMin(newUpper,bound);
+               }
+            }
+            if (integer[iColumn])
+            {
+               if (newUpper<COIN_DBL_MAX)
+                  newUpper = floor( newUpper+1.0e-6 );
+               if (newLower>-COIN_DBL_MAX)
+                  newLower = ceil( newLower-1.0e-6 );
+            }
+            if (newUpper<upper[iColumn]-tolerance)
+            {
+               /* only worth moving continuous if large change */
+               if (integer[iColumn]||newUpper<upper[iColumn]-1.0e-3*(1.0+fabs(newUpper)))
+               {
+                  upper[iColumn] = newUpper;
+                  numberChanged++;
+               }
+            }
+            if (newLower>lower[iColumn]+tolerance)
+            {
+               if (integer[iColumn]||newLower>lower[iColumn]+1.0e-3*(1.0+fabs(newLower)))
+               {
+                  lower[iColumn] = newLower;
+                  numberChanged++;
+               }
+            }
+            if (upper[iColumn]<lower[iColumn]-tolerance)
+               return -1;
+            if (upper[iColumn]<lower[iColumn]+tolerance)
+               upper[iColumn] = lower[iColumn];
+         }
+      }
+      if (!numberChanged)
+         break;
+   }
+   int numberFixed = 0;
+   for ( int i=0 ; i<numberColumns ; ++i )
+      if (integer[i]&&lower[i]==upper[i])
+         numberFixed++;
+   return numberFixed-numberFixedBefore;
+}
+
+/* one way of completing mipstart */
+struct CbcStartCandidate {
+   /* 0 fix all given, 1 fix given integers, 2 fix given nonzeros */
+   int type;
+   /* -1 not tried, 0 integer solution, 1 fractional, 2 infeasible */
+   int status;
+   /* integers fixed by propagation */
+   int numberPropagated;
+   /* true if no LP needed */
+   bool noLp;
+   double objective;
+   /* owned - bounds as used */
+   OsiSolverInterface *lp;
+   double *solution;
+   /* shared */
+   const double *value;
+   const char *integer;
+   const CoinPackedMatrix *rowCopy;
+};
+
+/* Completes candidate - propagation then LP on what is left
+   (presolve removes fixed columns).  No messages so can be
+   run in parallel. */
+void completeCandidate( CbcStartCandidate &candidate )
+{
+   OsiSolverInterface *lp = candidate.lp;
+   const int numberColumns = lp->getNumCols();
+   const int numberRows = lp->getNumRows();
+   const double *value = candidate.value;
+   const char *integer = candidate.integer;
+   double *lower = CoinCopyOfArray( lp->getColLower(), numberColumns );
+   double *upper = CoinCopyOfArray( lp->getColUpper(), numberColumns );
+   for ( int i=0 ; i<numberColumns ; ++i )
+   {
+      double v = value[i];
+      if (v==COIN_DBL_MAX)
+         continue;
+      if (candidate.type==1&&!integer[i])
+         continue;
+      if (candidate.type==2&&!v)
+         continue;
+      lower[i] = v;
+      upper[i] = v;
+   }
+   /* continuous bounds from propagation only used if all fixed */
+   double *lowerLp = CoinCopyOfArray( lower, numberColumns );
+   double *upperLp = CoinCopyOfArray( upper, numberColumns );
+   candidate.numberPropagated = propagateBounds( candidate.rowCopy,
+                                lp->getRowLower(), lp->getRowUpper(), integer, lower, upper );
+   candidate.solution = new double [numberColumns];
+   if (candidate.numberPropagated<0)
+   {
+      candidate.status = 2;
+   }
+   else
+   {
+      bool allFixed = true;
+      for ( int i=0 ; i<numberColumns ; ++i )
+      {
+         if (upper[i]>lower[i])
+         {
+            allFixed = false;
+            break;
+         }
+      }
+      if (allFixed)
+      {
+         /* check without LP */
+         double primalTolerance;
+         lp->getDblParam( OsiPrimalTolerance, primalTolerance );
+         double offset;
+         lp->getDblParam( OsiObjOffset, offset );
+         const double *objective = lp->getObjCoefficients();
+         const double *rowLower = lp->getRowLower();
+         const double *rowUpper = lp->getRowUpper();
+         double objValue = -offset;
+         for ( int i=0 ; i<numberColumns ; ++i )
+         {
+            candidate.solution[i] = lower[i];
+            objValue += lower[i]*objective[i];
+         }
+         double *rowActivity = new double [numberRows];
+         CoinZeroN( rowActivity, numberRows );
+         lp->getMatrixByCol()->times( candidate.solution, rowActivity );
+         bool feasible = true;
+         for ( int i=0 ; i<numberRows ; ++i )
+         {
+            if (rowActivity[i]<rowLower[i]-10.0*primalTolerance||
+                rowActivity[i]>rowUpper[i]+10.0*primalTolerance)
+            {
+               feasible = false;
+               break;
+            }
+         }
+         delete [] rowActivity;
+         if (feasible)
+         {
+            candidate.status = 0;
+            candidate.noLp = true;
+            candidate.objective = objValue;
+         }
+      }
+      if (candidate.status<0)
+      {
+         for ( int i=0 ; i<numberColumns ; ++i )
+         {
+            if (integer[i])
+            {
+               lowerLp[i] = lower[i];
+               upperLp[i] = upper[i];
+            }
+         }
+         lp->setColLower( lowerLp );
+         lp->setColUpper( upperLp );
+         lp->setDblParam( OsiDualObjectiveLimit, COIN_DBL_MAX );
+         lp->setHintParam( OsiDoPresolveInInitial, true, OsiHintDo );
+         lp->initialSolve();
+         if (lp->isProvenOptimal())
+         {
+            candidate.objective = lp->getObjValue();
+            CoinMemcpyN( lp->getColSolution(), numberColumns, candidate.solution );
+            candidate.status = lp->getFractionalIndices().size() ? 1 : 0;
+         }
+         else
+         {
+            candidate.status = 2;
+         }
+      }
+   }
+   delete [] lower;
+   delete [] upper;
+   delete [] lowerLp;
+   delete [] upperLp;
+}
+
+#ifdef CBC_THREAD
+static void * doCandidateThread( void *voidInfo )
+{
+   completeCandidate( *reinterpret_cast<CbcStartCandidate *>(voidInfo) );
+   return NULL;
+}
+#endif
+
+}
+
 int computeCompleteSolution( CbcModel * model,
-                             const vector< string > colNames,
+                             const vector< string > &colNames,
                              const std::vector< std::pair< std::string, double > > &colValues,
                              double *sol, double &obj )
 {
    if (!model->getNumCols())
        return 0;
-   
+
    int status = 0;
    double compObj = COIN_DBL_MAX;
    bool foundIntegerSol = false;
-   OsiSolverInterface *lp = model->solver()->clone();
-   map< string, int > colIdx;
-   assert( (static_cast<int>(colNames.size())) == lp->getNumCols() );
+   OsiSolverInterface *solver = model->solver();
+   const int numberColumns = solver->getNumCols();
+   assert( (static_cast<int>(colNames.size())) == numberColumns );
    /* for fast search of column names */
-   for ( int i=0 ; (i<static_cast<int>(colNames.size())) ; ++i )
-      colIdx[colNames[i]] = i;
+   CbcNameIndex colIdx(colNames);
 
-   char printLine[STR_SIZE];
+   char printLine[512];
    int fixed = 0;
    int notFound = 0;
    char colNotFound[256] = "";
    int nContinuousFixed = 0;
-
-#ifndef JUST_FIX_INTEGER
-#define JUST_FIX_INTEGER 0
-#endif
-
-#if JUST_FIX_INTEGER > 1
-   // all not mentioned are at zero
-   for ( int i=0 ; (i<lp->getNumCols()) ; ++i )
+   /* given values (COIN_DBL_MAX if none) */
+   double *value = new double [numberColumns];
+   char *integer = new char [numberColumns];
+   for ( int i=0 ; i<numberColumns ; ++i )
    {
-       if (lp->isInteger(i))
-         lp->setColBounds( i, 0.0, 0.0 );
-   } 
-#endif
+      value[i] = COIN_DBL_MAX;
+      integer[i] = solver->isInteger(i) ? 1 : 0;
+   }
+
    for ( int i=0 ; (i<static_cast<int>(colValues.size())) ; ++i )
    {
-      map< string, int >::const_iterator mIt = colIdx.find( colValues[i].first );
-      if ( mIt == colIdx.end() )
+      const int idx = colIdx.find( colValues[i].first );
+      if ( idx < 0 )
       {
          if (!notFound)
-            strcpy( colNotFound, colValues[i].first.c_str() );
+         {
+            strncpy( colNotFound, colValues[i].first.c_str(), 255 );
+            colNotFound[255] = '\0';
+         }
          notFound++;
       }
       else
       {
-         const int idx = mIt->second;
          double v = colValues[i].second;
-#if JUST_FIX_INTEGER
-         if (!lp->isInteger(idx))
-            continue;
-#endif
          if (v<1e-8)
             v = 0.0;
-         if (lp->isInteger(idx))  // just to avoid small
+         if (integer[idx])  // just to avoid small
             v = floor( v+0.5 );   // fractional garbage
          else
             nContinuousFixed++;
 
-         lp->setColBounds( idx, v, v );
+         value[idx] = v;
          ++fixed;
       }
    }
 
+   CbcStartCandidate candidate[3];
+   int numberCandidates = 0;
+   int chosen = -1;
    if (!fixed)
    {
       model->messageHandler()->message(CBC_GENERAL, model->messages())
@@ -183,99 +730,125 @@ int computeCompleteSolution( CbcModel * model,
         model->messageHandler()->message(CBC_GENERAL, model->messages())
         << printLine << CoinMessageEol;
    }
-#if JUST_FIX_INTEGER
-   lp->setHintParam(OsiDoPresolveInInitial, true, OsiHintDo) ;
-#endif
-   lp->setDblParam(OsiDualObjectiveLimit,COIN_DBL_MAX);
-   lp->initialSolve();
-
-   if ( (lp->isProvenPrimalInfeasible()) || (lp->isProvenDualInfeasible()) )
    {
-      if (nContinuousFixed) {
-         model->messageHandler()->message(CBC_GENERAL, model->messages())
-            << "Trying just fixing integer variables." << CoinMessageEol;
-         int numberColumns = lp->getNumCols();
-         const double *oldLower = model->solver()->getColLower();
-         const double *oldUpper = model->solver()->getColUpper();
-         for ( int i=0 ; i<numberColumns ; ++i ) {
-            if (!lp->isInteger(i)) { 
-               lp->setColLower(i,oldLower[i]);
-               lp->setColUpper(i,oldUpper[i]);
+      /* Candidates in order of preference - if fixing everything
+         fails then try just fixing integers (or non zero values
+         if all integer).  With threads all are done in parallel. */
+      int numberThreads = 0;
+#ifdef CBC_THREAD
+      numberThreads = model->getNumberThreads();
+#endif
+      int types[3];
+      types[numberCandidates++] = 0;
+      if (nContinuousFixed)
+         types[numberCandidates++] = 1;
+      if (!nContinuousFixed||numberThreads>1)
+         types[numberCandidates++] = 2;
+      /* row copy made here so threads only read it */
+      const CoinPackedMatrix *rowCopy = solver->getMatrixByRow();
+      for ( int i=0 ; i<numberCandidates ; ++i )
+      {
+         candidate[i].type = types[i];
+         candidate[i].status = -1;
+         candidate[i].numberPropagated = 0;
+         candidate[i].noLp = false;
+         candidate[i].objective = COIN_DBL_MAX;
+         candidate[i].lp = NULL;
+         candidate[i].solution = NULL;
+         candidate[i].value = value;
+         candidate[i].integer = integer;
+         candidate[i].rowCopy = rowCopy;
+      }
+#ifdef CBC_THREAD
+      if (numberThreads>1&&numberCandidates>1)
+      {
+         for ( int i=0 ; i<numberCandidates ; ++i )
+            candidate[i].lp = solver->clone();
+         pthread_t threadId[3];
+         for ( int i=0 ; i<numberCandidates ; ++i )
+            pthread_create( threadId+i, NULL, doCandidateThread, candidate+i );
+         for ( int i=0 ; i<numberCandidates ; ++i )
+            pthread_join( threadId[i], NULL );
+      }
+#endif
+      for ( int i=0 ; i<numberCandidates ; ++i )
+      {
+         if (candidate[i].status<0)
+         {
+            if (i)
+            {
+               if (candidate[i].type==1)
+                  model->messageHandler()->message(CBC_GENERAL, model->messages())
+                     << "Trying just fixing integer variables." << CoinMessageEol;
+               else
+                  model->messageHandler()->message(CBC_GENERAL, model->messages())
+                     << "Fixing only non-zero variables." << CoinMessageEol;
             }
+            candidate[i].lp = solver->clone();
+            completeCandidate( candidate[i] );
+            if (candidate[i].status<2)
+               break;
          }
-
-         lp->initialSolve();
       }
-      else
+      /* best integer solution - otherwise first fractional */
+      for ( int i=0 ; i<numberCandidates ; ++i )
+      {
+         if (!candidate[i].status&&(chosen<0||candidate[i].objective<candidate[chosen].objective))
+            chosen = i;
+      }
+      if (chosen<0)
+      {
+         for ( int i=0 ; i<numberCandidates ; ++i )
+         {
+            if (candidate[i].status==1)
+            {
+               chosen = i;
+               break;
+            }
+         }
+      }
+      if (chosen>=0&&candidate[chosen].numberPropagated)
       {
+         sprintf( printLine,"MIPStart bound propagation fixed %d more integer variables%s.",
+                  candidate[chosen].numberPropagated,
+                  candidate[chosen].noLp ? " - no LP needed" : "" );
          model->messageHandler()->message(CBC_GENERAL, model->messages())
-             << "Fixing only non-zero variables." << CoinMessageEol;
-         /* unfix all variables which are zero */
-         int notZeroAnymore = 0;
-         for ( int i=0 ; (i<lp->getNumCols()) ; ++i )
-             if ( ((fabs(lp->getColLower()[i])) <= 1e-8) && (fabs(lp->getColLower()[i]-lp->getColUpper()[i]) <= 1e-8) )
-             {
-                const double *oldLower = model->solver()->getColLower();
-                const double *oldUpper = model->solver()->getColUpper();
-                lp->setColLower(i,oldLower[i]);
-                lp->setColUpper(i,oldUpper[i]);
-                notZeroAnymore++;
-             }
-         if (notZeroAnymore)
-             lp->initialSolve();
+            << printLine << CoinMessageEol;
       }
    }
 
-   if (!lp->isProvenOptimal())
+   if (chosen<0)
    {
       model->messageHandler()->message(CBC_GENERAL, model->messages())
            << "Warning: mipstart values could not be used to build a solution." << CoinMessageEol;
       status = 1;
       goto TERMINATE;
    }
-    
+
    /* some additional effort is needed to provide an integer solution */
-   if ( lp->getFractionalIndices().size() > 0 )
+   if ( candidate[chosen].status == 1 )
    {
+      OsiSolverInterface *lp = candidate[chosen].lp;
       sprintf( printLine,"MIPStart solution provided values for %d of %d integer variables, %d variables are still fractional.", fixed, lp->getNumIntegers(), static_cast<int>(lp->getFractionalIndices().size()) );
       model->messageHandler()->message(CBC_GENERAL, model->messages())
 	<< printLine << CoinMessageEol;
       double start = CoinCpuTime();
-#if 1
       CbcSerendipity heuristic(*model);
       heuristic.setFractionSmall(2.0);
       heuristic.setFeasibilityPumpOptions(1008013);
       int returnCode = heuristic.smallBranchAndBound(lp,
 						     1000, sol,
 						     compObj,
-						     model->getCutoff(), 
+						     model->getCutoff(),
 						     "ReduceInMIPStart");
       if ((returnCode&1) != 0) {
-         sprintf( printLine,"Mini branch and bound defined values for remaining variables in %.2f seconds.", 
+         sprintf( printLine,"Mini branch and bound defined values for remaining variables in %.2f seconds.",
 		  CoinCpuTime()-start);
 	 model->messageHandler()->message(CBC_GENERAL, model->messages())
 	   << printLine << CoinMessageEol;
          foundIntegerSol = true;
          obj = compObj;
       }
-#else
-      CbcModel babModel( *lp );
-      lp->writeLp("lessFix");
-      babModel.setLogLevel( 2 );
-      babModel.setMaximumNodes( 1000 );
-      babModel.setMaximumSeconds( 60 );
-      babModel.branchAndBound();
-      if (babModel.bestSolution())
-      {
-         sprintf( printLine,"Mini branch and bound defined values for remaining variables in %.2f seconds.", 
-		  CoinCpuTime()-start);
-	 model->messageHandler()->message(CBC_GENERAL, model->messages())
-	   << printLine << CoinMessageEol;
-         copy( babModel.bestSolution(), babModel.bestSolution()+babModel.getNumCols(), sol );
-         foundIntegerSol = true;
-         obj = compObj = babModel.getObjValue();
-      }
-#endif
       else
       {
           model->messageHandler()->message(CBC_GENERAL, model->messages())
@@ -287,8 +860,8 @@ int computeCompleteSolution( CbcModel * model,
    else
    {
       foundIntegerSol = true;
-      obj = compObj = lp->getObjValue();
-      copy( lp->getColSolution(), lp->getColSolution()+lp->getNumCols(), sol );
+      obj = compObj = candidate[chosen].objective;
+      CoinMemcpyN( candidate[chosen].solution, numberColumns, sol );
    }
 
    if ( foundIntegerSol )
@@ -296,243 +869,20 @@ int computeCompleteSolution( CbcModel * model,
       sprintf( printLine,"MIPStart provided solution with cost %g", compObj);
       model->messageHandler()->message(CBC_GENERAL, model->messages())
            << printLine << CoinMessageEol;
-#if 0
+      for ( int i=0 ; i<numberColumns ; ++i )
       {
-	int numberColumns=lp->getNumCols();
-	double largestInfeasibility = 0.0;
-	double primalTolerance ;
-	double offset;
-	lp->getDblParam(OsiObjOffset, offset);
-	lp->getDblParam(OsiPrimalTolerance, primalTolerance) ;
-	const double *objective = lp->getObjCoefficients() ;
-	const double * rowLower = lp->getRowLower() ;
-	const double * rowUpper = lp->getRowUpper() ;
-	const double * columnLower = lp->getColLower() ;
-	const double * columnUpper = lp->getColUpper() ;
-	int numberRows = lp->getNumRows() ;
-	double *rowActivity = new double[numberRows] ;
-	memset(rowActivity, 0, numberRows*sizeof(double)) ;
-	double *rowSum = new double[numberRows] ;
-	memset(rowSum, 0, numberRows*sizeof(double)) ;
-	const double * element = lp->getMatrixByCol()->getElements();
-	const int * row = lp->getMatrixByCol()->getIndices();
-	const CoinBigIndex * columnStart = lp->getMatrixByCol()->getVectorStarts();
-	const int * columnLength = lp->getMatrixByCol()->getVectorLengths();
-	const CoinPackedMatrix * rowCopy = lp->getMatrixByRow();
-	const int * column = rowCopy->getIndices();
-	const int * rowLength = rowCopy->getVectorLengths();
-	const CoinBigIndex * rowStart = rowCopy->getVectorStarts();
-	const double * elementByRow = rowCopy->getElements();
-	double objValue=-offset;
-	for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
-	  double value = sol[iColumn];
-	  if (lp->isInteger(iColumn))
-	    assert (fabs(value-floor(value+0.5))<1.0e-6);
-	  objValue += value*objective[iColumn];
-	  if (value>columnUpper[iColumn]) {
-	    if (value-columnUpper[iColumn]>1.0e-8)
-	      printf("column %d has value %.12g above %.12g\n",iColumn,value,columnUpper[iColumn]);
-	    value=columnUpper[iColumn];
-	  } else if (value<columnLower[iColumn]) {
-	    if (value-columnLower[iColumn]<-1.0e-8)
-	      printf("column %d has value %.12g below %.12g\n",iColumn,value,columnLower[iColumn]);
-	    value=columnLower[iColumn];
-	  }
-	  if (value) {
-	    CoinBigIndex start = columnStart[iColumn];
-	    CoinBigIndex end = start + columnLength[iColumn];
-	    for (CoinBigIndex j = start; j < end; j++) {
-	      int iRow = row[j];
-	      if (fabs(value)<1.0e-6&&fabs(value*element[j])>1.0e-5)
-		printf("Column %d row %d value %.8g element %g %s\n",
-		       iColumn,iRow,value,element[j],lp->isInteger(iColumn) ? "integer" : "");
-	      rowActivity[iRow] += value * element[j];
-	      rowSum[iRow] += fabs(value * element[j]);
-	    }
-	  }
-	}
-	for (int i = 0 ; i < numberRows ; i++) {
-#if 0 //def CLP_INVESTIGATE
-	  double inf;
-	  inf = rowLower[i] - rowActivity[i];
-	  if (inf > primalTolerance)
-	    printf("Row %d inf %g sum %g %g <= %g <= %g\n",
-		   i, inf, rowSum[i], rowLower[i], rowActivity[i], rowUpper[i]);
-	  inf = rowActivity[i] - rowUpper[i];
-	  if (inf > primalTolerance)
-	    printf("Row %d inf %g sum %g %g <= %g <= %g\n",
-		   i, inf, rowSum[i], rowLower[i], rowActivity[i], rowUpper[i]);
-#endif
-	  double infeasibility = CoinMax(rowActivity[i]-rowUpper[i],
-					 rowLower[i]-rowActivity[i]);
-	  // but allow for errors
-	  double factor = CoinMax(1.0,rowSum[i]*1.0e-3);
-	  if (infeasibility>largestInfeasibility*factor) {
-	    largestInfeasibility = infeasibility/factor;
-	    printf("Cinf of %g on row %d sum %g scaled %g\n",
-		   infeasibility,i,rowSum[i],largestInfeasibility);
-	    if (infeasibility>1.0e10) {
-	      for (CoinBigIndex j=rowStart[i];
-		   j<rowStart[i]+rowLength[i];j++) {
-		printf("col %d element %g\n",
-		       column[j],elementByRow[j]);
-	      }
-	    }
-	  }
-	}
-	delete [] rowActivity ;
-	delete [] rowSum;
-	if (largestInfeasibility > 10.0*primalTolerance)
-	  printf("Clargest infeasibility is %g - obj %g\n", largestInfeasibility,objValue);
-	else
-	  printf("Cfeasible (%g) - obj %g\n", largestInfeasibility,objValue);
-      }
-#endif
-      for ( int i=0 ; (i<lp->getNumCols()) ; ++i )
-      {
-#if 0
-         if (sol[i]<1e-8)
-            sol[i] = 0.0;
-         else
-            if (lp->isInteger(i))
-               sol[i] = floor( sol[i]+0.5 );
-#else
-	 if (lp->isInteger(i)) {
-	   //if (fabs(sol[i] - floor( sol[i]+0.5 ))>1.0e-8) 
-	   //printf("bad sol for %d - %.12g\n",i,sol[i]);
+	 if (integer[i])
 	   sol[i] = floor( sol[i]+0.5 );
-	 }
-#endif
-      }
-#if 0
-      {
-	int numberColumns=lp->getNumCols();
-	double largestInfeasibility = 0.0;
-	double primalTolerance ;
-	double offset;
-	lp->getDblParam(OsiObjOffset, offset);
-	lp->getDblParam(OsiPrimalTolerance, primalTolerance) ;
-	const double *objective = lp->getObjCoefficients() ;
-	const double * rowLower = lp->getRowLower() ;
-	const double * rowUpper = lp->getRowUpper() ;
-	const double * columnLower = lp->getColLower() ;
-	const double * columnUpper = lp->getColUpper() ;
-	int numberRows = lp->getNumRows() ;
-	double *rowActivity = new double[numberRows] ;
-	memset(rowActivity, 0, numberRows*sizeof(double)) ;
-	double *rowSum = new double[numberRows] ;
-	memset(rowSum, 0, numberRows*sizeof(double)) ;
-	const double * element = lp->getMatrixByCol()->getElements();
-	const int * row = lp->getMatrixByCol()->getIndices();
-	const CoinBigIndex * columnStart = lp->getMatrixByCol()->getVectorStarts();
-	const int * columnLength = lp->getMatrixByCol()->getVectorLengths();
-	const CoinPackedMatrix * rowCopy = lp->getMatrixByRow();
-	const int * column = rowCopy->getIndices();
-	const int * rowLength = rowCopy->getVectorLengths();
-	const CoinBigIndex * rowStart = rowCopy->getVectorStarts();
-	const double * elementByRow = rowCopy->getElements();
-	double objValue=-offset;
-	for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
-	  double value = sol[iColumn];
-	  if (lp->isInteger(iColumn))
-	    assert (fabs(value-floor(value+0.5))<1.0e-6);
-	  objValue += value*objective[iColumn];
-	  if (value>columnUpper[iColumn]) {
-	    if (value-columnUpper[iColumn]>1.0e-8)
-	      printf("column %d has value %.12g above %.12g\n",iColumn,value,columnUpper[iColumn]);
-	    value=columnUpper[iColumn];
-	  } else if (value<columnLower[iColumn]) {
-	    if (value-columnLower[iColumn]<-1.0e-8)
-	      printf("column %d has value %.12g below %.12g\n",iColumn,value,columnLower[iColumn]);
-	    value=columnLower[iColumn];
-	  }
-	  if (value) {
-	    CoinBigIndex start = columnStart[iColumn];
-	    CoinBigIndex end = start + columnLength[iColumn];
-	    for (CoinBigIndex j = start; j < end; j++) {
-	      int iRow = row[j];
-	      rowActivity[iRow] += value * element[j];
-	      rowSum[iRow] += fabs(value * element[j]);
-	    }
-	  }
-	}
-	for (int i = 0 ; i < numberRows ; i++) {
-#if 0 //def CLP_INVESTIGATE
-	  double inf;
-	  inf = rowLower[i] - rowActivity[i];
-	  if (inf > primalTolerance)
-	    printf("Row %d inf %g sum %g %g <= %g <= %g\n",
-		   i, inf, rowSum[i], rowLower[i], rowActivity[i], rowUpper[i]);
-	  inf = rowActivity[i] - rowUpper[i];
-	  if (inf > primalTolerance)
-	    printf("Row %d inf %g sum %g %g <= %g <= %g\n",
-		   i, inf, rowSum[i], rowLower[i], rowActivity[i], rowUpper[i]);
-#endif
-	  double infeasibility = CoinMax(rowActivity[i]-rowUpper[i],
-					 rowLower[i]-rowActivity[i]);
-	  // but allow for errors
-	  double factor = CoinMax(1.0,rowSum[i]*1.0e-3);
-	  if (infeasibility>largestInfeasibility*factor) {
-	    largestInfeasibility = infeasibility/factor;
-	    printf("Dinf of %g on row %d sum %g scaled %g\n",
-		   infeasibility,i,rowSum[i],largestInfeasibility);
-	    if (infeasibility>1.0e10) {
-	      for (CoinBigIndex j=rowStart[i];
-		   j<rowStart[i]+rowLength[i];j++) {
-		printf("col %d element %g\n",
-		       column[j],elementByRow[j]);
-	      }
-	    }
-	  }
-	}
-	delete [] rowActivity ;
-	delete [] rowSum;
-	if (largestInfeasibility > 10.0*primalTolerance)
-	  printf("Dlargest infeasibility is %g - obj %g\n", largestInfeasibility,objValue);
-	else
-	  printf("Dfeasible (%g) - obj %g\n", largestInfeasibility,objValue);
-      }
-#endif
-#if JUST_FIX_INTEGER
-      const double * oldLower = model->solver()->getColLower();
-      const double * oldUpper = model->solver()->getColUpper();
-      const double * dj = lp->getReducedCost();
-      int nNaturalLB=0;
-      int nMaybeLB=0;
-      int nForcedLB=0;
-      int nNaturalUB=0;
-      int nMaybeUB=0;
-      int nForcedUB=0;
-      int nOther=0;
-      for ( int i=0 ; i<lp->getNumCols() ; ++i ) {
-	if (lp->isInteger(i)) {
-	  if (sol[i]==oldLower[i]) {
-	    if (dj[i]>1.0e-5)
-	      nNaturalLB++;
-	    else if (dj[i]<-1.0e-5)
-	      nForcedLB++;
-	    else
-	      nMaybeLB++;
-	  } else if (sol[i]==oldUpper[i]) {
-	    if (dj[i]<-1.0e-5)
-	      nNaturalUB++;
-	    else if (dj[i]>1.0e-5)
-	      nForcedUB++;
-	    else
-	      nMaybeUB++;
-	  } else {
-	    nOther++;
-	  }
-	}
       }
-      printf("%d other, LB %d natural, %d neutral, %d forced, UB %d natural, %d neutral, %d forced\n",
-	     nOther,nNaturalLB,nMaybeLB,nForcedLB,
-	     nNaturalUB,nMaybeUB,nForcedUB=0);
-#endif
    }
 
 TERMINATE:
-   delete lp;
+   for ( int i=0 ; i<numberCandidates ; ++i )
+   {
+      delete candidate[i].lp;
+      delete [] candidate[i].solution;
+   }
+   delete [] value;
+   delete [] integer;
    return status;
 }
-#undef STR_SIZE
@@ -4,22 +4,40 @@
 #include <vector>
 #include <string>
 #include <utility>
+#include <cstddef>
 class CbcModel;
 
 class OsiSolverInterface;
 
 /* tries to read mipstart (solution file) from
-   fileName, filling colValues and obj
+   fileName, filling colValues and obj (obj only
+   set for binary files).  Text files are read
+   in large blocks, binary files (as written by
+   writeBinaryMIPStart) are recognized by magic.
    returns 0 with success,
    1 otherwise */
 int readMIPStart( CbcModel * model, const char *fileName,
                   std::vector< std::pair< std::string, double > > &colValues,
                   double &solObj );
 
+/* writes binary mipstart - non zero values with
+   column names - returns 0 with success */
+int writeBinaryMIPStart( const char *fileName, const OsiSolverInterface *solver,
+                         const double *solution, double objectiveValue );
+
+/* writes binary mipstart from values and names (each
+   null terminated) - returns 0 with success */
+int writeBinaryMIPStart( const char *fileName, int numberValues,
+                         const double *values, const char *names,
+                         size_t lengthNames, double objectiveValue );
+
 /* from a partial list of variables tries to fill the
-   remaining variable values */
+   remaining variable values.  Bound propagation is
+   tried first and the LP is only solved (with presolve)
+   if columns are left free.  With threads alternative
+   ways of fixing are completed in parallel */
 int computeCompleteSolution( CbcModel * model, 
-                             const std::vector< std::string > colNames,
+                             const std::vector< std::string > &colNames,
                              const std::vector< std::pair< std::string, double > > &colValues,
                              double *sol, double &obj );
 
@@ -23,6 +23,7 @@ extern int gomory_try;
 #include <cassert>
 #include <cmath>
 #include <cfloat>
+#include <set>
 #ifdef COIN_HAS_CLP
 // include Presolve from Clp
 #include "ClpPresolve.hpp"
@@ -82,6 +83,12 @@ extern int gomory_try;
 #include "CbcTree.hpp"
 // This may be dummy
 #include "CbcThread.hpp"
+#include "CbcProgress.hpp"
+#include "CbcComponents.hpp"
+// Work (as simplex iterations) for a node, cut generator call and heuristic run
+#define CBC_WORK_NODE 10.0
+#define CBC_WORK_CUTS 20.0
+#define CBC_WORK_HEURISTIC 50.0
 /* Various functions local to CbcModel.cpp */
 
 static void * doRootCbcThread(void * voidInfo);
@@ -1622,14 +1629,57 @@ static double lengthConflictCuts=0.0;
 #include "OsiCpxSolverInterface.hpp"
 #include "cplex.h"
 #endif
+/*
+  Put best solution in continuousSolver_ and make that solver_.
+  We need to reset the cutoff value so as not to fathom the solution on
+  bounds.  Note that calling setBestSolution( ..., true) leaves the
+  continuousSolver_ bounds vectors fixed at the solution value.
+*/
+void
+CbcModel::installBestSolution()
+{
+    setCutoff(1.0e50) ; // As best solution should be worse than cutoff
+    // change cutoff as constraint if wanted
+    if (cutoffRowNumber_ >= 0) {
+        if (solver_->getNumRows() > cutoffRowNumber_)
+            solver_->setRowUpper(cutoffRowNumber_, 1.0e50);
+    }
+    // also in continuousSolver_
+    if (continuousSolver_) {
+        // Solvers know about direction
+        double direction = solver_->getObjSense();
+        continuousSolver_->setDblParam(OsiDualObjectiveLimit, 1.0e50*direction);
+    } else {
+        continuousSolver_ = solver_->clone();
+    }
+    phase_ = 5;
+    double increment = getDblParam(CbcModel::CbcCutoffIncrement) ;
+    if ((specialOptions_&4) == 0)
+        bestObjective_ += 100.0 * increment + 1.0e-3; // only set if we are going to solve
+    setBestSolution(CBC_END_SOLUTION, bestObjective_, bestSolution_, 1) ;
+    continuousSolver_->resolve() ;
+    if (!continuousSolver_->isProvenOptimal()) {
+        continuousSolver_->messageHandler()->setLogLevel(2) ;
+        continuousSolver_->initialSolve() ;
+    }
+    delete solver_ ;
+    // above deletes solverCharacteristics_
+    solverCharacteristics_ = NULL;
+    solver_ = continuousSolver_ ;
+    setPointers(solver_);
+    continuousSolver_ = NULL ;
+}
 void CbcModel::branchAndBound(int doStatistics)
 
 {
     if (!parentModel_) {
+      // keep problem as given for resolveIncremental
+      if (keepForResolve())
+	saveReferenceSolver();
       /*
 	Capture a time stamp before we start (unless set).
       */
-      if (!dblParam_[CbcStartSeconds]) {
+      if (!dblParam_[CbcStartSeconds] && !useWorkClock()) {
 	if (!useElapsedTime())
 	  dblParam_[CbcStartSeconds] = CoinCpuTime();
 	else
@@ -1643,6 +1693,11 @@ void CbcModel::branchAndBound(int doStatistics)
     double lastBestPossibleObjective=-COIN_DBL_MAX;
     // when to check for restart 
     int nextCheckRestart=50;
+    // when to check memory and when to estimate it
+    int nextCheckMemory = 0;
+    double nextMemoryEstimate = 0.0;
+    // tree size estimate printed every so many node log lines
+    int numberStatusLines = 0;
     // Force minimization !!!!
     bool flipObjective = (solver_->getObjSense()<0.0);
     if (flipObjective)
@@ -1656,7 +1711,16 @@ void CbcModel::branchAndBound(int doStatistics)
     strongInfo_[5] = 0;
     strongInfo_[6] = 0;
     numberStrongIterations_ = 0;
+    // work clock starts again (scaled by size of problem)
+    workScale_ = 1.0e-9 * (solver_->getNumRows() + solver_->getNumCols() +
+                           solver_->getNumElements());
+    workStart_ = countedWork();
+    extraWork_ = initialWork_;
     currentNode_ = NULL;
+    profile_.clear();
+    memoryState_ = 0;
+    memoryPeak_.clear();
+    treeEstimate_.clear();
     // See if should do cuts old way
     if (parallelMode() < 0) {
         specialOptions_ |= 4096 + 8192;
@@ -1965,6 +2029,11 @@ void CbcModel::branchAndBound(int doStatistics)
     // If dynamic pseudo costs then do
     if (numberBeforeTrust_)
         convertToDynamic();
+    // objects may be new so give back pseudocosts from last search
+    if (resolving() && !parentModel_) {
+        restoreResolvePseudoCosts();
+        moreSpecialOptions2_ &= ~2097152;
+    }
     // Set up char array to say if integer (speed)
     delete [] integerInfo_;
     {
@@ -2069,7 +2138,7 @@ void CbcModel::branchAndBound(int doStatistics)
     if (problemFeasibility_->feasible(this, 0) < 0) {
         feasible = false; // pretend infeasible
     }
-    numberSavedSolutions_ = 0;
+    solutionPool_.clear();
     int saveNumberStrong = numberStrong_;
     int saveNumberBeforeTrust = numberBeforeTrust_;
     /*
@@ -2095,35 +2164,7 @@ void CbcModel::branchAndBound(int doStatistics)
 	  messageHandler()->message(CBC_GENERAL,
 				    messages())
 	    << general << CoinMessageEol ;
-	  setCutoff(1.0e50) ; // As best solution should be worse than cutoff
-	  // change cutoff as constraint if wanted
-	  if (cutoffRowNumber_>=0) {
-	    if (solver_->getNumRows()>cutoffRowNumber_)
-	      solver_->setRowUpper(cutoffRowNumber_,1.0e50);
-	  }
-	  // also in continuousSolver_
-	  if (continuousSolver_) {
-	    // Solvers know about direction
-	    double direction = solver_->getObjSense();
-	    continuousSolver_->setDblParam(OsiDualObjectiveLimit, 1.0e50*direction);
-	  } else {
-	    continuousSolver_ = solver_->clone();
-	  }
-	  phase_ = 5;
-	  double increment = getDblParam(CbcModel::CbcCutoffIncrement) ;
-	  if ((specialOptions_&4) == 0)
-            bestObjective_ += 100.0 * increment + 1.0e-3; // only set if we are going to solve
-	  setBestSolution(CBC_END_SOLUTION, bestObjective_, bestSolution_, 1) ;
-	  continuousSolver_->resolve() ;
-	  if (!continuousSolver_->isProvenOptimal()) {
-            continuousSolver_->messageHandler()->setLogLevel(2) ;
-            continuousSolver_->initialSolve() ;
-	  }
-	  delete solver_ ;
-	  solverCharacteristics_=NULL;
-	  solver_ = continuousSolver_ ;
-	  setPointers(solver_);
-	  continuousSolver_ = NULL ;
+	  installBestSolution();
 	}
         solverCharacteristics_ = NULL;
 	if (flipObjective)
@@ -2183,6 +2224,52 @@ void CbcModel::branchAndBound(int doStatistics)
         CoinCopyN(solver_->getColSolution(), numberColumns, bestSolution_);
         return ;
     }
+    if ((moreSpecialOptions2_&65536) != 0 && !parentModel_ &&
+            (moreSpecialOptions_&1073741824) == 0 &&
+            !(strategy_ && strategy_->preProcessState() > 0) &&
+            CbcComponents::simpleObjectsOnly(*this)) {
+        // See if model splits into independent components
+        CbcComponents components;
+        if (components.findComponents(solver_) > 1) {
+            int numberColumns = solver_->getNumCols();
+            double * solution = new double [numberColumns];
+            double objectiveValue;
+            double bestPossible;
+            int secondaryStatus;
+            int returnCode = components.solve(*this, solution, objectiveValue,
+                                              bestPossible, secondaryStatus);
+            if (returnCode >= 0) {
+                char general[200];
+                sprintf(general, "Model split into %d independent components",
+                        components.numberComponents());
+                handler_->message(CBC_GENERAL, messages_)
+                << general << CoinMessageEol ;
+                status_ = (returnCode == 2) ? 1 : 0;
+                secondaryStatus_ = secondaryStatus;
+                if (returnCode == 1) {
+                    if (secondaryStatus == 1)
+                        handler_->message(CBC_INFEAS, messages_) << CoinMessageEol ;
+                    else
+                        handler_->message(CBC_UNBOUNDED, messages_) << CoinMessageEol ;
+                } else {
+                    bestPossibleObjective_ = bestPossible;
+                    if (objectiveValue < bestObjective_) {
+                        saveBestSolution(solution, objectiveValue);
+                        numberSolutions_++;
+                    }
+                }
+                delete [] solution;
+                if (bestSolution_ &&
+                        ((specialOptions_&8388608) == 0 || (specialOptions_&2048) != 0))
+                    installBestSolution();
+                solverCharacteristics_ = NULL;
+                if (flipObjective)
+                    flipModel();
+                return ;
+            }
+            delete [] solution;
+        }
+    }
     /*
       See if we're using the Osi side of the branching hierarchy. If so, either
       convert existing CbcObjects to OsiObjects, or generate them fresh. In the
@@ -2554,6 +2641,8 @@ void CbcModel::branchAndBound(int doStatistics)
     /*
       For printing totals and for CbcNode (numberNodes_)
     */
+    // keep work clock going forward
+    workStart_ -= numberIterations_ + CBC_WORK_NODE * numberNodes_;
     numberIterations_ = 0 ;
     numberNodes_ = 0 ;
     numberNodes2_ = 0 ;
@@ -4576,7 +4665,9 @@ void CbcModel::branchAndBound(int doStatistics)
               node comparison predicate wants to make any changes. If so,
               call setComparison for the side effect of rebuilding the heap.
             */
+            int numberBefore = tree_->size();
             tree_->cleanTree(this,newCutoff,bestPossibleObjective_) ;
+            treeEstimate_.addPruned(numberBefore - tree_->size());
             if (nodeCompare_->newSolution(this) ||
                 nodeCompare_->newSolution(this,continuousObjective_,
                                           continuousInfeasibilities_)) {
@@ -4642,6 +4733,14 @@ void CbcModel::branchAndBound(int doStatistics)
 	      }
 	    }
 #endif
+            if (!parentModel_ && CoinGetTimeOfDay() >= nextMemoryEstimate) {
+                // estimate memory - spending at most 1% of time doing so
+                double time = CoinGetTimeOfDay();
+                updateMemoryPeak();
+                double now = CoinGetTimeOfDay();
+                nextMemoryEstimate = now + 100.0 * (now - time);
+            }
+            updateTreeEstimate();
             unlockThread();
 #if CBC_USEFUL_PRINTING>1
             if (getCutoff() < 1.0e20) {
@@ -4697,10 +4796,48 @@ void CbcModel::branchAndBound(int doStatistics)
 	      lastNumberConflictCuts = numberConflictCuts;
 	    }
 #endif
+            if (!parentModel_ && (numberStatusLines++ % 10) == 0 &&
+                    treeEstimate_.remainingNodes() >= 0.0) {
+                messageHandler()->message(CBC_ESTIMATE, messages())
+                << treeEstimate_.remainingNodes()
+                << treeEstimate_.remainingSeconds()
+                << treeEstimate_.totalNodes()
+                << treeEstimate_.backtrackNodes()
+                << treeEstimate_.leafFrequencyNodes()
+                << treeEstimate_.gapClosureNodes()
+                << CoinMessageEol ;
+            }
             if (eventHandler && !eventHandler->event(CbcEventHandler::treeStatus)) {
                 eventHappened_ = true; // exit
             }
         }
+        if (dblParam_[CbcMaximumMemory] > 0.0 && !parentModel_ &&
+                numberNodes_ >= nextCheckMemory) {
+            // may have to degrade search (or stop)
+            nextCheckMemory = numberNodes_ + 100;
+            checkMemoryLimit();
+        }
+        if (progress_ && progress_->update(bestObjective_)) {
+            // progress row - bound as for node log
+            lockThread();
+            int nNodes = tree_->size() ;
+            double bestPossible = tree_->getBestPossibleObjective();
+#ifdef CBC_THREAD
+	    if (parallelMode() > 0 && master_) {
+	      // need to adjust for ones not on tree
+	      int numberThreads = master_->numberThreads();
+	      for (int i=0;i<numberThreads;i++) {
+		CbcThread * child = master_->child(i);
+		if (child->node()) {
+		  double value = child->node()->objectiveValue();
+		  bestPossible = CoinMin(bestPossible, value);
+		}
+	      }
+	    }
+#endif
+            unlockThread();
+            progress_->sample(this, bestObjective_, bestPossible, nNodes);
+        }
         // See if can stop on gap
 	if(canStopOnGap()) {
             stoppedOnGap_ = true ;
@@ -4722,7 +4859,10 @@ void CbcModel::branchAndBound(int doStatistics)
 #ifdef CBC_THREAD
         if (!parallelMode() || parallelMode() == -1) {
 #endif
-            node = tree_->bestNode(cutoff) ;
+            {
+                CbcProfileTimer timer(profile_, CbcProfile::nodeSelection);
+                node = tree_->bestNode(cutoff) ;
+            }
             // Possible one on tree worse than cutoff
             // Weird comparison function can leave ineligible nodes on tree
             if (!node || node->objectiveValue() > cutoff)
@@ -4773,7 +4913,10 @@ void CbcModel::branchAndBound(int doStatistics)
             // Deterministic parallel
 	  if ((tree_->size() < CoinMax(numberThreads_, 8)||
 	       hotstartSolution_) && !goneParallel) {
-                node = tree_->bestNode(cutoff) ;
+                {
+                    CbcProfileTimer timer(profile_, CbcProfile::nodeSelection);
+                    node = tree_->bestNode(cutoff) ;
+                }
                 // Possible one on tree worse than cutoff
                 if (!node || node->objectiveValue() > cutoff)
                     continue;
@@ -4896,6 +5039,10 @@ void CbcModel::branchAndBound(int doStatistics)
             handler_->message(CBC_MAXITERS, messages_) << CoinMessageEol ;
             secondaryStatus_ = 8;
             status_ = 1 ;
+        } else if (memoryState_ >= 4) {
+            handler_->message(CBC_MAXMEMORY, messages_) << CoinMessageEol ;
+            secondaryStatus_ = 9;
+            status_ = 1 ;
         } else {
             handler_->message(CBC_EVENT, messages_) << CoinMessageEol ;
             secondaryStatus_ = 5;
@@ -4974,6 +5121,28 @@ void CbcModel::branchAndBound(int doStatistics)
         << maximumDepthActual_
         << numberDJFixed_ << numberFathoms_ << numberExtraNodes_ << numberExtraIterations_
         << CoinMessageEol ;
+    if (progress_)
+        progress_->sample(this, bestObjective_, bestPossibleObjective_, tree_->size());
+    if (!parentModel_ && profile_.totalSeconds() > 0.0) {
+        // Where time went
+        char general[200];
+        for (int i = 0; i < CbcProfile::numberPhases; i++) {
+            if (!profile_.count(i))
+                continue;
+            sprintf(general, "Profile %s - %.3f seconds, %d times",
+                    CbcProfile::name(i), profile_.seconds(i), profile_.count(i));
+            messageHandler()->message(CBC_GENERAL,
+                                      messages())
+            << general << CoinMessageEol ;
+        }
+    }
+    if (!parentModel_) {
+        updateMemoryPeak();
+        printMemoryUsage();
+    }
+    if (eventHandler) {
+        eventHandler->event(CbcEventHandler::profileSummary);
+    }
 #ifdef COIN_HAS_NTY
     if (symmetryInfo_) 
       symmetryInfo_->statsOrbits(this,1);
@@ -5169,34 +5338,7 @@ void CbcModel::branchAndBound(int doStatistics)
     */
     if (bestSolution_ && (solverCharacteristics_->solverType() < 2 || solverCharacteristics_->solverType() == 4) && 
 	((specialOptions_&8388608)==0||(specialOptions_&2048)!=0)) {
-        setCutoff(1.0e50) ; // As best solution should be worse than cutoff
-	// change cutoff as constraint if wanted
-	if (cutoffRowNumber_>=0) {
-	  if (solver_->getNumRows()>cutoffRowNumber_)
-	    solver_->setRowUpper(cutoffRowNumber_,1.0e50);
-	}
-	// also in continuousSolver_
-	if (continuousSolver_) {
-	  // Solvers know about direction
-	  double direction = solver_->getObjSense();
-	  continuousSolver_->setDblParam(OsiDualObjectiveLimit, 1.0e50*direction);
-	}
-        phase_ = 5;
-        double increment = getDblParam(CbcModel::CbcCutoffIncrement) ;
-        if ((specialOptions_&4) == 0)
-            bestObjective_ += 100.0 * increment + 1.0e-3; // only set if we are going to solve
-        setBestSolution(CBC_END_SOLUTION, bestObjective_, bestSolution_, 1) ;
-        continuousSolver_->resolve() ;
-        if (!continuousSolver_->isProvenOptimal()) {
-            continuousSolver_->messageHandler()->setLogLevel(2) ;
-            continuousSolver_->initialSolve() ;
-        }
-        delete solver_ ;
-        // above deletes solverCharacteristics_
-        solverCharacteristics_ = NULL;
-        solver_ = continuousSolver_ ;
-        setPointers(solver_);
-        continuousSolver_ = NULL ;
+        installBestSolution();
     }
     /*
       Clean up dangling objects. continuousSolver_ may already be toast.
@@ -5231,9 +5373,16 @@ void CbcModel::branchAndBound(int doStatistics)
         continuousSolver_ = NULL ;
     }
     /*
-      Destroy global cuts by replacing with an empty OsiCuts object.
+      Destroy global cuts by replacing with an empty OsiCuts object
+      (unless kept for resolveIncremental).
     */
-    globalCuts_ = CbcRowCuts() ;
+    if (!keepForResolve() || parentModel_) {
+        globalCuts_ = CbcRowCuts() ;
+    } else {
+        moreSpecialOptions2_ |= 262144;
+        // keep pseudocosts for next search
+        setResolveObjects(object_, numberObjects_);
+    }
     delete globalConflictCuts_;
     globalConflictCuts_=NULL;
     if (!bestSolution_ && (specialOptions_&8388608)==0) {
@@ -5421,6 +5570,8 @@ CbcModel::CbcModel()
         ownership_(0x80000000),
         continuousSolver_(NULL),
         referenceSolver_(NULL),
+        resolveObjects_(NULL),
+        numberResolveObjects_(0),
         defaultHandler_(true),
         emptyWarmStart_(NULL),
         bestObjective_(COIN_DBL_MAX),
@@ -5428,14 +5579,11 @@ CbcModel::CbcModel()
         sumChangeObjective1_(0.0),
         sumChangeObjective2_(0.0),
         bestSolution_(NULL),
-        savedSolutions_(NULL),
         currentSolution_(NULL),
         testSolution_(NULL),
 	globalConflictCuts_(NULL),
         minimumDrop_(1.0e-4),
         numberSolutions_(0),
-        numberSavedSolutions_(0),
-        maximumSavedSolutions_(0),
         stateOfSearch_(0),
         whenCuts_(-1),
         hotstartSolution_(NULL),
@@ -5545,7 +5693,13 @@ CbcModel::CbcModel()
         threadMode_(0),
 	numberGlobalCutsIn_(0),
         master_(NULL),
-        masterThread_(NULL)
+        masterThread_(NULL),
+        progress_(NULL),
+        memoryState_(0),
+        workScale_(0.0),
+        workStart_(0.0),
+        initialWork_(0.0),
+        extraWork_(0.0)
 {
     memset(intParam_, 0, sizeof(intParam_));
     intParam_[CbcMaxNumNode] = 2147483647;
@@ -5599,6 +5753,8 @@ CbcModel::CbcModel(const OsiSolverInterface &rhs)
         :
         continuousSolver_(NULL),
         referenceSolver_(NULL),
+        resolveObjects_(NULL),
+        numberResolveObjects_(0),
         defaultHandler_(true),
         emptyWarmStart_(NULL),
         bestObjective_(COIN_DBL_MAX),
@@ -5608,8 +5764,6 @@ CbcModel::CbcModel(const OsiSolverInterface &rhs)
 	globalConflictCuts_(NULL),
         minimumDrop_(1.0e-4),
         numberSolutions_(0),
-        numberSavedSolutions_(0),
-        maximumSavedSolutions_(0),
         stateOfSearch_(0),
         whenCuts_(-1),
         hotstartSolution_(NULL),
@@ -5715,7 +5869,13 @@ CbcModel::CbcModel(const OsiSolverInterface &rhs)
         threadMode_(0),
 	numberGlobalCutsIn_(0),
         master_(NULL),
-        masterThread_(NULL)
+        masterThread_(NULL),
+        progress_(NULL),
+        memoryState_(0),
+        workScale_(0.0),
+        workStart_(0.0),
+        initialWork_(0.0),
+        extraWork_(0.0)
 {
     memset(intParam_, 0, sizeof(intParam_));
     intParam_[CbcMaxNumNode] = 2147483647;
@@ -5767,7 +5927,6 @@ CbcModel::CbcModel(const OsiSolverInterface &rhs)
 
     // Initialize solution and integer variable vectors
     bestSolution_ = NULL; // to say no solution found
-    savedSolutions_ = NULL;
     numberIntegers_ = 0;
     int numberColumns = solver_->getNumCols();
     int iColumn;
@@ -5856,10 +6015,8 @@ CbcModel::assignSolver(OsiSolverInterface *&solver, bool deleteSolver)
 	  hotstartSolution_ = resizeDouble(hotstartSolution_,nOld,nNew);
 	  bestSolution_ = resizeDouble(bestSolution_,nOld,nNew);
 	  currentSolution_ = resizeDouble(currentSolution_,nOld,nNew);
-	  if (savedSolutions_) {
-	    for (int i = 0; i < maximumSavedSolutions_; i++)
-	      savedSolutions_[i] = resizeDouble(savedSolutions_[i],nOld,nNew);
-	  }
+	  if (solutionPool_.numberSolutions())
+	    solutionPool_.resize(nNew);
         }
     }
     // Keep the current message level for solver (if solver exists)
@@ -5919,17 +6076,18 @@ CbcModel::CbcModel(const CbcModel & rhs, bool cloneHandler)
         :
         continuousSolver_(NULL),
         referenceSolver_(NULL),
+        resolveObjects_(NULL),
+        numberResolveObjects_(0),
         defaultHandler_(rhs.defaultHandler_),
         emptyWarmStart_(NULL),
         bestObjective_(rhs.bestObjective_),
         bestPossibleObjective_(rhs.bestPossibleObjective_),
         sumChangeObjective1_(rhs.sumChangeObjective1_),
         sumChangeObjective2_(rhs.sumChangeObjective2_),
+        solutionPool_(rhs.solutionPool_),
 	globalConflictCuts_(NULL),
         minimumDrop_(rhs.minimumDrop_),
         numberSolutions_(rhs.numberSolutions_),
-        numberSavedSolutions_(rhs.numberSavedSolutions_),
-        maximumSavedSolutions_(rhs.maximumSavedSolutions_),
         stateOfSearch_(rhs.stateOfSearch_),
         whenCuts_(rhs.whenCuts_),
         numberHeuristicSolutions_(rhs.numberHeuristicSolutions_),
@@ -6002,7 +6160,13 @@ CbcModel::CbcModel(const CbcModel & rhs, bool cloneHandler)
         threadMode_(rhs.threadMode_),
 	numberGlobalCutsIn_(rhs.numberGlobalCutsIn_),
         master_(NULL),
-        masterThread_(NULL)
+        masterThread_(NULL),
+        progress_(NULL),
+        memoryState_(0),
+        workScale_(rhs.workScale_),
+        workStart_(rhs.workStart_),
+        initialWork_(rhs.initialWork_),
+        extraWork_(rhs.extraWork_)
 {
     memcpy(intParam_, rhs.intParam_, sizeof(intParam_));
     memcpy(dblParam_, rhs.dblParam_, sizeof(dblParam_));
@@ -6013,6 +6177,8 @@ CbcModel::CbcModel(const CbcModel & rhs, bool cloneHandler)
     strongInfo_[4] = rhs.strongInfo_[4];
     strongInfo_[5] = rhs.strongInfo_[5];
     strongInfo_[6] = rhs.strongInfo_[6];
+    // times are not copied but spans go to same trace
+    profile_.setTrace(rhs.profile_.trace(), rhs.profile_.traceThread());
     solverCharacteristics_ = NULL;
     if (rhs.emptyWarmStart_) emptyWarmStart_ = rhs.emptyWarmStart_->clone() ;
     if (defaultHandler_ || cloneHandler) {
@@ -6082,6 +6248,7 @@ CbcModel::CbcModel(const CbcModel & rhs, bool cloneHandler)
         referenceSolver_ = rhs.referenceSolver_->clone();
     else
         referenceSolver_ = NULL;
+    setResolveObjects(rhs.resolveObjects_, rhs.numberResolveObjects_);
     solver_ = rhs.solver_->clone();
     if (rhs.originalColumns_) {
         int numberColumns = solver_->getNumCols();
@@ -6151,13 +6318,6 @@ CbcModel::CbcModel(const CbcModel & rhs, bool cloneHandler)
         bestSolution_ = NULL;
     }
     int numberColumns = solver_->getNumCols();
-    if (maximumSavedSolutions_ && rhs.savedSolutions_) {
-        savedSolutions_ = new double * [maximumSavedSolutions_];
-        for (int i = 0; i < maximumSavedSolutions_; i++)
-            savedSolutions_[i] = CoinCopyOfArray(rhs.savedSolutions_[i], numberColumns + 2);
-    } else {
-        savedSolutions_ = NULL;
-    }
     // Space for current solution
     if (numberColumns) {
       currentSolution_ = new double[numberColumns];
@@ -6256,6 +6416,7 @@ CbcModel::operator=(const CbcModel & rhs)
         } else {
             referenceSolver_ = NULL ;
         }
+        setResolveObjects(rhs.resolveObjects_, rhs.numberResolveObjects_);
 
         delete emptyWarmStart_ ;
         if (rhs.emptyWarmStart_) {
@@ -6276,10 +6437,7 @@ CbcModel::operator=(const CbcModel & rhs)
         } else {
             bestSolution_ = NULL;
         }
-        for (int i = 0; i < maximumSavedSolutions_; i++)
-            delete [] savedSolutions_[i];
-        delete [] savedSolutions_;
-        savedSolutions_ = NULL;
+        solutionPool_ = rhs.solutionPool_;
         int numberColumns = rhs.getNumCols();
         if (numberColumns) {
             // Space for current solution
@@ -6292,18 +6450,9 @@ CbcModel::operator=(const CbcModel & rhs)
             continuousSolution_ = NULL;
             usedInSolution_ = NULL;
         }
-        if (maximumSavedSolutions_) {
-            savedSolutions_ = new double * [maximumSavedSolutions_];
-            for (int i = 0; i < maximumSavedSolutions_; i++)
-                savedSolutions_[i] = CoinCopyOfArray(rhs.savedSolutions_[i], numberColumns + 2);
-        } else {
-            savedSolutions_ = NULL;
-        }
         testSolution_ = currentSolution_;
         minimumDrop_ = rhs.minimumDrop_;
         numberSolutions_ = rhs.numberSolutions_;
-        numberSavedSolutions_ = rhs.numberSavedSolutions_;
-        maximumSavedSolutions_ = rhs.maximumSavedSolutions_;
         stateOfSearch_ = rhs.stateOfSearch_;
         whenCuts_ = rhs.whenCuts_;
         numberHeuristicSolutions_ = rhs.numberHeuristicSolutions_;
@@ -6400,6 +6549,12 @@ CbcModel::operator=(const CbcModel & rhs)
         delete master_;
         master_ = NULL;
         masterThread_ = NULL;
+        progress_ = NULL;
+        memoryState_ = 0;
+        workScale_ = rhs.workScale_;
+        workStart_ = rhs.workStart_;
+        initialWork_ = rhs.initialWork_;
+        extraWork_ = rhs.extraWork_;
         searchStrategy_ = rhs.searchStrategy_;
 	strongStrategy_ = rhs.strongStrategy_;
         numberStrongIterations_ = rhs.numberStrongIterations_;
@@ -6587,6 +6742,7 @@ CbcModel::gutsOfDestructor()
 {
     delete referenceSolver_;
     referenceSolver_ = NULL;
+    setResolveObjects(NULL, 0);
     int i;
     for (i = 0; i < numberCutGenerators_; i++) {
         delete generator_[i];
@@ -6652,15 +6808,9 @@ CbcModel::resetModel()
     emptyWarmStart_ = NULL;
     delete continuousSolver_;
     continuousSolver_ = NULL;
-    numberSavedSolutions_ = 0;
     delete [] bestSolution_;
     bestSolution_ = NULL;
-    if (savedSolutions_) {
-        for (int i = 0; i < maximumSavedSolutions_; i++)
-            delete [] savedSolutions_[i];
-        delete [] savedSolutions_;
-        savedSolutions_ = NULL;
-    }
+    solutionPool_.clear();
     delete [] currentSolution_;
     currentSolution_ = NULL;
     delete [] continuousSolution_;
@@ -6735,6 +6885,9 @@ CbcModel::resetModel()
     numberSolves_ = 0;
     status_ = -1;
     secondaryStatus_ = -1;
+    workScale_ = 0.0;
+    workStart_ = 0.0;
+    extraWork_ = 0.0;
     maximumNumberCuts_ = 0;
     phase_ = 0;
     currentNumberCuts_ = 0;
@@ -6799,14 +6952,7 @@ CbcModel::gutsOfCopy(const CbcModel & rhs, int mode)
     preferredWay_ = rhs.preferredWay_;
     resolveAfterTakeOffCuts_ = rhs.resolveAfterTakeOffCuts_;
     maximumNumberIterations_ = rhs.maximumNumberIterations_;
-    numberSavedSolutions_ = rhs.numberSavedSolutions_;
-    maximumSavedSolutions_ = rhs.maximumSavedSolutions_;
-    if (maximumSavedSolutions_) {
-        int n = solver_->getNumCols();
-        savedSolutions_ = new double * [maximumSavedSolutions_];
-        for (int i = 0; i < maximumSavedSolutions_; i++)
-            savedSolutions_[i] = CoinCopyOfArray(rhs.savedSolutions_[i], n + 2);
-    }
+    solutionPool_ = rhs.solutionPool_;
     continuousPriority_ = rhs.continuousPriority_;
     numberThreads_ = rhs.numberThreads_;
     threadMode_ = rhs.threadMode_;
@@ -6914,6 +7060,25 @@ CbcModel::moveInfo(const CbcModel & rhs)
     numberRowsAtContinuous_ = rhs.numberRowsAtContinuous_;
     cutoffRowNumber_ = rhs.cutoffRowNumber_;
     maximumDepth_ = rhs.maximumDepth_;
+    profile_.clear();
+    profile_.add(rhs.profile_);
+    memoryPeak_ = rhs.memoryPeak_;
+    treeEstimate_ = rhs.treeEstimate_;
+    if ((rhs.moreSpecialOptions2_&262144) != 0 && rhs.referenceSolver_ &&
+            rhs.referenceSolver_->getNumCols() == solver_->getNumCols()) {
+        // keep what is needed for resolveIncremental
+        delete referenceSolver_;
+        referenceSolver_ = rhs.referenceSolver_->clone();
+        globalCuts_ = rhs.globalCuts_;
+        setResolveObjects(rhs.resolveObjects_, rhs.numberResolveObjects_);
+        delete [] bestSolution_;
+        bestSolution_ = NULL;
+        // solution may still be in terms of preprocessed model
+        if (rhs.bestSolution_ &&
+                rhs.solver_->getNumCols() == solver_->getNumCols())
+            bestSolution_ = CoinCopyOfArray(rhs.bestSolution_, solver_->getNumCols());
+        moreSpecialOptions2_ |= 262144;
+    }
 }
 // Save a copy of the current solver so can be reset to
 void
@@ -6938,6 +7103,234 @@ CbcModel::resetToReferenceSolver()
     solver_->getDblParam(OsiDualObjectiveLimit, value);
     setCutoff(value*direction);
 }
+// Set whether to keep information for resolveIncremental
+void
+CbcModel::setKeepForResolve(bool yesNo)
+{
+    if (yesNo) {
+        moreSpecialOptions2_ |= 131072;
+    } else {
+        moreSpecialOptions2_ &= ~(131072 | 262144 | 2097152);
+        globalCuts_ = CbcRowCuts() ;
+        setResolveObjects(NULL, 0);
+    }
+}
+// Change bounds of a column
+void
+CbcModel::resolveSetColumnBounds(int iColumn, double lower, double upper)
+{
+    // before any search just change problem
+    OsiSolverInterface * solver = ((moreSpecialOptions2_&262144) != 0) ?
+                                  referenceSolver_ : solver_;
+    const double * columnLower = solver->getColLower();
+    const double * columnUpper = solver->getColUpper();
+    // if region gets bigger cuts may not be valid
+    if (lower < columnLower[iColumn] || upper > columnUpper[iColumn])
+        globalCuts_ = CbcRowCuts() ;
+    solver->setColLower(iColumn, lower);
+    solver->setColUpper(iColumn, upper);
+}
+// Change an objective coefficient
+void
+CbcModel::resolveSetObjective(int iColumn, double value)
+{
+    OsiSolverInterface * solver = ((moreSpecialOptions2_&262144) != 0) ?
+                                  referenceSolver_ : solver_;
+    // cuts from probing may have used objective
+    if (solver->getObjCoefficients()[iColumn] != value)
+        globalCuts_ = CbcRowCuts() ;
+    solver->setObjCoeff(iColumn, value);
+}
+// Change bounds (rhs) of a row
+void
+CbcModel::resolveSetRowBounds(int iRow, double lower, double upper)
+{
+    OsiSolverInterface * solver = ((moreSpecialOptions2_&262144) != 0) ?
+                                  referenceSolver_ : solver_;
+    const double * rowLower = solver->getRowLower();
+    const double * rowUpper = solver->getRowUpper();
+    if (lower < rowLower[iRow] || upper > rowUpper[iRow])
+        globalCuts_ = CbcRowCuts() ;
+    solver->setRowLower(iRow, lower);
+    solver->setRowUpper(iRow, upper);
+}
+// Append rows
+void
+CbcModel::resolveAddRows(int numberRows, const CoinBigIndex * rowStarts,
+                         const int * columns, const double * elements,
+                         const double * rowLower, const double * rowUpper)
+{
+    OsiSolverInterface * solver = ((moreSpecialOptions2_&262144) != 0) ?
+                                  referenceSolver_ : solver_;
+    // cuts stay valid as region can only get smaller
+    solver->addRows(numberRows, rowStarts, columns, elements,
+                    rowLower, rowUpper);
+}
+/* Solve again after changes.
+   Pseudocosts are given back to objects by branchAndBound, the incumbent
+   is checked against changed problem and global cuts have already been
+   thrown away by the resolve methods if region got bigger.
+*/
+void
+CbcModel::resolveIncremental(int doStatistics)
+{
+    restoreForResolve();
+    initialSolve();
+    branchAndBound(doStatistics);
+}
+// Put changed problem back in solver and check incumbent
+bool
+CbcModel::restoreForResolve()
+{
+    if ((moreSpecialOptions2_&262144) == 0 || !referenceSolver_)
+        return false; // nothing kept
+    moreSpecialOptions2_ &= ~262144;
+    // branchAndBound gives pseudocosts back once objects are created
+    moreSpecialOptions2_ |= 2097152;
+    OsiSolverInterface * solver = referenceSolver_->clone();
+    assignSolver(solver, true);
+    for (int i = 0; i < numberObjects_; i++)
+        object_[i]->resetBounds(solver_);
+    // Reset cutoff
+    double cutoff;
+    solver_->getDblParam(OsiDualObjectiveLimit, cutoff);
+    setCutoff(cutoff*solver_->getObjSense());
+    int numberColumns = solver_->getNumCols();
+    if (bestSolution_) {
+        // See if incumbent still feasible
+        int numberRows = solver_->getNumRows();
+        const double * columnLower = solver_->getColLower();
+        const double * columnUpper = solver_->getColUpper();
+        const double * rowLower = solver_->getRowLower();
+        const double * rowUpper = solver_->getRowUpper();
+        const double * objective = solver_->getObjCoefficients();
+        double primalTolerance;
+        solver_->getDblParam(OsiPrimalTolerance, primalTolerance);
+        double integerTolerance = getIntegerTolerance();
+        double offset;
+        solver_->getDblParam(OsiObjOffset, offset);
+        double objValue = -offset;
+        bool feasible = true;
+        for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+            double value = bestSolution_[iColumn];
+            if (value < columnLower[iColumn] - primalTolerance ||
+                    value > columnUpper[iColumn] + primalTolerance)
+                feasible = false;
+            if (solver_->isInteger(iColumn) &&
+                    fabs(value - floor(value + 0.5)) > integerTolerance)
+                feasible = false;
+            objValue += value * objective[iColumn];
+        }
+        double * rowActivity = new double [numberRows];
+        CoinZeroN(rowActivity, numberRows);
+        solver_->getMatrixByCol()->times(bestSolution_, rowActivity);
+        for (int iRow = 0; iRow < numberRows; iRow++) {
+            double value = rowActivity[iRow];
+            if (value < rowLower[iRow] - primalTolerance ||
+                    value > rowUpper[iRow] + primalTolerance)
+                feasible = false;
+        }
+        delete [] rowActivity;
+        char printBuffer[200];
+        if (feasible) {
+            double * solution = CoinCopyOfArray(bestSolution_, numberColumns);
+            objValue *= solver_->getObjSense();
+            // so not saved as extra solution
+            deleteSolutions();
+            bestObjective_ = COIN_DBL_MAX;
+            setBestSolution(solution, numberColumns, objValue, false);
+            delete [] solution;
+            sprintf(printBuffer, "Previous solution still feasible - objective value %g",
+                    objValue);
+        } else {
+            deleteSolutions();
+            bestObjective_ = COIN_DBL_MAX;
+            numberSolutions_ = 0;
+            numberHeuristicSolutions_ = 0;
+            // cuts may have depended on cutoff
+            globalCuts_ = CbcRowCuts() ;
+            sprintf(printBuffer, "Previous solution no longer feasible");
+        }
+        messageHandler()->message(CBC_GENERAL, messages())
+        << printBuffer << CoinMessageEol ;
+    }
+    return true;
+}
+
+// Search was on preprocessed model - keep original for resolve
+void
+CbcModel::setResolveOriginal(OsiSolverInterface * solver)
+{
+    if (!keepForResolve() || parentModel_) {
+        delete solver;
+        return;
+    }
+    delete referenceSolver_;
+    referenceSolver_ = solver;
+    globalCuts_ = CbcRowCuts() ;
+    setResolveObjects(NULL, 0);
+    moreSpecialOptions2_ |= 262144;
+}
+// Keep copies of dynamic pseudocost objects for resolve
+void
+CbcModel::setResolveObjects(OsiObject ** objects, int numberObjects)
+{
+    if (objects == resolveObjects_)
+        return;
+    for (int i = 0; i < numberResolveObjects_; i++)
+        delete resolveObjects_[i];
+    delete [] resolveObjects_;
+    resolveObjects_ = NULL;
+    numberResolveObjects_ = 0;
+    int n = 0;
+    for (int i = 0; i < numberObjects; i++) {
+        if (dynamic_cast <CbcSimpleIntegerDynamicPseudoCost *>(objects[i]))
+            n++;
+    }
+    if (!n)
+        return;
+    resolveObjects_ = new OsiObject * [n];
+    for (int i = 0; i < numberObjects; i++) {
+        if (dynamic_cast <CbcSimpleIntegerDynamicPseudoCost *>(objects[i]))
+            resolveObjects_[numberResolveObjects_++] = objects[i]->clone();
+    }
+}
+// Copy pseudocosts kept by last search into objects
+void
+CbcModel::restoreResolvePseudoCosts()
+{
+    if (!numberResolveObjects_)
+        return;
+    int numberColumns = solver_->getNumCols();
+    int * which = new int [numberColumns];
+    for (int i = 0; i < numberColumns; i++)
+        which[i] = -1;
+    for (int i = 0; i < numberResolveObjects_; i++) {
+        CbcSimpleIntegerDynamicPseudoCost * obj =
+            dynamic_cast <CbcSimpleIntegerDynamicPseudoCost *>(resolveObjects_[i]) ;
+        int iColumn = obj->columnNumber();
+        if (iColumn < numberColumns)
+            which[iColumn] = i;
+    }
+    int numberKept = 0;
+    for (int iObject = 0; iObject < numberObjects_; iObject++) {
+        CbcSimpleIntegerDynamicPseudoCost * obj =
+            dynamic_cast <CbcSimpleIntegerDynamicPseudoCost *>(object_[iObject]) ;
+        if (!obj)
+            continue;
+        int k = which[obj->columnNumber()];
+        if (k >= 0) {
+            obj->copySome(dynamic_cast <CbcSimpleIntegerDynamicPseudoCost *>(resolveObjects_[k]));
+            numberKept++;
+        }
+    }
+    delete [] which;
+    char printBuffer[200];
+    sprintf(printBuffer, "Pseudocosts of %d integers kept from last search",
+            numberKept);
+    messageHandler()->message(CBC_GENERAL, messages())
+    << printBuffer << CoinMessageEol ;
+}
 
 // Are there a numerical difficulties?
 bool
@@ -7282,6 +7675,7 @@ bool CbcModel::addCuts1 (CbcNode * node, CoinWarmStartBasis *&lastws)
 */
 int CbcModel::addCuts (CbcNode *node, CoinWarmStartBasis *&lastws)
 {
+    CbcProfileTimer timer(profile_, CbcProfile::treeBookkeeping);
     /*
       addCuts1 performs step 1 of restoring the subproblem at this node; see the
       comments there.
@@ -7552,6 +7946,7 @@ CbcModel::synchronizeHandlers(int /*makeDefault*/)
 int CbcModel::reducedCostFix ()
 
 {
+    CbcProfileTimer timer(profile_, CbcProfile::propagation);
     if (!solverCharacteristics_->reducedCostsAccurate())
         return 0; //NLP
     double cutoff = getCutoff() ;
@@ -8414,9 +8809,12 @@ CbcModel::solveWithCuts (OsiCuts &cuts, int numberTries, CbcNode *node)
                     continue;
                 // see if heuristic will do anything
                 double saveValue = heuristicValue ;
-                int ifSol =
-                    heuristic_[i]->solution(heuristicValue,
-                                            newSolution);
+                int ifSol;
+                {
+                    CbcProfileTimer timer(profile_, CbcProfile::heuristics);
+                    ifSol = heuristic_[i]->solution(heuristicValue,
+                                                    newSolution);
+                }
                 //theseCuts) ;
                 if (ifSol > 0) {
                     // better solution found
@@ -8839,9 +9237,9 @@ CbcModel::solveWithCuts (OsiCuts &cuts, int numberTries, CbcNode *node)
       End cut generation loop.
     */
     {
-        // switch on
+        // switch on (unless off to save memory)
         for (int i = 0; i < numberCutGenerators_; i++)
-            generator_[i]->setSwitchedOff(false);
+            generator_[i]->setSwitchedOff(memoryState_ >= 1);
     }
     //check feasibility.
     //If solution seems to be integer feasible calling setBestSolution
@@ -8958,8 +9356,12 @@ CbcModel::solveWithCuts (OsiCuts &cuts, int numberTries, CbcNode *node)
                     continue;
                 // see if heuristic will do anything
                 double saveValue = heuristicValue ;
-                int ifSol = heuristic_[i]->solution(heuristicValue,
+                int ifSol;
+                {
+                    CbcProfileTimer timer(profile_, CbcProfile::heuristics);
+                    ifSol = heuristic_[i]->solution(heuristicValue,
                                                     newSolution);
+                }
                 if (ifSol > 0) {
                     // better solution found
                     heuristic_[i]->incrementNumberSolutionsFound();
@@ -9694,6 +10096,7 @@ CbcModel::solveWithCuts (OsiCuts &cuts, int numberTries, CbcNode *node)
 int
 CbcModel::serialCuts(OsiCuts & theseCuts, CbcNode * node, OsiCuts & slackCuts, int lastNumberCuts)
 {
+    CbcProfileTimer timer(profile_, CbcProfile::cutSeparation);
     /*
       Is it time to scan the cuts in order to remove redundant cuts? If so, set
       up to do it.
@@ -14317,6 +14720,7 @@ void CbcModel::passInEventHandler (const CbcEventHandler *eventHandler)
 int
 CbcModel::resolve(OsiSolverInterface * solver)
 {
+    CbcProfileTimer timer(profile_, CbcProfile::nodeLp);
     numberSolves_++;
 #ifdef COIN_HAS_CLP
     OsiClpSolverInterface * clpSolver
@@ -14794,7 +15198,9 @@ CbcModel::setObjectiveValue(CbcNode * thisNode, const CbcNode * parentNode) cons
 double
 CbcModel::getCurrentSeconds() const
 {
-    if (!useElapsedTime())
+    if (useWorkClock())
+      return workUnits();
+    else if (!useElapsedTime())
       return CoinCpuTime() - getDblParam(CbcStartSeconds);
     else
       return CoinGetTimeOfDay() - getDblParam(CbcStartSeconds);
@@ -14825,6 +15231,7 @@ CbcModel::chooseBranch(CbcNode * &newNode, int numberPassesLeft,
                        const double * lowerBefore, const double * upperBefore,
                        OsiSolverBranch * & branches)
 {
+    CbcProfileTimer timer(profile_, CbcProfile::strongBranching);
     // Set state of search
     /*
       0 - outside CbcNode
@@ -15430,6 +15837,7 @@ CbcModel::setBestSolution(const double * solution, int numberColumns,
 void
 CbcModel::doHeuristicsAtRoot(int deleteHeuristicsAfterwards)
 {
+    CbcProfileTimer timer(profile_, CbcProfile::heuristics);
 
     int numberColumns = getNumCols() ;
     double * newSolution = new double [numberColumns] ;
@@ -15968,7 +16376,10 @@ CbcModel::setCutModifier(CbcCutModifier & modifier)
 int
 CbcModel::doOneNode(CbcModel * baseModel, CbcNode * & node, CbcNode * & newNode)
 {
+    CbcTraceSpan nodeSpan(profile_, "node");
     int foundSolution = 0;
+    // depth of subproblem being evaluated (for tree estimate)
+    int depth = node ? node->depth() + 1 : 0;
     int saveNumberCutGenerators=numberCutGenerators_;
     if ((moreSpecialOptions_&33554432)!=0 && (specialOptions_&2048)==0) {
       if (node&&(node->depth()==-2||node->depth()==4))
@@ -16984,7 +17395,11 @@ CbcModel::doOneNode(CbcModel * baseModel, CbcNode * & node, CbcNode * & newNode)
                         if (!heuristic_[iHeur]->shouldHeurRun(whereFrom))
                             continue;
                         double saveValue = heurValue ;
-                        int ifSol = heuristic_[iHeur]->solution(heurValue, newSolution) ;
+                        int ifSol;
+                        {
+                            CbcProfileTimer timer(profile_, CbcProfile::heuristics);
+                            ifSol = heuristic_[iHeur]->solution(heurValue, newSolution) ;
+                        }
                         if (ifSol > 0) {
                             // new solution found
                             heuristic_[iHeur]->incrementNumberSolutionsFound();
@@ -17202,6 +17617,9 @@ CbcModel::doOneNode(CbcModel * baseModel, CbcNode * & node, CbcNode * & newNode)
         baseModel->numberSolutions_++;
         unlockThread();
     }
+    // leaf unless children were created
+    treeEstimate_.addNode(depth, !newNode || !newNode->active() ||
+                          !newNode->branchingObject());
     numberCutGenerators_=saveNumberCutGenerators;
     return foundSolution;
 }
@@ -17483,31 +17901,13 @@ CbcModel::numberSavedSolutions() const
     if (!bestSolution_)
         return 0;
     else
-        return numberSavedSolutions_ + 1;
+        return solutionPool_.numberSolutions() + 1;
 }
 // Set maximum number of extra saved solutions
 void
 CbcModel::setMaximumSavedSolutions(int value)
 {
-    if (value < maximumSavedSolutions_) {
-        for (int i = value; i < maximumSavedSolutions_; i++)
-            delete [] savedSolutions_[i];
-        maximumSavedSolutions_ = value;
-        numberSavedSolutions_ = CoinMin(numberSavedSolutions_,
-                                        maximumSavedSolutions_);
-        if (!maximumSavedSolutions_)
-            delete [] savedSolutions_;
-    } else if (value > maximumSavedSolutions_) {
-        double ** temp = new double * [value];
-        int i;
-        for ( i = 0; i < maximumSavedSolutions_; i++)
-            temp[i] = savedSolutions_[i];
-        for ( ; i < value; i++)
-            temp[i] = NULL;
-        delete [] savedSolutions_;
-        maximumSavedSolutions_ = value;
-        savedSolutions_ = temp;
-    }
+    solutionPool_.setMaximumSolutions(value);
 }
 // Return a saved solution objective (0==best) - COIN_DBL_MAX if off end
 double
@@ -17515,12 +17915,10 @@ CbcModel::savedSolutionObjective(int which) const
 {
     if (which == 0) {
         return bestObjective_;
-    } else if (which <= numberSavedSolutions_) {
-        double * sol = savedSolutions_[which-1];
-        assert (static_cast<int>(sol[0]) == solver_->getNumCols());
-        return sol[1];
     } else {
-        return COIN_DBL_MAX;
+        assert (which > solutionPool_.numberSolutions() ||
+                solutionPool_.numberColumns() == solver_->getNumCols());
+        return solutionPool_.objectiveValue(which - 1);
     }
 }
 // Return a saved solution (0==best) - NULL if off end
@@ -17529,49 +17927,21 @@ CbcModel::savedSolution(int which) const
 {
     if (which == 0) {
         return bestSolution_;
-    } else if (which <= numberSavedSolutions_) {
-        double * sol = savedSolutions_[which-1];
-        assert (static_cast<int>(sol[0]) == solver_->getNumCols());
-        return sol + 2;
     } else {
-        return NULL;
+        assert (which > solutionPool_.numberSolutions() ||
+                solutionPool_.numberColumns() == solver_->getNumCols());
+        return solutionPool_.solution(which - 1);
     }
 }
-// Save a solution
+/* Save a solution - duplicates (same integer values) are only kept
+   once and pool keeps diverse solutions when full */
 void
 CbcModel::saveExtraSolution(const double * solution, double objectiveValue)
 {
-    double * save = NULL;
-    if (maximumSavedSolutions_) {
-        if (!savedSolutions_) {
-            savedSolutions_ = new double * [maximumSavedSolutions_];
-            for (int i = 0; i < maximumSavedSolutions_; i++)
-                savedSolutions_[i] = NULL;
-        }
-        int n = solver_->getNumCols();
-        int k;
-        for (k = numberSavedSolutions_ - 1; k >= 0; k--) {
-            double * sol = savedSolutions_[k];
-            assert (static_cast<int>(sol[0]) == n);
-            if (objectiveValue > sol[1])
-                break;
-        }
-        k++; // where to put
-        if (k < maximumSavedSolutions_) {
-            if (numberSavedSolutions_ == maximumSavedSolutions_) {
-                save = savedSolutions_[numberSavedSolutions_-1];
-            } else {
-                save = new double [n+2];
-                numberSavedSolutions_++;
-            }
-            // move up
-            for (int j = maximumSavedSolutions_ - 1; j > k; j--)
-                savedSolutions_[j] = savedSolutions_[j-1];
-            savedSolutions_[k] = save;
-            save[0] = n;
-            save[1] = objectiveValue;
-            memcpy(save + 2, solution, n*sizeof(double));
-        }
+    if (solutionPool_.maximumSolutions()) {
+        solutionPool_.addSolution(solution, objectiveValue,
+                                  solver_->getNumCols(),
+                                  numberIntegers_, integerVariable_);
     }
 }
 // Save a solution to best and move current to saved
@@ -17585,6 +17955,9 @@ CbcModel::saveBestSolution(const double * solution, double objectiveValue)
         bestSolution_ = new double [n];
     bestObjective_ = objectiveValue;
     memcpy(bestSolution_, solution, n*sizeof(double));
+    // keep saved solutions as differences from incumbent
+    if (solutionPool_.numberSolutions())
+        solutionPool_.setReference(bestSolution_, n);
 }
 // Delete best and saved solutions
 void
@@ -17592,25 +17965,13 @@ CbcModel::deleteSolutions()
 {
     delete [] bestSolution_;
     bestSolution_ = NULL;
-    for (int i = 0; i < maximumSavedSolutions_; i++) {
-        delete [] savedSolutions_[i];
-        savedSolutions_[i] = NULL;
-    }
-    numberSavedSolutions_ = 0;
+    solutionPool_.clear();
 }
 // Delete a saved solution and move others up
 void 
 CbcModel::deleteSavedSolution(int which)
 {
-  if (which >0 && which <= numberSavedSolutions_) {
-    delete [] savedSolutions_[which-1];
-    // move up
-    numberSavedSolutions_--;
-    for (int j =  which-1; j <numberSavedSolutions_; j++) {
-      savedSolutions_[j] = savedSolutions_[j+1];
-    }
-    savedSolutions_[numberSavedSolutions_]=NULL;
-  }
+  solutionPool_.deleteSolution(which - 1);
 }
 #ifdef COIN_HAS_CLP
 void
@@ -18134,6 +18495,220 @@ CbcModel::maximumSecondsReached() const
     }
     return hitMaxTime;
 }
+/* Check memory against maximum and degrade search if close.
+   Steps are taken at 70%, 80%, 90% and 100% of maximum.
+*/
+int
+CbcModel::checkMemoryLimit()
+{
+    double limit = dblParam_[CbcMaximumMemory];
+    if (limit <= 0.0 || memoryState_ >= 4)
+        return memoryState_;
+    double used = CbcMemory::residentBytes() / (1024.0 * 1024.0);
+    int wanted = 0;
+    if (used >= limit)
+        wanted = 4;
+    else if (used >= 0.9 * limit)
+        wanted = 3;
+    else if (used >= 0.8 * limit)
+        wanted = 2;
+    else if (used >= 0.7 * limit)
+        wanted = 1;
+    while (memoryState_ < wanted) {
+        memoryState_++;
+        const char * action = NULL;
+        lockThread();
+        if (memoryState_ == 1) {
+            // no more cuts
+            for (int i = 0; i < numberCutGenerators_; i++)
+                generator_[i]->setSwitchedOff(true);
+            action = "cut generators switched off";
+        } else if (memoryState_ == 2) {
+            // depth first keeps tree small (not if hotstart using own compare)
+            if (!hotstartSolution_) {
+                delete nodeCompare_;
+                nodeCompare_ = new CbcCompareDepth();
+                tree_->setComparison(*nodeCompare_) ;
+            }
+            action = "going depth first";
+        } else if (memoryState_ == 3) {
+            // heuristics make copies - also drop extra solutions
+            for (int i = 0; i < numberHeuristics_; i++)
+                heuristic_[i]->setWhereFrom(0);
+            solutionPool_.setMaximumSolutions(0);
+            action = "heuristics switched off";
+        } else {
+            // stop with best solution
+            eventHappened_ = true;
+            action = "stopping";
+        }
+        char general[200];
+        sprintf(general, "Using %.0f of maximum %.0f megabytes - %s",
+                used, limit, action);
+        messageHandler()->message(CBC_GENERAL, messages())
+        << general << CoinMessageEol ;
+        updateMemoryPeak();
+        printMemoryUsage();
+        unlockThread();
+    }
+    return memoryState_;
+}
+// Take memory degradation of base model
+void
+CbcModel::copyMemoryState(const CbcModel * baseModel)
+{
+    int state = baseModel->memoryState_;
+    if (state <= memoryState_)
+        return;
+    memoryState_ = state;
+    // comparison is shared with base so depth first is already there
+    if (state >= 1) {
+        for (int i = 0; i < numberCutGenerators_; i++)
+            generator_[i]->setSwitchedOff(true);
+    }
+    if (state >= 3) {
+        for (int i = 0; i < numberHeuristics_; i++)
+            heuristic_[i]->setWhereFrom(0);
+        solutionPool_.setMaximumSolutions(0);
+    }
+    if (state >= 4)
+        eventHappened_ = true;
+}
+// Estimated memory used by each part of search
+void
+CbcModel::memoryUsage(CbcMemory & usage) const
+{
+    usage.clear();
+    usage.setProcessBytes(CbcMemory::residentBytes());
+    if (!solver_)
+        return;
+    int numberColumns = solver_->getNumCols();
+    int numberRows = solver_->getNumRows();
+    // basis is two bits per variable - a diff is at worst a pair of ints per word
+    double basisBytes = 0.25 * (numberRows + numberColumns);
+    double diffBytes = 0.5 * (numberRows + numberColumns);
+    double elementBytes = sizeof(int) + sizeof(double);
+    if (tree_) {
+        std::set<const CbcNodeInfo *> infos;
+        std::set<const CbcCountRowCut *> cuts;
+        int numberNodes = tree_->size();
+        for (int i = 0; i < numberNodes; i++) {
+            const CbcNode * node = tree_->nodePointer(i);
+            if (!node)
+                continue;
+            // guess at size of branching object
+            usage.add(CbcMemory::treeNodes, sizeof(CbcNode) +
+                      (node->branchingObject() ? 64 : 0));
+            // walk back until reach information already counted
+            const CbcNodeInfo * info = node->nodeInfo();
+            while (info && infos.insert(info).second) {
+                const CbcPartialNodeInfo * partial =
+                    dynamic_cast<const CbcPartialNodeInfo *> (info);
+                if (partial)
+                    usage.add(CbcMemory::nodeInfo, sizeof(CbcPartialNodeInfo) +
+                              partial->numberChangedBounds() * elementBytes +
+                              (partial->basisDiff() ? diffBytes : 0.0));
+                else
+                    usage.add(CbcMemory::nodeInfo, sizeof(CbcFullNodeInfo) +
+                              2.0 * numberIntegers_ * sizeof(double) + basisBytes);
+                int numberCuts = info->numberCuts();
+                CbcCountRowCut ** nodeCuts = info->cuts();
+                usage.add(CbcMemory::nodeInfo, numberCuts * sizeof(CbcCountRowCut *));
+                for (int j = 0; j < numberCuts; j++) {
+                    if (nodeCuts[j] && cuts.insert(nodeCuts[j]).second)
+                        usage.add(CbcMemory::nodeCuts, sizeof(CbcCountRowCut) +
+                                  nodeCuts[j]->row().getNumElements() * elementBytes);
+                }
+                info = info->parent();
+            }
+        }
+    }
+    int numberGlobal = globalCuts_.sizeRowCuts();
+    for (int i = 0; i < numberGlobal; i++) {
+        const OsiRowCut2 * cut = globalCuts_.cut(i);
+        usage.add(CbcMemory::globalCuts, sizeof(OsiRowCut2) +
+                  cut->row().getNumElements() * elementBytes);
+    }
+    if (bestSolution_)
+        usage.add(CbcMemory::solutions, numberColumns * sizeof(double));
+    if (solutionPool_.reference())
+        usage.add(CbcMemory::solutions, solutionPool_.numberColumns() * sizeof(double));
+    for (int i = 0; i < solutionPool_.numberSolutions(); i++)
+        usage.add(CbcMemory::solutions, solutionPool_.numberDifferences(i) * elementBytes);
+    for (int i = 0; i < numberHeuristics_; i++)
+        usage.add(CbcMemory::heuristics, heuristic_[i]->memoryUsed());
+#ifdef CBC_THREAD
+    if (master_) {
+        // each thread model has copy of solver (row and column copies)
+        double solverBytes = 2.0 * solver_->getNumElements() * elementBytes +
+                             8.0 * (numberRows + numberColumns) * sizeof(double);
+        usage.add(CbcMemory::threads, master_->numberThreads() * solverBytes);
+    }
+#endif
+}
+// Work counted from iterations, nodes, cut and heuristic calls
+double
+CbcModel::countedWork() const
+{
+    double work = numberIterations_ + numberStrongIterations_ +
+                  numberExtraIterations_ + CBC_WORK_NODE * numberNodes_;
+    for (int i = 0; i < numberCutGenerators_; i++)
+        work += CBC_WORK_CUTS * generator_[i]->numberTimesEntered();
+    for (int i = 0; i < numberHeuristics_; i++)
+        work += CBC_WORK_HEURISTIC * heuristic_[i]->numRuns();
+    return work;
+}
+// Deterministic work units so far
+double
+CbcModel::workUnits() const
+{
+    return extraWork_ + workScale_ * (countedWork() - workStart_);
+}
+// Update tree estimate now
+double
+CbcModel::updateTreeEstimate()
+{
+    // unevaluated children of nodes on tree
+    int numberOpen = 0;
+    int numberNodes = tree_ ? tree_->size() : 0;
+    for (int i = 0; i < numberNodes; i++) {
+        const CbcNode * node = tree_->nodePointer(i);
+        if (node && node->nodeInfo())
+            numberOpen += CoinMax(node->nodeInfo()->numberBranchesLeft(), 1);
+    }
+    double gap = CbcProgress::gap(bestObjective_, bestPossibleObjective_);
+    treeEstimate_.estimate(numberNodes_, numberOpen, gap, getCurrentSeconds());
+    return treeEstimate_.remainingNodes();
+}
+// Estimate memory now and keep if larger than peak
+void
+CbcModel::updateMemoryPeak()
+{
+    CbcMemory usage;
+    memoryUsage(usage);
+    double processBytes = CoinMax(usage.processBytes(),
+                                  memoryPeak_.processBytes());
+    if (usage.totalBytes() > memoryPeak_.totalBytes())
+        memoryPeak_ = usage;
+    memoryPeak_.setProcessBytes(processBytes);
+}
+// Print peak memory used by each part of search
+void
+CbcModel::printMemoryUsage() const
+{
+    const CbcMemory & usage = memoryPeak_;
+    char general[400];
+    int length = sprintf(general, "Peak memory estimates (megabytes) -");
+    for (int i = 0; i < CbcMemory::numberParts; i++) {
+        if (usage.bytes(i) > 0.0)
+            length += sprintf(general + length, " %s %.1f,", CbcMemory::name(i),
+                              usage.bytes(i) / (1024.0 * 1024.0));
+    }
+    sprintf(general + length, " process %.1f",
+            usage.processBytes() / (1024.0 * 1024.0));
+    handler_->message(CBC_GENERAL, messages_)
+    << general << CoinMessageEol ;
+}
 // Check original model before it gets messed up
 void
 CbcModel::checkModel()
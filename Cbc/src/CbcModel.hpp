@@ -16,11 +16,16 @@
 #include "CbcCountRowCut.hpp"
 #include "CbcMessage.hpp"
 #include "CbcEventHandler.hpp"
+#include "CbcSolutionPool.hpp"
+#include "CbcProfile.hpp"
+#include "CbcMemory.hpp"
+#include "CbcTreeEstimate.hpp"
 #include "ClpDualRowPivot.hpp"
 
 
 class CbcCutGenerator;
 class CbcBaseModel;
+class CbcProgress;
 class OsiRowCut;
 class OsiBabSolver;
 class OsiRowCutDebugger;
@@ -190,6 +195,10 @@ public:
         CbcLargestChange,
         /// Small non-zero change on a branch to be used as guess
         CbcSmallChange,
+        /** Maximum memory in megabytes (0.0 no limit).  As the process
+            gets close the search drops cuts, goes depth first and stops
+            heuristics before finally stopping with the best solution. */
+        CbcMaximumMemory,
         /** Just a marker, so that a static sized array can store parameters. */
         CbcLastDblParam
     };
@@ -252,6 +261,11 @@ private:
                             int & numberNodesOutput, int & status) ;
     /// Update size of whichGenerator
     void resizeWhichGenerator(int numberNow, int numberAfter);
+    /// Work counted from iterations, nodes, cut and heuristic calls
+    double countedWork() const;
+    /** At end of search put best solution in continuousSolver_ and make
+        that solver_ */
+    void installBestSolution();
 public:
 #ifdef CBC_KEEP_DEPRECATED
     // See if anyone is using these any more!!
@@ -620,6 +634,38 @@ public:
 
     /// Return true if maximum time reached
     bool maximumSecondsReached() const ;
+    /** Set the
+        \link CbcModel::CbcMaximumMemory maximum memory in megabytes \endlink
+    */
+    inline bool setMaximumMemory( double value) {
+        return setDblParam(CbcMaximumMemory, value);
+    }
+    /// Get the maximum memory in megabytes
+    inline double getMaximumMemory() const {
+        return getDblParam(CbcMaximumMemory);
+    }
+    /** Check memory against maximum and degrade search if close.
+        Returns how far degraded - 0 not, 1 cuts dropped, 2 depth first,
+        3 heuristics stopped, 4 stopping */
+    int checkMemoryLimit();
+    /** Take memory degradation of base model (cut generators and
+        heuristics switched off) - used by thread models */
+    void copyMemoryState(const CbcModel * baseModel);
+    /// How far search degraded on memory (see checkMemoryLimit)
+    inline int memoryState() const {
+        return memoryState_;
+    }
+    /// Estimated memory used by each part of search now
+    void memoryUsage(CbcMemory & usage) const;
+    /** Largest estimate of memory during last search.  Estimates are
+        made with the node log (at most 1% of time) and on degrading. */
+    inline const CbcMemory & memoryPeak() const {
+        return memoryPeak_;
+    }
+    /// Estimate memory now and keep if larger than peak
+    void updateMemoryPeak();
+    /// Print peak memory used by each part of search
+    void printMemoryUsage() const;
 
     /** Set the
       \link CbcModel::CbcIntegerTolerance integrality tolerance \endlink
@@ -968,6 +1014,7 @@ public:
         6 stopped on solutions
         7 linear relaxation unbounded
         8 stopped on iteration limit
+        9 stopped on memory limit
     */
     inline int secondaryStatus() const {
         return secondaryStatus_;
@@ -1335,7 +1382,7 @@ public:
     int numberSavedSolutions() const;
     /// Maximum number of extra saved solutions
     inline int maximumSavedSolutions() const {
-        return maximumSavedSolutions_;
+        return solutionPool_.maximumSolutions();
     }
     /// Set maximum number of extra saved solutions
     void setMaximumSavedSolutions(int value);
@@ -1345,6 +1392,37 @@ public:
     double savedSolutionObjective(int which) const;
     /// Delete a saved solution and move others up
     void deleteSavedSolution(int which);
+    /** Pool of extra saved solutions (savedSolution(i) is pool
+        solution i-1).  Heuristics can look at differences directly. */
+    inline const CbcSolutionPool * solutionPool() const {
+        return &solutionPool_;
+    }
+    /** Time and count for each phase of branch and bound (see CbcProfile).
+        Cleared at start of branchAndBound - threads added in at end. */
+    inline const CbcProfile & profile() const {
+        return profile_;
+    }
+    /// Profile so threads etc can add time
+    inline CbcProfile & profile() {
+        return profile_;
+    }
+    /** Set progress stream (not owned - not copied).
+        Rows are written during branchAndBound - see CbcProgress. */
+    inline void setProgress(CbcProgress * progress) {
+        progress_ = progress;
+    }
+    /// Progress stream (NULL if none)
+    inline CbcProgress * progress() const {
+        return progress_;
+    }
+    /** Estimate of tree size and remaining nodes and time (see
+        CbcTreeEstimate).  Updated with the node log - cleared at start
+        of branchAndBound. */
+    inline const CbcTreeEstimate & treeEstimate() const {
+        return treeEstimate_;
+    }
+    /// Update tree estimate now (returns estimated remaining nodes)
+    double updateTreeEstimate();
 
     /** Current phase (so heuristics etc etc can find out).
         0 - initial solve
@@ -1870,6 +1948,13 @@ public:
 	10 bit (1024) - branching on constraints (later)
 	11/12 bit 2048 - intermittent cuts
 	13/14 bit 8192 - go to bitter end in strong branching (first time)
+	15 bit (32768) - genetic improvement phase (CbcHeuristicGenetic) in solver
+	16 bit (65536) - solve independent components as separate models
+	17 bit (131072) - keep information for resolveIncremental
+	18 bit (262144) - information kept by a search (set by code)
+	19 bit (524288) - time is deterministic work (setUseWorkClock)
+	20 bit (1048576) - pin threads to cpus (setPinThreads)
+	21 bit (2097152) - resolving (set by restoreForResolve, cleared by branchAndBound)
     */
     inline void setMoreSpecialOptions2(int value) {
         moreSpecialOptions2_ = value;
@@ -1893,6 +1978,49 @@ public:
     inline bool useElapsedTime() const {
         return (moreSpecialOptions_&131072)!=0;
     }
+    /** Set whether time is deterministic work rather than seconds.
+        Work counts simplex iterations (including strong branching),
+        nodes, cut generator calls and heuristic runs scaled by size of
+        problem (rows+columns+elements) so a unit is very roughly a
+        second.  Time limits, log times and decisions taken on time then
+        do not depend on the machine (or on thread timing if threads
+        are deterministic).  Work starts again with each branchAndBound.
+    */
+    inline void setUseWorkClock(bool yesNo) {
+        if (yesNo)
+          moreSpecialOptions2_ |= 524288;
+        else
+          moreSpecialOptions2_ &= ~524288;
+    }
+    /// Whether time is deterministic work
+    inline bool useWorkClock() const {
+        return (moreSpecialOptions2_&524288) != 0;
+    }
+    /// Deterministic work units so far (see setUseWorkClock)
+    double workUnits() const;
+    /** Set whether to pin threads to cpus (Linux only).  Threads are
+        placed filling one socket before the next and each copies its
+        solvers once running so memory is on its own NUMA node.  Nodes
+        go preferably to a thread on same socket as last one finished.
+    */
+    inline void setPinThreads(bool yesNo) {
+        if (yesNo)
+          moreSpecialOptions2_ |= 1048576;
+        else
+          moreSpecialOptions2_ &= ~1048576;
+    }
+    /// Whether threads are pinned to cpus
+    inline bool pinThreads() const {
+        return (moreSpecialOptions2_&1048576) != 0;
+    }
+    /// Set work at start of branchAndBound (e.g. so sub-model continues clock)
+    inline void setInitialWork(double units) {
+        initialWork_ = units;
+    }
+    /// Add work units (e.g. done by a sub-model)
+    inline void addWork(double units) {
+        extraWork_ += units;
+    }
     /// Get useful temporary pointer
     inline void * temporaryPointer() const
     { return temporaryPointer_;}
@@ -1992,6 +2120,11 @@ public:
         delete continuousSolver_;
         continuousSolver_ = NULL;
     }
+    /// Set solver with continuous state (takes ownership)
+    inline void setContinuousSolver(OsiSolverInterface * solver) {
+        delete continuousSolver_;
+        continuousSolver_ = solver;
+    }
 
     /// A copy of the solver, taken at constructor or by saveReferenceSolver
     inline OsiSolverInterface * referenceSolver() const {
@@ -2008,6 +2141,56 @@ public:
     */
     void resetToReferenceSolver();
 
+    /**@name Incremental re-solve
+
+      If keepForResolve is set then branchAndBound saves the problem as
+      given as reference solver and keeps globally valid cuts at the end.
+      The problem can then be changed with the resolve methods below
+      (which change the reference solver - or the current solver if no
+      search has been done) and solved again with resolveIncremental.
+      This keeps pseudocosts (given to objects when branchAndBound has
+      created them) and the incumbent if it is still feasible.  Cuts are
+      kept if the feasible region has only got smaller, the objective has
+      not changed and the incumbent is still feasible (some cuts depend on
+      the cutoff).  If the search was on a preprocessed model (CbcMain1
+      only preprocesses the first solve) only the incumbent is kept.
+    */
+    //@{
+    /// Set whether to keep information for resolveIncremental
+    void setKeepForResolve(bool yesNo);
+    /// Whether information is kept for resolveIncremental
+    inline bool keepForResolve() const {
+        return (moreSpecialOptions2_&131072) != 0;
+    }
+    /// Change bounds of a column
+    void resolveSetColumnBounds(int iColumn, double lower, double upper);
+    /// Change an objective coefficient
+    void resolveSetObjective(int iColumn, double value);
+    /// Change bounds (rhs) of a row
+    void resolveSetRowBounds(int iRow, double lower, double upper);
+    /// Append rows given by row starts
+    void resolveAddRows(int numberRows, const CoinBigIndex * rowStarts,
+                        const int * columns, const double * elements,
+                        const double * rowLower, const double * rowUpper);
+    /** Put changed problem in solver and check incumbent against it.
+        This is the first part of resolveIncremental - Cbc_resolve uses it
+        and then solves through CbcMain1 so parameters are as for Cbc_solve.
+        Returns false if nothing kept */
+    bool restoreForResolve();
+    /// True if restoreForResolve done and branchAndBound not yet done
+    inline bool resolving() const {
+        return (moreSpecialOptions2_&2097152) != 0;
+    }
+    /** Solve again after changes.  If nothing kept this is
+        initialSolve followed by branchAndBound */
+    void resolveIncremental(int doStatistics = 0);
+    /** Search was on a preprocessed model - information kept for
+        resolveIncremental is made in terms of original problem in
+        solver (taken over).  Cuts and pseudocosts from search are in
+        terms of preprocessed model so are dropped. */
+    void setResolveOriginal(OsiSolverInterface * solver);
+    //@}
+
     /// Clears out as much as possible (except solver)
     void gutsOfDestructor();
     /** Clears out enough to reset CbcModel as if no branch and bound done
@@ -2022,7 +2205,13 @@ public:
            2 copy and delete before (but use virgin generators)
     */
     void gutsOfCopy(const CbcModel & rhs, int mode = 0);
-    /// Move status, nodes etc etc across
+    /// Keep copies of dynamic pseudocost objects for resolve (NULL clears)
+    void setResolveObjects(OsiObject ** objects, int numberObjects);
+    /** Copy pseudocosts kept by last search into objects now there
+        (matched on column).  Done by branchAndBound when resolving */
+    void restoreResolvePseudoCosts();
+    /** Move status, nodes etc etc across (and information kept for
+        resolveIncremental) */
     void moveInfo(const CbcModel & rhs);
     //@}
 
@@ -2111,6 +2300,7 @@ public:
     */
     void setInfoInChild(int type, CbcThread * info);
     /** Move/copy information from one model to another
+        -2 - copy own solvers (in thread so memory is local to it)
         -1 - initialization
         0 - from base model
         1 - to base model (and reset)
@@ -2425,6 +2615,12 @@ private:
     /// A copy of the solver, taken at constructor or by saveReferenceSolver
     OsiSolverInterface * referenceSolver_;
 
+    /** Copies of dynamic pseudocost objects at end of search kept for
+        resolveIncremental (columns as in referenceSolver_) */
+    OsiObject ** resolveObjects_;
+    /// Number of objects in resolveObjects_
+    int numberResolveObjects_;
+
     /// Message handler
     CoinMessageHandler * handler_;
 
@@ -2465,8 +2661,10 @@ private:
 
     /// Array holding the incumbent (best) solution.
     double * bestSolution_;
-    /// Arrays holding other solutions.
-    double ** savedSolutions_;
+    /// Other (not best) solutions.
+    CbcSolutionPool solutionPool_;
+    /// Time spent in each phase of branch and bound
+    CbcProfile profile_;
 
     /** Array holding the current solution.
 
@@ -2497,10 +2695,6 @@ private:
     double minimumDrop_;
     /// Number of solutions
     int numberSolutions_;
-    /// Number of saved solutions
-    int numberSavedSolutions_;
-    /// Maximum number of saved solutions
-    int maximumSavedSolutions_;
     /** State of search
         0 - no solution
         1 - only heuristic solutions
@@ -2918,6 +3112,22 @@ private:
     CbcBaseModel * master_;
     /// Pointer to masterthread
     CbcThread * masterThread_;
+    /// Progress stream (not owned)
+    CbcProgress * progress_;
+    /// How far search degraded on memory
+    int memoryState_;
+    /// Largest estimate of memory
+    CbcMemory memoryPeak_;
+    /// Estimate of tree size
+    CbcTreeEstimate treeEstimate_;
+    /// Work units per counted unit of work (from size of problem)
+    double workScale_;
+    /// Counted work at start of search
+    double workStart_;
+    /// Work at start of search
+    double initialWork_;
+    /// Work at start of search plus work added
+    double extraWork_;
 //@}
 };
 /// So we can use osiObject or CbcObject during transition
@@ -0,0 +1,942 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include "CbcConfig.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#ifdef CBC_THREAD
+#include <pthread.h>
+#endif
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+#include "CoinFileIO.hpp"
+#include "CoinError.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "OsiSolverInterface.hpp"
+#include "CbcMpsImport.hpp"
+
+namespace {
+
+// Split line into tokens - returns number of tokens (maximum+1 if more)
+// and sets next to start of next line
+int splitLine(const char * put, const char * end, const char ** token,
+              int * length, int maximum, const char *& next)
+{
+    int numberTokens = 0;
+    const char * p = put;
+    while (p < end && *p != '\n') {
+        char c = *p;
+        if (c == ' ' || c == '\t' || c == '\r') {
+            p++;
+            continue;
+        }
+        const char * start = p;
+        while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n')
+            p++;
+        if (numberTokens < maximum) {
+            token[numberTokens] = start;
+            length[numberTokens] = static_cast<int> (p - start);
+        }
+        numberTokens++;
+    }
+    next = (p < end) ? p + 1 : end;
+    return CoinMin(numberTokens, maximum + 1);
+}
+
+// Start of next line
+inline const char * nextLine(const char * p, const char * end)
+{
+    const char * nl = static_cast<const char *>
+                      (memchr(p, '\n', end - p));
+    return nl ? nl + 1 : end;
+}
+
+// True if token is word
+inline bool isWord(const char * token, int length, const char * word)
+{
+    return static_cast<int> (strlen(word)) == length &&
+           !memcmp(token, word, length);
+}
+
+// Get value - buffer is not null terminated so copy
+bool getValue(const char * token, int length, double & value)
+{
+    char buffer[64];
+    if (length <= 0 || length >= 64)
+        return false;
+    memcpy(buffer, token, length);
+    buffer[length] = '\0';
+    char * after;
+    value = strtod(buffer, &after);
+    if (after != buffer + length)
+        return false;
+    if (value >= 1.0e30)
+        value = COIN_DBL_MAX;
+    else if (value <= -1.0e30)
+        value = -COIN_DBL_MAX;
+    return true;
+}
+
+/* Hash of names which point into file buffer.  Names are not copied
+   so lookups in threads are just reads. */
+class NameHash {
+public:
+    NameHash() : mask_(0) {}
+    // Add all names - returns -1 if duplicate
+    int build(const std::vector<const char *> & name,
+              const std::vector<int> & length) {
+        name_ = &name;
+        length_ = &length;
+        int n = static_cast<int> (name.size());
+        int size = 16;
+        while (size < 2 * n)
+            size *= 2;
+        mask_ = size - 1;
+        table_.assign(size, -1);
+        for (int i = 0; i < n; i++) {
+            unsigned int k = hash(name[i], length[i]) & mask_;
+            while (table_[k] >= 0) {
+                int j = table_[k];
+                if (length[j] == length[i] && !memcmp(name[j], name[i], length[i]))
+                    return -1;
+                k = (k + 1) & mask_;
+            }
+            table_[k] = i;
+        }
+        return 0;
+    }
+    // Find name (-1 if not there)
+    inline int find(const char * name, int length) const {
+        if (!mask_)
+            return -1;
+        unsigned int k = hash(name, length) & mask_;
+        while (table_[k] >= 0) {
+            int j = table_[k];
+            if ((*length_)[j] == length && !memcmp((*name_)[j], name, length))
+                return j;
+            k = (k + 1) & mask_;
+        }
+        return -1;
+    }
+private:
+    static inline unsigned int hash(const char * name, int length) {
+        // FNV-1a
+        unsigned int value = 2166136261u;
+        for (int i = 0; i < length; i++) {
+            value ^= static_cast<unsigned char> (name[i]);
+            value *= 16777619u;
+        }
+        return value;
+    }
+    std::vector<int> table_;
+    const std::vector<const char *> * name_;
+    const std::vector<int> * length_;
+    unsigned int mask_;
+};
+
+// What each thread does with one piece of COLUMNS section
+struct CbcMpsChunk {
+    // Input
+    const char * start;
+    const char * end;
+    const NameHash * rows;
+    const char * objectiveName;
+    int objectiveLength;
+    // Output of parse
+    std::vector<const char *> columnName;
+    std::vector<int> columnNameLength;
+    std::vector<int> columnFirst;
+    std::vector<double> columnCost;
+    // 1 if objective entry seen
+    std::vector<char> columnHasCost;
+    // -1 not known (before first marker in chunk), 0 continuous, 1 integer
+    std::vector<signed char> columnInteger;
+    // marker state at end of chunk (-1 no marker)
+    int lastMarker;
+    std::vector<int> row;
+    std::vector<double> element;
+    int numberErrors;
+    // Input to copy
+    CoinBigIndex firstElement;
+    int * rowOut;
+    double * elementOut;
+};
+
+// Parse one chunk of COLUMNS
+void parseChunk(CbcMpsChunk * chunk)
+{
+    const char * p = chunk->start;
+    const char * end = chunk->end;
+    int state = -1;
+    const char * token[6];
+    int length[6];
+    // rough guess at size
+    size_t guess = static_cast<size_t> (end - p) / 24;
+    chunk->row.reserve(guess);
+    chunk->element.reserve(guess);
+    while (p < end) {
+        if (*p == '*') {
+            p = nextLine(p, end);
+            continue;
+        }
+        const char * next;
+        int n = splitLine(p, end, token, length, 5, next);
+        p = next;
+        if (!n)
+            continue;
+        if (n == 3 && isWord(token[1], length[1], "'MARKER'")) {
+            if (isWord(token[2], length[2], "'INTORG'")) {
+                state = 1;
+            } else if (isWord(token[2], length[2], "'INTEND'")) {
+                state = 0;
+            } else {
+                chunk->numberErrors++;
+                break;
+            }
+            chunk->lastMarker = state;
+            continue;
+        }
+        if (n != 3 && n != 5) {
+            chunk->numberErrors++;
+            break;
+        }
+        int numberColumns = static_cast<int> (chunk->columnName.size());
+        if (!numberColumns ||
+                chunk->columnNameLength[numberColumns-1] != length[0] ||
+                memcmp(chunk->columnName[numberColumns-1], token[0], length[0])) {
+            chunk->columnName.push_back(token[0]);
+            chunk->columnNameLength.push_back(length[0]);
+            chunk->columnFirst.push_back(static_cast<int> (chunk->row.size()));
+            chunk->columnCost.push_back(0.0);
+            chunk->columnHasCost.push_back(0);
+            chunk->columnInteger.push_back(static_cast<signed char> (state));
+            numberColumns++;
+        }
+        for (int i = 1; i < n; i += 2) {
+            double value;
+            if (!getValue(token[i+1], length[i+1], value)) {
+                chunk->numberErrors++;
+                break;
+            }
+            if (length[i] == chunk->objectiveLength &&
+                    !memcmp(token[i], chunk->objectiveName, length[i])) {
+                // duplicate objective entry - leave to CoinMpsIO
+                if (chunk->columnHasCost[numberColumns-1]) {
+                    chunk->numberErrors++;
+                    break;
+                }
+                chunk->columnCost[numberColumns-1] = value;
+                chunk->columnHasCost[numberColumns-1] = 1;
+                continue;
+            }
+            int iRow = chunk->rows->find(token[i], length[i]);
+            if (iRow < 0) {
+                chunk->numberErrors++;
+                break;
+            }
+            // zeros are kept so duplicates can be found - taken out later
+            chunk->row.push_back(iRow);
+            chunk->element.push_back(value);
+        }
+        if (chunk->numberErrors)
+            break;
+    }
+}
+
+// Copy chunk elements to final place
+void copyChunk(CbcMpsChunk * chunk)
+{
+    int n = static_cast<int> (chunk->row.size());
+    if (n) {
+        CoinMemcpyN(&chunk->row[0], n, chunk->rowOut + chunk->firstElement);
+        CoinMemcpyN(&chunk->element[0], n,
+                    chunk->elementOut + chunk->firstElement);
+    }
+    // free memory early
+    std::vector<int>().swap(chunk->row);
+    std::vector<double>().swap(chunk->element);
+}
+
+#ifdef CBC_THREAD
+struct CbcMpsThreadInfo {
+    CbcMpsChunk * chunks;
+    int numberChunks;
+    int numberThreads;
+    int threadNumber;
+    int copy;
+};
+
+void * doMpsThread(void * voidInfo)
+{
+    CbcMpsThreadInfo * info = reinterpret_cast<CbcMpsThreadInfo *> (voidInfo);
+    for (int i = info->threadNumber; i < info->numberChunks;
+            i += info->numberThreads) {
+        if (!info->copy)
+            parseChunk(info->chunks + i);
+        else
+            copyChunk(info->chunks + i);
+    }
+    return NULL;
+}
+#endif
+
+// Do all chunks (in threads if possible)
+void doChunks(CbcMpsChunk * chunks, int numberChunks, int numberThreads,
+              int copy)
+{
+#ifdef CBC_THREAD
+    if (numberThreads > 1 && numberChunks > 1) {
+        numberThreads = CoinMin(numberThreads, numberChunks);
+        pthread_t * threadId = new pthread_t [numberThreads];
+        CbcMpsThreadInfo * info = new CbcMpsThreadInfo [numberThreads];
+        for (int i = 0; i < numberThreads; i++) {
+            info[i].chunks = chunks;
+            info[i].numberChunks = numberChunks;
+            info[i].numberThreads = numberThreads;
+            info[i].threadNumber = i;
+            info[i].copy = copy;
+            pthread_create(threadId + i, NULL, doMpsThread, info + i);
+        }
+        for (int i = 0; i < numberThreads; i++)
+            pthread_join(threadId[i], NULL);
+        delete [] threadId;
+        delete [] info;
+        return;
+    }
+#endif
+    for (int i = 0; i < numberChunks; i++) {
+        if (!copy)
+            parseChunk(chunks + i);
+        else
+            copyChunk(chunks + i);
+    }
+}
+
+// Header lines start in column 1
+enum {
+    MPS_NAME = 0, MPS_ROWS, MPS_COLUMNS, MPS_RHS, MPS_RANGES, MPS_BOUNDS,
+    MPS_ENDATA, MPS_OTHER, MPS_DATA
+};
+
+// See if line is header (first character not blank)
+int headerType(const char * p, const char * end)
+{
+    if (p >= end || *p == ' ' || *p == '\t' || *p == '\r' || *p == '\n' ||
+            *p == '*')
+        return MPS_DATA;
+    const char * token[3];
+    int length[3];
+    const char * next;
+    int n = splitLine(p, end, token, length, 2, next);
+    if (isWord(token[0], length[0], "NAME"))
+        return MPS_NAME;
+    if (n > 1)
+        return MPS_DATA; // free format data line
+    if (isWord(token[0], length[0], "ROWS"))
+        return MPS_ROWS;
+    if (isWord(token[0], length[0], "COLUMNS"))
+        return MPS_COLUMNS;
+    if (isWord(token[0], length[0], "RHS"))
+        return MPS_RHS;
+    if (isWord(token[0], length[0], "RANGES"))
+        return MPS_RANGES;
+    if (isWord(token[0], length[0], "BOUNDS"))
+        return MPS_BOUNDS;
+    if (isWord(token[0], length[0], "ENDATA"))
+        return MPS_ENDATA;
+    // OBJSENSE, QUADOBJ, SOS etc - leave to CoinMpsIO
+    return MPS_OTHER;
+}
+}
+
+// Default Constructor
+CbcMpsImport::CbcMpsImport ()
+    : columnStart_(NULL),
+      row_(NULL),
+      element_(NULL),
+      columnLower_(NULL),
+      columnUpper_(NULL),
+      objective_(NULL),
+      rowLower_(NULL),
+      rowUpper_(NULL),
+      integerType_(NULL),
+      objectiveOffset_(0.0),
+      numberRows_(0),
+      numberColumns_(0),
+      numberElements_(0),
+      numberIntegers_(0)
+{
+}
+
+// Destructor
+CbcMpsImport::~CbcMpsImport ()
+{
+    gutsOfDelete();
+}
+
+void
+CbcMpsImport::gutsOfDelete()
+{
+    delete [] columnStart_;
+    delete [] row_;
+    delete [] element_;
+    delete [] columnLower_;
+    delete [] columnUpper_;
+    delete [] objective_;
+    delete [] rowLower_;
+    delete [] rowUpper_;
+    delete [] integerType_;
+    columnStart_ = NULL;
+    row_ = NULL;
+    element_ = NULL;
+    columnLower_ = NULL;
+    columnUpper_ = NULL;
+    objective_ = NULL;
+    rowLower_ = NULL;
+    rowUpper_ = NULL;
+    integerType_ = NULL;
+    objectiveOffset_ = 0.0;
+    numberRows_ = 0;
+    numberColumns_ = 0;
+    numberElements_ = 0;
+    numberIntegers_ = 0;
+    problemName_ = "";
+    rowNames_.clear();
+    columnNames_.clear();
+}
+
+// Read MPS file
+int
+CbcMpsImport::readMps(const char * fileName, int numberThreads,
+                      bool keepNames)
+{
+    gutsOfDelete();
+    if (!fileName || !strcmp(fileName, "-"))
+        return -1;
+    numberThreads = CoinMax(numberThreads, 1);
+    size_t length = strlen(fileName);
+    bool compressed =
+        (length > 3 && !strcmp(fileName + length - 3, ".gz")) ||
+        (length > 4 && !strcmp(fileName + length - 4, ".bz2"));
+    int returnCode = -1;
+#ifndef _MSC_VER
+    if (!compressed) {
+        int fd = open(fileName, O_RDONLY);
+        if (fd < 0)
+            return -1;
+        struct stat statBuffer;
+        if (fstat(fd, &statBuffer) || !statBuffer.st_size) {
+            close(fd);
+            return -1;
+        }
+        size_t size = static_cast<size_t> (statBuffer.st_size);
+        void * mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED)
+            return -1;
+        madvise(mapped, size, MADV_SEQUENTIAL);
+        const char * buffer = static_cast<const char *> (mapped);
+        returnCode = parse(buffer, buffer + size, numberThreads, keepNames);
+        munmap(mapped, size);
+        if (returnCode)
+            gutsOfDelete();
+        return returnCode;
+    }
+#endif
+    // Stream into memory (decompressing if needed)
+    CoinFileInput * input = NULL;
+    try {
+        input = CoinFileInput::create(fileName);
+    } catch (CoinError &) {
+        return -1;
+    }
+    size_t size = 0;
+    size_t maximumSize = 1 << 22;
+    char * buffer = new char [maximumSize];
+    while (true) {
+        if (size == maximumSize) {
+            maximumSize *= 2;
+            char * temp = new char [maximumSize];
+            memcpy(temp, buffer, size);
+            delete [] buffer;
+            buffer = temp;
+        }
+        int nRead = input->read(buffer + size,
+                                static_cast<int> (CoinMin(maximumSize - size,
+                                                  static_cast<size_t> (1 << 24))));
+        if (nRead <= 0)
+            break;
+        size += nRead;
+    }
+    delete input;
+    if (size)
+        returnCode = parse(buffer, buffer + size, numberThreads, keepNames);
+    delete [] buffer;
+    if (returnCode)
+        gutsOfDelete();
+    return returnCode;
+}
+
+// Parse buffer
+int
+CbcMpsImport::parse(const char * buffer, const char * end, int numberThreads,
+                    bool keepNames)
+{
+    const char * p = buffer;
+    const char * token[6];
+    int length[6];
+    const char * next;
+    // NAME and ROWS
+    int section = -1;
+    const char * objectiveName = NULL;
+    int objectiveLength = 0;
+    std::vector<const char *> rowName;
+    std::vector<int> rowNameLength;
+    std::vector<char> rowType;
+    while (p < end) {
+        int type = headerType(p, end);
+        if (type == MPS_DATA) {
+            if (*p == '*') {
+                p = nextLine(p, end);
+                continue;
+            }
+            int n = splitLine(p, end, token, length, 2, next);
+            p = next;
+            if (!n)
+                continue;
+            if (section != MPS_ROWS || n != 2 || length[0] != 1)
+                return -1;
+            char c = token[0][0];
+            if (c == 'N') {
+                // only one objective
+                if (objectiveName)
+                    return -1;
+                objectiveName = token[1];
+                objectiveLength = length[1];
+            } else if (c == 'E' || c == 'L' || c == 'G') {
+                rowName.push_back(token[1]);
+                rowNameLength.push_back(length[1]);
+                rowType.push_back(c);
+            } else {
+                return -1;
+            }
+        } else if (type == MPS_NAME) {
+            if (section >= 0)
+                return -1;
+            int n = splitLine(p, end, token, length, 2, next);
+            p = next;
+            if (n == 2)
+                problemName_ = std::string(token[1], length[1]);
+            else if (n > 2)
+                return -1;
+            section = MPS_NAME;
+        } else if (type == MPS_ROWS) {
+            p = nextLine(p, end);
+            section = MPS_ROWS;
+        } else if (type == MPS_COLUMNS && section == MPS_ROWS) {
+            p = nextLine(p, end);
+            section = MPS_COLUMNS;
+            break;
+        } else {
+            return -1;
+        }
+    }
+    if (section != MPS_COLUMNS || !objectiveName)
+        return -1;
+    numberRows_ = static_cast<int> (rowName.size());
+    NameHash rowHash;
+    if (rowHash.build(rowName, rowNameLength))
+        return -1;
+    if (rowHash.find(objectiveName, objectiveLength) >= 0)
+        return -1;
+    // Find end of COLUMNS - just look at lines starting in column 1
+    const char * startColumns = p;
+    const char * endColumns = end;
+    int nextSection = MPS_ENDATA;
+    while (p < end) {
+        if (*p != ' ' && *p != '\t' && *p != '*' && *p != '\n' && *p != '\r') {
+            int type = headerType(p, end);
+            if (type != MPS_DATA) {
+                endColumns = p;
+                nextSection = type;
+                break;
+            }
+        }
+        p = nextLine(p, end);
+    }
+    // Split into chunks on line boundaries
+    size_t sizeColumns = endColumns - startColumns;
+    int numberChunks = 1;
+    if (numberThreads > 1 && sizeColumns > 1000000)
+        numberChunks = 4 * numberThreads;
+    CbcMpsChunk * chunks = new CbcMpsChunk [numberChunks];
+    const char * startChunk = startColumns;
+    for (int i = 0; i < numberChunks; i++) {
+        CbcMpsChunk & chunk = chunks[i];
+        const char * endChunk;
+        if (i < numberChunks - 1) {
+            endChunk = startColumns + ((i + 1) * sizeColumns) / numberChunks;
+            if (endChunk < startChunk)
+                endChunk = startChunk;
+            else if (endChunk > startColumns)
+                endChunk = nextLine(endChunk - 1, endColumns);
+        } else {
+            endChunk = endColumns;
+        }
+        chunk.start = startChunk;
+        chunk.end = endChunk;
+        chunk.rows = &rowHash;
+        chunk.objectiveName = objectiveName;
+        chunk.objectiveLength = objectiveLength;
+        chunk.lastMarker = -1;
+        chunk.numberErrors = 0;
+        chunk.firstElement = 0;
+        chunk.rowOut = NULL;
+        chunk.elementOut = NULL;
+        startChunk = endChunk;
+    }
+    doChunks(chunks, numberChunks, numberThreads, 0);
+    // Merge - a column may be split between chunks
+    int numberColumns = 0;
+    CoinBigIndex numberElements = 0;
+    int lastChunk = -1;
+    for (int i = 0; i < numberChunks; i++) {
+        CbcMpsChunk & chunk = chunks[i];
+        if (chunk.numberErrors) {
+            delete [] chunks;
+            return -1;
+        }
+        int n = static_cast<int> (chunk.columnName.size());
+        numberColumns += n;
+        if (n && lastChunk >= 0) {
+            const CbcMpsChunk & last = chunks[lastChunk];
+            int nLast = static_cast<int> (last.columnName.size()) - 1;
+            if (last.columnNameLength[nLast] == chunk.columnNameLength[0] &&
+                    !memcmp(last.columnName[nLast], chunk.columnName[0],
+                            chunk.columnNameLength[0]))
+                numberColumns--;
+        }
+        if (n)
+            lastChunk = i;
+        chunk.firstElement = numberElements;
+        numberElements += static_cast<CoinBigIndex> (chunk.row.size());
+    }
+    numberColumns_ = numberColumns;
+    numberElements_ = numberElements;
+    columnStart_ = new CoinBigIndex [numberColumns + 1];
+    row_ = new int [numberElements];
+    element_ = new double [numberElements];
+    objective_ = new double [numberColumns];
+    columnLower_ = new double [numberColumns];
+    columnUpper_ = new double [numberColumns];
+    integerType_ = new char [numberColumns];
+    std::vector<const char *> columnName;
+    std::vector<int> columnNameLength;
+    std::vector<char> hasCost(numberColumns, 0);
+    columnName.reserve(numberColumns);
+    columnNameLength.reserve(numberColumns);
+    int state = 0;
+    int iColumn = -1;
+    bool duplicate = false;
+    for (int i = 0; i < numberChunks; i++) {
+        CbcMpsChunk & chunk = chunks[i];
+        int n = static_cast<int> (chunk.columnName.size());
+        for (int j = 0; j < n; j++) {
+            if (j || iColumn < 0 ||
+                    columnNameLength[iColumn] != chunk.columnNameLength[0] ||
+                    memcmp(columnName[iColumn], chunk.columnName[0],
+                           chunk.columnNameLength[0])) {
+                iColumn++;
+                columnName.push_back(chunk.columnName[j]);
+                columnNameLength.push_back(chunk.columnNameLength[j]);
+                columnStart_[iColumn] = chunk.firstElement + chunk.columnFirst[j];
+                objective_[iColumn] = chunk.columnCost[j];
+                int type = chunk.columnInteger[j];
+                integerType_[iColumn] = static_cast<char> (type >= 0 ? type : state);
+            } else {
+                // continuation of last column
+                if (chunk.columnHasCost[j] && hasCost[iColumn])
+                    duplicate = true;
+                objective_[iColumn] += chunk.columnCost[j];
+            }
+            if (chunk.columnHasCost[j])
+                hasCost[iColumn] = 1;
+        }
+        if (chunk.lastMarker >= 0)
+            state = chunk.lastMarker;
+        chunk.rowOut = row_;
+        chunk.elementOut = element_;
+    }
+    assert (iColumn == numberColumns - 1);
+    columnStart_[numberColumns] = numberElements;
+    doChunks(chunks, numberChunks, numberThreads, 1);
+    delete [] chunks;
+    if (duplicate)
+        return -1;
+    /* A row twice in a column - CoinMpsIO has its own rules for
+       duplicates so leave them to it.  Zeros go now. */
+    {
+        int * mark = new int [numberRows_];
+        for (int iRow = 0; iRow < numberRows_; iRow++)
+            mark[iRow] = -1;
+        CoinBigIndex put = 0;
+        CoinBigIndex start = 0;
+        for (iColumn = 0; iColumn < numberColumns; iColumn++) {
+            CoinBigIndex endColumn = columnStart_[iColumn+1];
+            columnStart_[iColumn] = put;
+            for (CoinBigIndex j = start; j < endColumn; j++) {
+                int iRow = row_[j];
+                if (mark[iRow] == iColumn) {
+                    duplicate = true;
+                    break;
+                }
+                mark[iRow] = iColumn;
+                if (element_[j]) {
+                    row_[put] = iRow;
+                    element_[put++] = element_[j];
+                }
+            }
+            if (duplicate)
+                break;
+            start = endColumn;
+        }
+        delete [] mark;
+        if (duplicate)
+            return -1;
+        columnStart_[numberColumns] = put;
+        numberElements_ = put;
+    }
+    NameHash columnHash;
+    if (columnHash.build(columnName, columnNameLength))
+        return -1;
+    for (iColumn = 0; iColumn < numberColumns; iColumn++) {
+        columnLower_[iColumn] = 0.0;
+        columnUpper_[iColumn] = COIN_DBL_MAX;
+    }
+    // RHS, RANGES and BOUNDS (small so sequential)
+    double * rhs = new double [numberRows_];
+    double * range = new double [numberRows_];
+    char * hasRange = new char [numberRows_];
+    CoinZeroN(rhs, numberRows_);
+    CoinZeroN(range, numberRows_);
+    CoinZeroN(hasRange, numberRows_);
+    char * boundSet = new char [numberColumns];
+    CoinZeroN(boundSet, numberColumns);
+    int returnCode = 0;
+    p = endColumns;
+    section = nextSection;
+    if (section != MPS_ENDATA)
+        p = nextLine(p, end);
+    while (p < end && !returnCode && section != MPS_ENDATA) {
+        if (section == MPS_OTHER || section == MPS_NAME ||
+                section == MPS_ROWS || section == MPS_COLUMNS) {
+            returnCode = -1;
+            break;
+        }
+        int type = headerType(p, end);
+        if (type != MPS_DATA) {
+            section = type;
+            p = nextLine(p, end);
+            continue;
+        }
+        if (*p == '*') {
+            p = nextLine(p, end);
+            continue;
+        }
+        int n = splitLine(p, end, token, length, 5, next);
+        p = next;
+        if (!n)
+            continue;
+        if (section == MPS_RHS || section == MPS_RANGES) {
+            // set name is optional
+            int first = (n == 2 || n == 4) ? 0 : 1;
+            if (n < 2 || n > 5) {
+                returnCode = -1;
+                break;
+            }
+            for (int i = first; i < n; i += 2) {
+                double value;
+                if (i + 1 >= n || !getValue(token[i+1], length[i+1], value)) {
+                    returnCode = -1;
+                    break;
+                }
+                if (length[i] == objectiveLength &&
+                        !memcmp(token[i], objectiveName, objectiveLength)) {
+                    if (section == MPS_RANGES) {
+                        returnCode = -1;
+                        break;
+                    }
+                    // as CoinMpsIO
+                    objectiveOffset_ = value;
+                    continue;
+                }
+                int iRow = rowHash.find(token[i], length[i]);
+                if (iRow < 0) {
+                    returnCode = -1;
+                    break;
+                }
+                if (section == MPS_RHS) {
+                    rhs[iRow] = value;
+                } else {
+                    range[iRow] = value;
+                    hasRange[iRow] = 1;
+                }
+            }
+        } else if (section == MPS_BOUNDS) {
+            if (n < 2 || n > 4 || length[0] != 2) {
+                returnCode = -1;
+                break;
+            }
+            const char * boundType = token[0];
+            bool needsValue = !(isWord(boundType, 2, "FR") ||
+                                isWord(boundType, 2, "MI") ||
+                                isWord(boundType, 2, "PL") ||
+                                isWord(boundType, 2, "BV"));
+            // type [set] column [value] - FR, MI, PL and BV may have value
+            int which = (n >= 3 + (needsValue ? 1 : 0)) ? 2 : 1;
+            iColumn = columnHash.find(token[which], length[which]);
+            if (iColumn < 0 && !needsValue && which == 2) {
+                which = 1;
+                iColumn = columnHash.find(token[1], length[1]);
+            }
+            double value = 0.0;
+            if (iColumn < 0 || (needsValue && (which + 1 >= n ||
+                                               !getValue(token[which+1], length[which+1], value)))) {
+                returnCode = -1;
+                break;
+            }
+            boundSet[iColumn] = 1;
+            if (isWord(boundType, 2, "UP")) {
+                columnUpper_[iColumn] = value;
+                if (value < 0.0 && columnLower_[iColumn] == 0.0)
+                    columnLower_[iColumn] = -COIN_DBL_MAX;
+            } else if (isWord(boundType, 2, "LO")) {
+                columnLower_[iColumn] = value;
+            } else if (isWord(boundType, 2, "FX")) {
+                columnLower_[iColumn] = value;
+                columnUpper_[iColumn] = value;
+            } else if (isWord(boundType, 2, "FR")) {
+                columnLower_[iColumn] = -COIN_DBL_MAX;
+                columnUpper_[iColumn] = COIN_DBL_MAX;
+            } else if (isWord(boundType, 2, "MI")) {
+                columnLower_[iColumn] = -COIN_DBL_MAX;
+            } else if (isWord(boundType, 2, "PL")) {
+                columnUpper_[iColumn] = COIN_DBL_MAX;
+            } else if (isWord(boundType, 2, "BV")) {
+                integerType_[iColumn] = 1;
+                columnLower_[iColumn] = 0.0;
+                columnUpper_[iColumn] = 1.0;
+            } else if (isWord(boundType, 2, "LI")) {
+                integerType_[iColumn] = 1;
+                columnLower_[iColumn] = value;
+            } else if (isWord(boundType, 2, "UI")) {
+                integerType_[iColumn] = 1;
+                columnUpper_[iColumn] = value;
+                if (value < 0.0 && columnLower_[iColumn] == 0.0)
+                    columnLower_[iColumn] = -COIN_DBL_MAX;
+            } else {
+                // SC etc
+                returnCode = -1;
+                break;
+            }
+        }
+    }
+    if (!returnCode) {
+        // Integers in markers with no bounds are 0-1 (as CoinMpsIO)
+        numberIntegers_ = 0;
+        for (iColumn = 0; iColumn < numberColumns; iColumn++) {
+            if (integerType_[iColumn]) {
+                numberIntegers_++;
+                if (!boundSet[iColumn])
+                    columnUpper_[iColumn] = 1.0;
+            }
+        }
+        rowLower_ = new double [numberRows_];
+        rowUpper_ = new double [numberRows_];
+        for (int iRow = 0; iRow < numberRows_; iRow++) {
+            double value = rhs[iRow];
+            double rangeValue = range[iRow];
+            switch (rowType[iRow]) {
+            case 'E':
+                if (!hasRange[iRow]) {
+                    rowLower_[iRow] = value;
+                    rowUpper_[iRow] = value;
+                } else if (rangeValue >= 0.0) {
+                    rowLower_[iRow] = value;
+                    rowUpper_[iRow] = value + rangeValue;
+                } else {
+                    rowLower_[iRow] = value + rangeValue;
+                    rowUpper_[iRow] = value;
+                }
+                break;
+            case 'L':
+                rowLower_[iRow] = hasRange[iRow] ?
+                                  value - fabs(rangeValue) : -COIN_DBL_MAX;
+                rowUpper_[iRow] = value;
+                break;
+            default:
+                rowLower_[iRow] = value;
+                rowUpper_[iRow] = hasRange[iRow] ?
+                                  value + fabs(rangeValue) : COIN_DBL_MAX;
+                break;
+            }
+        }
+        if (keepNames) {
+            rowNames_.reserve(numberRows_);
+            for (int iRow = 0; iRow < numberRows_; iRow++)
+                rowNames_.push_back(std::string(rowName[iRow], rowNameLength[iRow]));
+            columnNames_.reserve(numberColumns);
+            for (iColumn = 0; iColumn < numberColumns; iColumn++)
+                columnNames_.push_back(std::string(columnName[iColumn],
+                                                   columnNameLength[iColumn]));
+        }
+    }
+    delete [] rhs;
+    delete [] range;
+    delete [] hasRange;
+    delete [] boundSet;
+    return returnCode;
+}
+
+// Give problem to solver
+void
+CbcMpsImport::assignProblem(OsiSolverInterface * solver)
+{
+    CoinPackedMatrix * matrix = new CoinPackedMatrix();
+    int * length = NULL;
+    matrix->assignMatrix(true, numberRows_, numberColumns_, numberElements_,
+                         element_, row_, columnStart_, length);
+    solver->assignProblem(matrix, columnLower_, columnUpper_, objective_,
+                          rowLower_, rowUpper_);
+    // all NULL now
+    assert (!element_ && !row_ && !columnStart_ && !columnLower_);
+    for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+        if (integerType_[iColumn])
+            solver->setInteger(iColumn);
+    }
+    delete [] integerType_;
+    integerType_ = NULL;
+    solver->setDblParam(OsiObjOffset, objectiveOffset_);
+    solver->setStrParam(OsiProbName, problemName_);
+}
+
@@ -0,0 +1,133 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcMpsImport_H
+#define CbcMpsImport_H
+
+#include <string>
+#include <vector>
+#include "CoinTypes.hpp"
+
+class OsiSolverInterface;
+
+/** Fast reader for large MPS files.
+
+    The file is memory mapped (compressed files are decompressed as a
+    stream into memory) and the COLUMNS section - normally nearly all
+    of the file - is split into chunks which are parsed in parallel
+    (if CBC_THREAD).  The column ordered matrix is built directly from
+    the chunks.
+
+    Only plain linear MIPs (ROWS, COLUMNS with integer markers, RHS,
+    RANGES and BOUNDS other than SC) with names without spaces are
+    handled.  For anything else (including a row or the objective
+    twice in a column) readMps returns -1 and the caller should use
+    the normal CoinMpsIO path, which also gives proper error messages.
+    In cbc it is only used if fastMps is 1.
+*/
+
+class CbcMpsImport {
+
+public:
+
+    /// Default Constructor
+    CbcMpsImport ();
+
+    /// Destructor
+    ~CbcMpsImport ();
+
+    /** Read MPS file using up to numberThreads threads.
+        Returns 0 if OK, -1 if file can not be handled here (including
+        errors) */
+    int readMps(const char * fileName, int numberThreads = 1,
+                bool keepNames = true);
+
+    /** Give problem to solver - arrays are handed over so after this
+        only names and sizes are left */
+    void assignProblem(OsiSolverInterface * solver);
+
+    /// Number of rows
+    inline int numberRows() const {
+        return numberRows_;
+    }
+    /// Number of columns
+    inline int numberColumns() const {
+        return numberColumns_;
+    }
+    /// Number of elements
+    inline CoinBigIndex numberElements() const {
+        return numberElements_;
+    }
+    /// Number of integer columns
+    inline int numberIntegers() const {
+        return numberIntegers_;
+    }
+    /// Objective offset (as OsiObjOffset)
+    inline double objectiveOffset() const {
+        return objectiveOffset_;
+    }
+    /// Problem name
+    inline const std::string & problemName() const {
+        return problemName_;
+    }
+    /// Row names (empty if not kept)
+    inline const std::vector<std::string> & rowNames() const {
+        return rowNames_;
+    }
+    /// Column names (empty if not kept)
+    inline const std::vector<std::string> & columnNames() const {
+        return columnNames_;
+    }
+
+private:
+    /// No copy
+    CbcMpsImport ( const CbcMpsImport &);
+    /// No assignment
+    CbcMpsImport & operator=( const CbcMpsImport& rhs);
+
+    void gutsOfDelete();
+    /// Parse buffer
+    int parse(const char * buffer, const char * end, int numberThreads,
+              bool keepNames);
+
+private:
+    /// Column starts
+    CoinBigIndex * columnStart_;
+    /// Row indices
+    int * row_;
+    /// Elements
+    double * element_;
+    /// Column lower bounds
+    double * columnLower_;
+    /// Column upper bounds
+    double * columnUpper_;
+    /// Objective
+    double * objective_;
+    /// Row lower bounds
+    double * rowLower_;
+    /// Row upper bounds
+    double * rowUpper_;
+    /// 1 if integer
+    char * integerType_;
+    /// Objective offset
+    double objectiveOffset_;
+    /// Number of rows
+    int numberRows_;
+    /// Number of columns
+    int numberColumns_;
+    /// Number of elements
+    CoinBigIndex numberElements_;
+    /// Number of integers
+    int numberIntegers_;
+    /// Problem name
+    std::string problemName_;
+    /// Row names
+    std::vector<std::string> rowNames_;
+    /// Column names
+    std::vector<std::string> columnNames_;
+};
+
+#endif
+
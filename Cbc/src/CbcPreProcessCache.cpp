@@ -0,0 +1,257 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#ifndef _MSC_VER
+#include <dirent.h>
+#include <unistd.h>
+#include <utime.h>
+#include <sys/stat.h>
+#else
+#include <process.h>
+#endif
+
+#include "CoinFinite.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "OsiSolverInterface.hpp"
+#include "CbcPreProcessCache.hpp"
+
+namespace {
+
+// Two independent 32 bit hashes so collisions are very unlikely
+class CbcFingerprint {
+public:
+    CbcFingerprint() : hash1_(2166136261u), hash2_(5381u) {}
+    void add(const void * data, size_t size) {
+        const unsigned char * bytes = static_cast<const unsigned char *> (data);
+        unsigned int hash1 = hash1_;
+        unsigned int hash2 = hash2_;
+        for (size_t i = 0; i < size; i++) {
+            // FNV-1a
+            hash1 ^= bytes[i];
+            hash1 *= 16777619u;
+            // djb2
+            hash2 = hash2 * 33u + bytes[i];
+        }
+        hash1_ = hash1;
+        hash2_ = hash2;
+    }
+    template <class T> inline void addArray(const T * array, int n) {
+        if (n)
+            add(array, n * sizeof(T));
+    }
+    std::string key() const {
+        char buffer[20];
+        sprintf(buffer, "%8.8x%8.8x", hash1_, hash2_);
+        return std::string(buffer);
+    }
+private:
+    unsigned int hash1_;
+    unsigned int hash2_;
+};
+
+#ifndef _MSC_VER
+// One cache file
+struct CbcCacheEntry {
+    std::string name;
+    time_t used;
+    double size;
+    bool operator<(const CbcCacheEntry & rhs) const {
+        return used < rhs.used;
+    }
+};
+#endif
+}
+
+// Default Constructor
+CbcPreProcessCache::CbcPreProcessCache ()
+    : directory_(""),
+      maximumSize_(1024.0*1024.0*1024.0)
+{
+}
+
+// Copy constructor
+CbcPreProcessCache::CbcPreProcessCache (const CbcPreProcessCache & rhs)
+    : directory_(rhs.directory_),
+      maximumSize_(rhs.maximumSize_)
+{
+}
+
+// Assignment operator
+CbcPreProcessCache &
+CbcPreProcessCache::operator=( const CbcPreProcessCache & rhs)
+{
+    if (this != &rhs) {
+        directory_ = rhs.directory_;
+        maximumSize_ = rhs.maximumSize_;
+    }
+    return *this;
+}
+
+// Destructor
+CbcPreProcessCache::~CbcPreProcessCache ()
+{
+}
+
+// Fingerprint of model
+std::string
+CbcPreProcessCache::fingerprint(const OsiSolverInterface * solver,
+                                int options1, int options2)
+{
+    CbcFingerprint hash;
+    int numberRows = solver->getNumRows();
+    int numberColumns = solver->getNumCols();
+    int sizes[4];
+    sizes[0] = numberRows;
+    sizes[1] = numberColumns;
+    sizes[2] = options1;
+    sizes[3] = options2;
+    hash.addArray(sizes, 4);
+    double sense = solver->getObjSense();
+    hash.add(&sense, sizeof(double));
+    // matrix may have gaps so do column by column
+    const CoinPackedMatrix * matrix = solver->getMatrixByCol();
+    const CoinBigIndex * columnStart = matrix->getVectorStarts();
+    const int * columnLength = matrix->getVectorLengths();
+    const int * row = matrix->getIndices();
+    const double * element = matrix->getElements();
+    char * integer = new char [numberColumns];
+    for (int i = 0; i < numberColumns; i++) {
+        CoinBigIndex start = columnStart[i];
+        int length = columnLength[i];
+        hash.add(&length, sizeof(int));
+        hash.addArray(row + start, length);
+        hash.addArray(element + start, length);
+        integer[i] = solver->isInteger(i) ? 1 : 0;
+    }
+    hash.addArray(integer, numberColumns);
+    delete [] integer;
+    hash.addArray(solver->getColLower(), numberColumns);
+    hash.addArray(solver->getColUpper(), numberColumns);
+    hash.addArray(solver->getObjCoefficients(), numberColumns);
+    hash.addArray(solver->getRowLower(), numberRows);
+    hash.addArray(solver->getRowUpper(), numberRows);
+    return hash.key();
+}
+
+// Name of cache file for key
+std::string
+CbcPreProcessCache::fileName(const std::string & key) const
+{
+    std::string name = directory_;
+    char last = name.size() ? name[name.size()-1] : ' ';
+    if (last != '/' && last != '\\')
+        name += CoinFindDirSeparator();
+    return name + key + ".snap";
+}
+
+// Name of cache file if in cache
+std::string
+CbcPreProcessCache::lookup(const std::string & key) const
+{
+    if (!active())
+        return std::string();
+    std::string name = fileName(key);
+    FILE * fp = fopen(name.c_str(), "rb");
+    if (!fp)
+        return std::string();
+    fclose(fp);
+#ifndef _MSC_VER
+    // mark as recently used
+    utime(name.c_str(), NULL);
+#endif
+    return name;
+}
+
+// Name of temporary file to write new entry on
+std::string
+CbcPreProcessCache::temporaryName(const std::string & key) const
+{
+#ifndef _MSC_VER
+    // mkstemp creates the file so two threads or processes never share it
+    std::string name = fileName(key) + ".XXXXXX";
+    std::vector<char> buffer(name.begin(), name.end());
+    buffer.push_back('\0');
+    int fd = mkstemp(&buffer[0]);
+    if (fd < 0)
+        return std::string();
+    close(fd);
+    return std::string(&buffer[0]);
+#else
+    char extra[40];
+    static int counter = 0;
+    sprintf(extra, ".%d.%d.tmp", static_cast<int> (_getpid()), counter++);
+    return fileName(key) + extra;
+#endif
+}
+
+// Move temporary file into cache
+int
+CbcPreProcessCache::store(const std::string & key,
+                          const std::string & temporary) const
+{
+    std::string name = fileName(key);
+    // rename is atomic so readers never see part of a file
+    remove(name.c_str());
+    if (rename(temporary.c_str(), name.c_str())) {
+        remove(temporary.c_str());
+        return 1;
+    }
+    evict();
+    return 0;
+}
+
+// Delete least recently used entries
+int
+CbcPreProcessCache::evict() const
+{
+    int numberDeleted = 0;
+#ifndef _MSC_VER
+    DIR * dir = opendir(directory_.c_str());
+    if (!dir)
+        return 0;
+    std::vector<CbcCacheEntry> entries;
+    double totalSize = 0.0;
+    struct dirent * entry;
+    while ((entry = readdir(dir)) != NULL) {
+        const char * name = entry->d_name;
+        size_t length = strlen(name);
+        if (length < 6 || strcmp(name + length - 5, ".snap"))
+            continue;
+        CbcCacheEntry cacheEntry;
+        cacheEntry.name = fileName(std::string(name, length - 5));
+        struct stat statBuffer;
+        if (stat(cacheEntry.name.c_str(), &statBuffer))
+            continue;
+        cacheEntry.used = statBuffer.st_mtime;
+        cacheEntry.size = static_cast<double> (statBuffer.st_size);
+        totalSize += cacheEntry.size;
+        entries.push_back(cacheEntry);
+    }
+    closedir(dir);
+    if (totalSize > maximumSize_) {
+        std::sort(entries.begin(), entries.end());
+        // keep newest even if too big on its own
+        for (size_t i = 0; i + 1 < entries.size() && totalSize > maximumSize_; i++) {
+            if (!remove(entries[i].name.c_str())) {
+                totalSize -= entries[i].size;
+                numberDeleted++;
+            }
+        }
+    }
+#endif
+    return numberDeleted;
+}
+
@@ -0,0 +1,91 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcPreProcessCache_H
+#define CbcPreProcessCache_H
+
+#include <string>
+
+class OsiSolverInterface;
+
+/** On disk cache of preprocessed models.
+
+    Entries are CbcSnapshot files named by a fingerprint of the model
+    before preprocessing (matrix, bounds, objective and integrality plus
+    preprocessing options), so a model which has been seen before can
+    skip CglPreProcess.  Using an entry updates its modification time
+    and when the directory goes over the maximum size the least recently
+    used entries are deleted.
+
+    The driver switches the cache on with parameter cacheDirectory and
+    cacheMB gives the maximum size in megabytes (default 1024).
+*/
+
+class CbcPreProcessCache {
+
+public:
+
+    /// Default Constructor
+    CbcPreProcessCache ();
+
+    /// Copy constructor
+    CbcPreProcessCache ( const CbcPreProcessCache &);
+
+    /// Assignment operator
+    CbcPreProcessCache & operator=( const CbcPreProcessCache& rhs);
+
+    /// Destructor
+    ~CbcPreProcessCache ();
+
+
+    /// Set directory ("" switches off)
+    inline void setDirectory(const std::string & value) {
+        directory_ = value;
+    }
+    /// Directory
+    inline const std::string & directory() const {
+        return directory_;
+    }
+    /// Set maximum size of cache in bytes
+    inline void setMaximumSize(double value) {
+        maximumSize_ = value;
+    }
+    /// Maximum size of cache in bytes
+    inline double maximumSize() const {
+        return maximumSize_;
+    }
+    /// True if cache switched on
+    inline bool active() const {
+        return directory_ != "";
+    }
+
+    /** Fingerprint of model as 16 hex characters.
+        options should be anything which changes preprocessing */
+    static std::string fingerprint(const OsiSolverInterface * solver,
+                                   int options1, int options2);
+
+    /// Name of cache file for key
+    std::string fileName(const std::string & key) const;
+    /// Name of cache file if in cache (marked as used) else ""
+    std::string lookup(const std::string & key) const;
+    /** Name of new temporary file to write new entry on ("" if it can
+        not be created).  Unique for each call. */
+    std::string temporaryName(const std::string & key) const;
+    /** Move temporary file (from temporaryName) into cache and evict
+        least recently used entries.  Returns 0 if OK */
+    int store(const std::string & key, const std::string & temporary) const;
+    /** Delete least recently used entries until under maximum size.
+        Returns number deleted */
+    int evict() const;
+
+private:
+    /// Directory
+    std::string directory_;
+    /// Maximum size in bytes
+    double maximumSize_;
+};
+
+#endif
+
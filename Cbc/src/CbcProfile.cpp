@@ -0,0 +1,75 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include "CbcProfile.hpp"
+#include "CbcTrace.hpp"
+
+// Default Constructor
+CbcProfile::CbcProfile ()
+    : trace_(NULL),
+      traceThread_(0)
+{
+    clear();
+}
+
+// Zero all times and counts (trace kept)
+void
+CbcProfile::clear()
+{
+    for (int i = 0; i < numberPhases; i++) {
+        seconds_[i] = 0.0;
+        count_[i] = 0;
+    }
+    startTime_ = 0.0;
+    current_ = -1;
+}
+
+// Add in another profile
+void
+CbcProfile::add(const CbcProfile & rhs)
+{
+    for (int i = 0; i < numberPhases; i++) {
+        seconds_[i] += rhs.seconds_[i];
+        count_[i] += rhs.count_[i];
+    }
+}
+
+// Sum of seconds in all phases
+double
+CbcProfile::totalSeconds() const
+{
+    double total = 0.0;
+    for (int i = 0; i < numberPhases; i++)
+        total += seconds_[i];
+    return total;
+}
+
+// Name of phase
+const char *
+CbcProfile::name(int phase)
+{
+    static const char * names[] = {
+        "node LP", "strong branching", "cut separation", "heuristics",
+        "node selection", "tree bookkeeping", "propagation", "thread wait"
+    };
+    if (phase >= 0 && phase < numberPhases)
+        return names[phase];
+    else
+        return "unknown";
+}
+
+// Write span to trace
+void
+CbcProfile::traceSpan(const char * name, double start, double end) const
+{
+    if (trace_)
+        trace_->span(traceThread_, name, start, end);
+}
+
@@ -0,0 +1,181 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcProfile_H
+#define CbcProfile_H
+
+#include "CoinTime.hpp"
+
+class CbcTrace;
+
+/** Time and number of times for each phase of branch and bound.
+
+    Times are wall clock and exclusive - when a phase starts inside
+    another (e.g. a resolve while generating cuts) the outer phase is
+    paused, so the times add up to at most the time in branchAndBound.
+    Each CbcModel has one, only used by the thread running that model.
+    Thread models are added into the base model at the end of the search.
+    If a CbcTrace is set then each timed phase is also written as a span.
+*/
+
+class CbcProfile {
+
+public:
+
+    /// Phases
+    enum Phase {
+        /// LP resolves (CbcModel::resolve)
+        nodeLp = 0,
+        /// Choosing branch including strong branching
+        strongBranching,
+        /// Cut generation
+        cutSeparation,
+        /// Heuristics
+        heuristics,
+        /// Getting next node from tree
+        nodeSelection,
+        /// Restoring node (addCuts including walkback)
+        treeBookkeeping,
+        /// Reduced cost fixing
+        propagation,
+        /// Waiting for threads (or locks)
+        threadWait,
+        numberPhases
+    };
+
+    /// Default Constructor
+    CbcProfile ();
+
+    /// Zero all times and counts
+    void clear();
+
+    /// Add in another profile (e.g. from a thread)
+    void add(const CbcProfile & rhs);
+
+    /// Add time directly
+    inline void addTime(Phase phase, double seconds, int count = 1) {
+        seconds_[phase] += seconds;
+        count_[phase] += count;
+    }
+
+    /// Seconds in phase
+    inline double seconds(int phase) const {
+        return seconds_[phase];
+    }
+    /// Number of times phase entered
+    inline int count(int phase) const {
+        return count_[phase];
+    }
+    /// Sum of seconds in all phases
+    double totalSeconds() const;
+    /// Name of phase
+    static const char * name(int phase);
+    /// Time current phase (re)started
+    inline double startTime() const {
+        return startTime_;
+    }
+
+    /// Set trace (not owned) and thread number for spans (0 main)
+    inline void setTrace(CbcTrace * trace, int thread) {
+        trace_ = trace;
+        traceThread_ = thread;
+    }
+    /// Trace (NULL if none)
+    inline CbcTrace * trace() const {
+        return trace_;
+    }
+    /// Thread number for spans
+    inline int traceThread() const {
+        return traceThread_;
+    }
+    /// Write span to trace
+    void traceSpan(const char * name, double start, double end) const;
+
+    /// Start phase - returns phase which was running (or -1)
+    inline int enter(Phase phase) {
+        double now = CoinGetTimeOfDay();
+        int previous = current_;
+        if (previous >= 0)
+            seconds_[previous] += now - startTime_;
+        current_ = phase;
+        startTime_ = now;
+        return previous;
+    }
+    /// End phase and go back to previous one
+    inline void leave(Phase phase, int previous) {
+        double now = CoinGetTimeOfDay();
+        seconds_[phase] += now - startTime_;
+        count_[phase]++;
+        current_ = previous;
+        startTime_ = now;
+    }
+
+private:
+    /// Seconds in each phase
+    double seconds_[numberPhases];
+    /// Times each phase entered
+    int count_[numberPhases];
+    /// Time current phase (re)started
+    double startTime_;
+    /// Current phase (-1 none)
+    int current_;
+    /// Trace for spans
+    CbcTrace * trace_;
+    /// Thread number for spans
+    int traceThread_;
+};
+
+/// Times a phase for as long as it is in scope
+class CbcProfileTimer {
+
+public:
+
+    CbcProfileTimer (CbcProfile & profile, CbcProfile::Phase phase)
+        : profile_(profile),
+          phase_(phase) {
+        previous_ = profile_.enter(phase);
+        start_ = profile_.startTime();
+    }
+    ~CbcProfileTimer () {
+        profile_.leave(phase_, previous_);
+        if (profile_.trace())
+            profile_.traceSpan(CbcProfile::name(phase_), start_,
+                               profile_.startTime());
+    }
+
+private:
+    CbcProfileTimer (const CbcProfileTimer &);
+    CbcProfileTimer & operator=(const CbcProfileTimer &);
+    CbcProfile & profile_;
+    CbcProfile::Phase phase_;
+    int previous_;
+    double start_;
+};
+
+/// Traces a span (e.g. a node) for as long as it is in scope
+class CbcTraceSpan {
+
+public:
+
+    CbcTraceSpan (const CbcProfile & profile, const char * name)
+        : profile_(profile),
+          name_(name),
+          start_(profile.trace() ? CoinGetTimeOfDay() : 0.0) {
+    }
+    ~CbcTraceSpan () {
+        if (profile_.trace())
+            profile_.traceSpan(name_, start_, CoinGetTimeOfDay());
+    }
+
+private:
+    CbcTraceSpan (const CbcTraceSpan &);
+    CbcTraceSpan & operator=(const CbcTraceSpan &);
+    const CbcProfile & profile_;
+    const char * name_;
+    double start_;
+};
+
+#endif
+
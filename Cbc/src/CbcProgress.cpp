@@ -0,0 +1,200 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include <cmath>
+#include <cstring>
+
+#include "CoinTime.hpp"
+#include "CbcModel.hpp"
+#include "CbcProgress.hpp"
+#include "CbcMemory.hpp"
+
+// Values at least this large mean none
+#define CBC_PROGRESS_INFINITY 1.0e50
+
+// Default Constructor
+CbcProgress::CbcProgress ()
+    : fp_(NULL),
+      format_(csv),
+      interval_(1.0),
+      startTime_(0.0),
+      lastTime_(0.0),
+      nextTime_(0.0),
+      incumbent_(COIN_DBL_MAX),
+      bound_(-COIN_DBL_MAX),
+      referenceObjective_(0.0),
+      primalIntegral_(0.0),
+      dualIntegral_(0.0),
+      lastRowTime_(0.0),
+      lastRowNodes_(0),
+      numberRows_(0),
+      haveReference_(false)
+{
+}
+
+// Destructor
+CbcProgress::~CbcProgress ()
+{
+    close();
+}
+
+// Open file - format from name
+int
+CbcProgress::open(const char * fileName)
+{
+    size_t length = strlen(fileName);
+    Format format = jsonLines;
+    if (length > 4 && !strcmp(fileName + length - 4, ".csv"))
+        format = csv;
+    return open(fileName, format);
+}
+
+// Open file with given format
+int
+CbcProgress::open(const char * fileName, Format format)
+{
+    close();
+    fp_ = fopen(fileName, "w");
+    if (!fp_)
+        return 1;
+    format_ = format;
+    startTime_ = CoinGetTimeOfDay();
+    lastTime_ = startTime_;
+    nextTime_ = startTime_;
+    lastRowTime_ = startTime_;
+    lastRowNodes_ = 0;
+    incumbent_ = COIN_DBL_MAX;
+    bound_ = -COIN_DBL_MAX;
+    primalIntegral_ = 0.0;
+    dualIntegral_ = 0.0;
+    numberRows_ = 0;
+    if (format_ == csv)
+        fprintf(fp_, "seconds,bound,incumbent,gap,nodes,open_nodes,nodes_per_second,"
+                "iterations,memory_mb,primal_integral,dual_integral\n");
+    return 0;
+}
+
+// Close file
+void
+CbcProgress::close()
+{
+    if (fp_) {
+        fclose(fp_);
+        fp_ = NULL;
+    }
+}
+
+// Elapsed seconds
+double
+CbcProgress::seconds() const
+{
+    return CoinGetTimeOfDay() - startTime_;
+}
+
+// Relative gap as used for integrals
+double
+CbcProgress::gap(double value, double reference)
+{
+    if (fabs(value) >= CBC_PROGRESS_INFINITY ||
+            fabs(reference) >= CBC_PROGRESS_INFINITY)
+        return 1.0;
+    if (value * reference < 0.0)
+        return 1.0;
+    double largest = CoinMax(fabs(value), fabs(reference));
+    if (largest < 1.0e-10)
+        return 0.0;
+    return CoinMin(fabs(value - reference) / largest, 1.0);
+}
+
+// Memory in use by process
+double
+CbcProgress::memoryInUse()
+{
+    return CbcMemory::residentBytes() / (1024.0 * 1024.0);
+}
+
+// Add to integrals up to now
+void
+CbcProgress::integrate(double now)
+{
+    double elapsed = now - lastTime_;
+    if (elapsed > 0.0) {
+        double primalReference = haveReference_ ? referenceObjective_ : bound_;
+        double dualReference = haveReference_ ? referenceObjective_ : incumbent_;
+        primalIntegral_ += elapsed * gap(incumbent_, primalReference);
+        dualIntegral_ += elapsed * gap(bound_, dualReference);
+    }
+    lastTime_ = now;
+}
+
+// Update integrals with current incumbent
+bool
+CbcProgress::update(double incumbent)
+{
+    if (!fp_)
+        return false;
+    double now = CoinGetTimeOfDay();
+    if (incumbent != incumbent_) {
+        integrate(now);
+        incumbent_ = incumbent;
+    }
+    return now >= nextTime_;
+}
+
+// Write row
+void
+CbcProgress::sample(const CbcModel * model, double incumbent, double bound,
+                    int numberOpenNodes)
+{
+    if (!fp_)
+        return;
+    double now = CoinGetTimeOfDay();
+    integrate(now);
+    incumbent_ = incumbent;
+    bound_ = CoinMin(bound, incumbent_);
+    int numberNodes = model->getNodeCount();
+    if (numberNodes < lastRowNodes_)
+        lastRowNodes_ = 0; // new search
+    double rate = 0.0;
+    if (now > lastRowTime_)
+        rate = (numberNodes - lastRowNodes_) / (now - lastRowTime_);
+    lastRowTime_ = now;
+    lastRowNodes_ = numberNodes;
+    double gapNow = gap(incumbent_, bound_);
+    char bestBound[40];
+    char best[40];
+    const char * none = (format_ == csv) ? "" : "null";
+    if (fabs(bound_) < CBC_PROGRESS_INFINITY)
+        sprintf(bestBound, "%.12g", bound_);
+    else
+        strcpy(bestBound, none);
+    if (fabs(incumbent_) < CBC_PROGRESS_INFINITY)
+        sprintf(best, "%.12g", incumbent_);
+    else
+        strcpy(best, none);
+    if (format_ == csv)
+        fprintf(fp_, "%.3f,%s,%s,%.6g,%d,%d,%.1f,%d,%.1f,%.6g,%.6g\n",
+                now - startTime_, bestBound, best, gapNow, numberNodes,
+                numberOpenNodes, rate, model->getIterationCount(),
+                memoryInUse(), primalIntegral_, dualIntegral_);
+    else
+        fprintf(fp_, "{\"seconds\":%.3f,\"bound\":%s,\"incumbent\":%s,\"gap\":%.6g,"
+                "\"nodes\":%d,\"open_nodes\":%d,\"nodes_per_second\":%.1f,"
+                "\"iterations\":%d,\"memory_mb\":%.1f,"
+                "\"primal_integral\":%.6g,\"dual_integral\":%.6g}\n",
+                now - startTime_, bestBound, best, gapNow, numberNodes,
+                numberOpenNodes, rate, model->getIterationCount(),
+                memoryInUse(), primalIntegral_, dualIntegral_);
+    fflush(fp_);
+    numberRows_++;
+    while (nextTime_ <= now)
+        nextTime_ += CoinMax(interval_, 1.0e-3);
+}
+
@@ -0,0 +1,141 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcProgress_H
+#define CbcProgress_H
+
+#include <cstdio>
+
+class CbcModel;
+
+/** Machine readable progress of branch and bound.
+
+    Writes a row every interval seconds (and at the end of each search)
+    as CSV or JSON lines with elapsed wall clock seconds, best bound,
+    incumbent, gap, nodes, open nodes, nodes per second, LP iterations,
+    memory in use and primal and dual integrals.  Objective values are
+    as in the node log (minimization).
+
+    The integrals are updated every node (piecewise constant between
+    changes) using gap(a,b) = |a-b|/max(|a|,|b|), which is 1 if there
+    is no incumbent or a and b have different signs.  The primal
+    integral is of gap(incumbent, reference) and the dual integral of
+    gap(bound, reference).  If no reference objective is set the
+    primal integral is measured against the bound and the dual against
+    the incumbent - so both are the primal-dual integral.
+
+    Set on model with CbcModel::setProgress - it is not copied to
+    sub-models or threads.
+*/
+
+class CbcProgress {
+
+public:
+
+    /// Formats
+    enum Format {
+        csv = 0,
+        jsonLines
+    };
+
+    /// Default Constructor
+    CbcProgress ();
+
+    /// Destructor (closes file)
+    ~CbcProgress ();
+
+    /** Open file - format from name if .csv else JSON lines.
+        Time and integrals start now.  Returns 0 if ok */
+    int open(const char * fileName);
+    /// Open file with given format
+    int open(const char * fileName, Format format);
+    /// Close file
+    void close();
+    /// True if file open
+    inline bool isOpen() const {
+        return fp_ != NULL;
+    }
+
+    /// Seconds between rows
+    inline double interval() const {
+        return interval_;
+    }
+    /// Set seconds between rows
+    inline void setInterval(double value) {
+        interval_ = value;
+    }
+    /// Set reference (e.g. known optimal) objective for integrals
+    inline void setReferenceObjective(double value) {
+        referenceObjective_ = value;
+        haveReference_ = true;
+    }
+
+    /** Update integrals with current incumbent -
+        returns true if a row is due */
+    bool update(double incumbent);
+    /// Write row with current incumbent and bound (and update integrals)
+    void sample(const CbcModel * model, double incumbent, double bound,
+                int numberOpenNodes);
+
+    /// Elapsed seconds
+    double seconds() const;
+    /// Primal integral so far
+    inline double primalIntegral() const {
+        return primalIntegral_;
+    }
+    /// Dual integral so far
+    inline double dualIntegral() const {
+        return dualIntegral_;
+    }
+    /// Number of rows written
+    inline int numberRows() const {
+        return numberRows_;
+    }
+
+    /// Relative gap as used for integrals
+    static double gap(double value, double reference);
+    /// Memory in use by process (megabytes - 0.0 if not known)
+    static double memoryInUse();
+
+private:
+    /// Illegal
+    CbcProgress (const CbcProgress &);
+    CbcProgress & operator=(const CbcProgress &);
+    /// Add to integrals up to now
+    void integrate(double now);
+
+    /// File
+    FILE * fp_;
+    /// Format
+    Format format_;
+    /// Seconds between rows
+    double interval_;
+    /// Wall clock when opened
+    double startTime_;
+    /// Wall clock of last update
+    double lastTime_;
+    /// Wall clock when next row due
+    double nextTime_;
+    /// Incumbent at last update
+    double incumbent_;
+    /// Bound at last sample
+    double bound_;
+    /// Reference objective
+    double referenceObjective_;
+    /// Primal integral
+    double primalIntegral_;
+    /// Dual integral
+    double dualIntegral_;
+    /// Wall clock and nodes at last row (for rate)
+    double lastRowTime_;
+    int lastRowNodes_;
+    /// Number of rows written
+    int numberRows_;
+    /// True if reference set
+    bool haveReference_;
+};
+
+#endif
+
@@ -0,0 +1,788 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "OsiSolverInterface.hpp"
+#include "OsiCuts.hpp"
+#include "OsiRowCut.hpp"
+#include "CbcModel.hpp"
+#include "CbcSimpleInteger.hpp"
+#include "CbcCountRowCut.hpp"
+#include "CbcSnapshot.hpp"
+
+namespace {
+
+const char snapshotMagic[8] = {'C', 'b', 'c', 'S', 'n', 'a', 'p', '\0'};
+const int snapshotVersion = 2;
+const int snapshotCheck = 0x01020304;
+
+// What is at start of file
+struct CbcSnapshotHeader {
+    char magic[8];
+    double objectiveOffset;
+    double objectiveSense;
+    double originalObjectiveOffset;
+    int version;
+    // to catch files from machines with other byte order
+    int check;
+    int sizeofBigIndex;
+    int numberRows;
+    int numberColumns;
+    int numberOriginalColumns;
+    int numberCuts;
+    int lengthNames;
+    // -1 if original model not saved
+    int numberOriginalRows;
+    int spare;
+    CoinBigIndex numberElements;
+    CoinBigIndex numberCutElements;
+    CoinBigIndex numberOriginalElements;
+};
+
+inline size_t align8(size_t size)
+{
+    return (size + 7) & ~static_cast<size_t> (7);
+}
+
+// Pointer to next section in buffer (and step over it) - NULL if past size
+template <class T> inline const T *
+nextSection(const char * buffer, size_t & position, size_t count, size_t size)
+{
+    if (position > size || count > (size - position) / sizeof(T))
+        return NULL;
+    const T * array = reinterpret_cast<const T *> (buffer + position);
+    position += align8(count * sizeof(T));
+    return array;
+}
+
+// True if starts go from 0 to numberElements and indices are in range
+bool validMatrix(const CoinBigIndex * start, int numberMajor,
+                 CoinBigIndex numberElements, const int * index,
+                 int numberMinor)
+{
+    if (start[0] || start[numberMajor] != numberElements)
+        return false;
+    for (int i = 0; i < numberMajor; i++) {
+        if (start[i+1] < start[i])
+            return false;
+    }
+    for (CoinBigIndex j = 0; j < numberElements; j++) {
+        if (index[j] < 0 || index[j] >= numberMinor)
+            return false;
+    }
+    return true;
+}
+
+// Write section padded to 8 bytes
+template <class T> inline bool
+writeSection(FILE * fp, const T * array, size_t count)
+{
+    static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    size_t size = count * sizeof(T);
+    if (size && fwrite(array, 1, size, fp) != size)
+        return false;
+    size_t pad = align8(size) - size;
+    return !pad || fwrite(zeros, 1, pad, fp) == pad;
+}
+}
+
+// Default Constructor
+CbcSnapshot::CbcSnapshot ()
+    : buffer_(NULL),
+      size_(0),
+      mapped_(false),
+      columnStart_(NULL),
+      row_(NULL),
+      element_(NULL),
+      columnLower_(NULL),
+      columnUpper_(NULL),
+      objective_(NULL),
+      rowLower_(NULL),
+      rowUpper_(NULL),
+      integerType_(NULL),
+      priority_(NULL),
+      originalColumns_(NULL),
+      cutStart_(NULL),
+      cutIndex_(NULL),
+      cutElement_(NULL),
+      cutLower_(NULL),
+      cutUpper_(NULL),
+      originalStart_(NULL),
+      originalRow_(NULL),
+      originalElement_(NULL),
+      originalColumnLower_(NULL),
+      originalColumnUpper_(NULL),
+      originalObjective_(NULL),
+      originalRowLower_(NULL),
+      originalRowUpper_(NULL),
+      originalIntegerType_(NULL),
+      names_(NULL)
+{
+}
+
+// Destructor
+CbcSnapshot::~CbcSnapshot ()
+{
+    clear();
+}
+
+// Free any mapped file
+void
+CbcSnapshot::clear()
+{
+    if (buffer_) {
+#ifndef _MSC_VER
+        if (mapped_)
+            munmap(buffer_, size_);
+        else
+#endif
+            delete [] reinterpret_cast<double *> (buffer_);
+    }
+    buffer_ = NULL;
+    size_ = 0;
+    mapped_ = false;
+    columnStart_ = NULL;
+    row_ = NULL;
+    element_ = NULL;
+    columnLower_ = NULL;
+    columnUpper_ = NULL;
+    objective_ = NULL;
+    rowLower_ = NULL;
+    rowUpper_ = NULL;
+    integerType_ = NULL;
+    priority_ = NULL;
+    originalColumns_ = NULL;
+    cutStart_ = NULL;
+    cutIndex_ = NULL;
+    cutElement_ = NULL;
+    cutLower_ = NULL;
+    cutUpper_ = NULL;
+    originalStart_ = NULL;
+    originalRow_ = NULL;
+    originalElement_ = NULL;
+    originalColumnLower_ = NULL;
+    originalColumnUpper_ = NULL;
+    originalObjective_ = NULL;
+    originalRowLower_ = NULL;
+    originalRowUpper_ = NULL;
+    originalIntegerType_ = NULL;
+    names_ = NULL;
+}
+
+// Write snapshot
+int
+CbcSnapshot::write(const char * fileName, const OsiSolverInterface * solver,
+                   const CbcModel * model, int numberOriginalColumns,
+                   const OsiCuts * cuts,
+                   const std::vector<std::string> * originalNames,
+                   const OsiSolverInterface * original)
+{
+    int numberRows = solver->getNumRows();
+    int numberColumns = solver->getNumCols();
+    // make sure no gaps
+    CoinPackedMatrix matrix(*solver->getMatrixByCol());
+    matrix.removeGaps();
+    CbcSnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, snapshotMagic, 8);
+    header.objectiveOffset = 0.0;
+    solver->getDblParam(OsiObjOffset, header.objectiveOffset);
+    header.objectiveSense = solver->getObjSense();
+    header.version = snapshotVersion;
+    header.check = snapshotCheck;
+    header.sizeofBigIndex = static_cast<int> (sizeof(CoinBigIndex));
+    header.numberRows = numberRows;
+    header.numberColumns = numberColumns;
+    header.numberOriginalColumns = numberOriginalColumns;
+    header.numberElements = matrix.getNumElements();
+    // original model so solutions can be mapped back
+    if (original && original->getNumCols() != numberOriginalColumns)
+        original = NULL;
+    CoinPackedMatrix originalMatrix;
+    char * originalIntegerType = NULL;
+    header.numberOriginalRows = -1;
+    if (original) {
+        originalMatrix = *original->getMatrixByCol();
+        originalMatrix.removeGaps();
+        header.numberOriginalRows = original->getNumRows();
+        header.numberOriginalElements = originalMatrix.getNumElements();
+        header.originalObjectiveOffset = 0.0;
+        original->getDblParam(OsiObjOffset, header.originalObjectiveOffset);
+        originalIntegerType = new char [numberOriginalColumns];
+        for (int i = 0; i < numberOriginalColumns; i++)
+            originalIntegerType[i] = original->isInteger(i) ? 1 : 0;
+    }
+    char * integerType = new char [numberColumns];
+    int * priority = new int [numberColumns];
+    int * originalColumns = new int [numberColumns];
+    for (int i = 0; i < numberColumns; i++) {
+        integerType[i] = solver->isInteger(i) ? 1 : 0;
+        priority[i] = 1000;
+    }
+    const int * modelOriginal = model ? model->originalColumns() : NULL;
+    for (int i = 0; i < numberColumns; i++) {
+        int iColumn = modelOriginal ? modelOriginal[i] : i;
+        originalColumns[i] = (iColumn < numberOriginalColumns) ? iColumn : -1;
+    }
+    if (model) {
+        int numberObjects = model->numberObjects();
+        OsiObject ** objects = model->objects();
+        for (int i = 0; i < numberObjects; i++) {
+            const CbcSimpleInteger * obj =
+                dynamic_cast <const CbcSimpleInteger *>(objects[i]) ;
+            if (obj && obj->columnNumber() < numberColumns)
+                priority[obj->columnNumber()] = obj->priority();
+        }
+    }
+    // cuts
+    int numberCuts = cuts ? cuts->sizeRowCuts() : 0;
+    CoinBigIndex * cutStart = new CoinBigIndex [numberCuts+1];
+    double * cutLower = new double [numberCuts];
+    double * cutUpper = new double [numberCuts];
+    cutStart[0] = 0;
+    for (int i = 0; i < numberCuts; i++) {
+        const OsiRowCut & cut = cuts->rowCut(i);
+        cutStart[i+1] = cutStart[i] + cut.row().getNumElements();
+        cutLower[i] = cut.lb();
+        cutUpper[i] = cut.ub();
+    }
+    CoinBigIndex numberCutElements = cutStart[numberCuts];
+    int * cutIndex = new int [numberCutElements];
+    double * cutElement = new double [numberCutElements];
+    for (int i = 0; i < numberCuts; i++) {
+        const CoinPackedVector & row = cuts->rowCut(i).row();
+        CoinMemcpyN(row.getIndices(), row.getNumElements(), cutIndex + cutStart[i]);
+        CoinMemcpyN(row.getElements(), row.getNumElements(), cutElement + cutStart[i]);
+    }
+    header.numberCuts = numberCuts;
+    header.numberCutElements = numberCutElements;
+    // names of original columns
+    std::string names;
+    if (originalNames && static_cast<int> (originalNames->size()) >= numberOriginalColumns &&
+            numberOriginalColumns) {
+        for (int i = 0; i < numberOriginalColumns; i++) {
+            names += (*originalNames)[i];
+            names += '\0';
+        }
+    }
+    header.lengthNames = static_cast<int> (names.size());
+    int returnCode = 0;
+    FILE * fp = fopen(fileName, "wb");
+    if (fp) {
+        bool ok = writeSection(fp, &header, 1);
+        ok = ok && writeSection(fp, matrix.getVectorStarts(), numberColumns + 1);
+        ok = ok && writeSection(fp, matrix.getIndices(), header.numberElements);
+        ok = ok && writeSection(fp, matrix.getElements(), header.numberElements);
+        ok = ok && writeSection(fp, solver->getColLower(), numberColumns);
+        ok = ok && writeSection(fp, solver->getColUpper(), numberColumns);
+        ok = ok && writeSection(fp, solver->getObjCoefficients(), numberColumns);
+        ok = ok && writeSection(fp, solver->getRowLower(), numberRows);
+        ok = ok && writeSection(fp, solver->getRowUpper(), numberRows);
+        ok = ok && writeSection(fp, integerType, numberColumns);
+        ok = ok && writeSection(fp, priority, numberColumns);
+        ok = ok && writeSection(fp, originalColumns, numberColumns);
+        ok = ok && writeSection(fp, cutStart, numberCuts + 1);
+        ok = ok && writeSection(fp, cutIndex, numberCutElements);
+        ok = ok && writeSection(fp, cutElement, numberCutElements);
+        ok = ok && writeSection(fp, cutLower, numberCuts);
+        ok = ok && writeSection(fp, cutUpper, numberCuts);
+        if (original) {
+            int numberOriginalRows = header.numberOriginalRows;
+            ok = ok && writeSection(fp, originalMatrix.getVectorStarts(), numberOriginalColumns + 1);
+            ok = ok && writeSection(fp, originalMatrix.getIndices(), header.numberOriginalElements);
+            ok = ok && writeSection(fp, originalMatrix.getElements(), header.numberOriginalElements);
+            ok = ok && writeSection(fp, original->getColLower(), numberOriginalColumns);
+            ok = ok && writeSection(fp, original->getColUpper(), numberOriginalColumns);
+            ok = ok && writeSection(fp, original->getObjCoefficients(), numberOriginalColumns);
+            ok = ok && writeSection(fp, original->getRowLower(), numberOriginalRows);
+            ok = ok && writeSection(fp, original->getRowUpper(), numberOriginalRows);
+            ok = ok && writeSection(fp, originalIntegerType, numberOriginalColumns);
+        }
+        ok = ok && writeSection(fp, names.c_str(), names.size());
+        if (fclose(fp) || !ok)
+            returnCode = 2;
+    } else {
+        returnCode = 1;
+    }
+    delete [] integerType;
+    delete [] priority;
+    delete [] originalColumns;
+    delete [] cutStart;
+    delete [] cutIndex;
+    delete [] cutElement;
+    delete [] cutLower;
+    delete [] cutUpper;
+    delete [] originalIntegerType;
+    return returnCode;
+}
+
+// True if file starts like a snapshot
+bool
+CbcSnapshot::isSnapshot(const char * fileName)
+{
+    FILE * fp = fopen(fileName, "rb");
+    if (!fp)
+        return false;
+    char magic[8];
+    bool yes = fread(magic, 1, 8, fp) == 8 && !memcmp(magic, snapshotMagic, 8);
+    fclose(fp);
+    return yes;
+}
+
+// Map snapshot file
+int
+CbcSnapshot::read(const char * fileName)
+{
+    clear();
+#ifndef _MSC_VER
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+        return 1;
+    struct stat statBuffer;
+    if (fstat(fd, &statBuffer) ||
+            statBuffer.st_size < static_cast<off_t> (sizeof(CbcSnapshotHeader))) {
+        close(fd);
+        return 2;
+    }
+    size_t size = static_cast<size_t> (statBuffer.st_size);
+    void * mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+        return 1;
+    buffer_ = static_cast<char *> (mapped);
+    mapped_ = true;
+#else
+    FILE * fp = fopen(fileName, "rb");
+    if (!fp)
+        return 1;
+    fseek(fp, 0, SEEK_END);
+    size_t size = static_cast<size_t> (ftell(fp));
+    fseek(fp, 0, SEEK_SET);
+    // doubles so aligned
+    buffer_ = reinterpret_cast<char *> (new double [(size + 7) / 8]);
+    size_t nRead = fread(buffer_, 1, size, fp);
+    fclose(fp);
+    if (nRead != size || size < sizeof(CbcSnapshotHeader)) {
+        clear();
+        return 2;
+    }
+#endif
+    size_ = size;
+    if (setPointers(size)) {
+        clear();
+        return 2;
+    }
+    return 0;
+}
+
+// Set pointers into buffer - returns 0 if everything is consistent
+int
+CbcSnapshot::setPointers(size_t size)
+{
+    const CbcSnapshotHeader * header =
+        reinterpret_cast<const CbcSnapshotHeader *> (buffer_);
+    if (memcmp(header->magic, snapshotMagic, 8) ||
+            header->version != snapshotVersion ||
+            header->check != snapshotCheck ||
+            header->sizeofBigIndex != static_cast<int> (sizeof(CoinBigIndex)))
+        return 1;
+    int numberRows = header->numberRows;
+    int numberColumns = header->numberColumns;
+    int numberOriginalColumns = header->numberOriginalColumns;
+    int numberOriginalRows = header->numberOriginalRows;
+    int numberCuts = header->numberCuts;
+    if (numberRows < 0 || numberColumns < 0 || numberOriginalColumns < 0 ||
+            numberOriginalRows < -1 || numberCuts < 0 || header->lengthNames < 0 ||
+            header->numberElements < 0 || header->numberCutElements < 0 ||
+            (numberOriginalRows >= 0 && header->numberOriginalElements < 0))
+        return 1;
+    size_t position = align8(sizeof(CbcSnapshotHeader));
+    columnStart_ = nextSection<CoinBigIndex>(buffer_, position, static_cast<size_t> (numberColumns) + 1, size);
+    row_ = nextSection<int>(buffer_, position, header->numberElements, size);
+    element_ = nextSection<double>(buffer_, position, header->numberElements, size);
+    columnLower_ = nextSection<double>(buffer_, position, numberColumns, size);
+    columnUpper_ = nextSection<double>(buffer_, position, numberColumns, size);
+    objective_ = nextSection<double>(buffer_, position, numberColumns, size);
+    rowLower_ = nextSection<double>(buffer_, position, numberRows, size);
+    rowUpper_ = nextSection<double>(buffer_, position, numberRows, size);
+    integerType_ = nextSection<char>(buffer_, position, numberColumns, size);
+    priority_ = nextSection<int>(buffer_, position, numberColumns, size);
+    originalColumns_ = nextSection<int>(buffer_, position, numberColumns, size);
+    cutStart_ = nextSection<CoinBigIndex>(buffer_, position, static_cast<size_t> (numberCuts) + 1, size);
+    cutIndex_ = nextSection<int>(buffer_, position, header->numberCutElements, size);
+    cutElement_ = nextSection<double>(buffer_, position, header->numberCutElements, size);
+    cutLower_ = nextSection<double>(buffer_, position, numberCuts, size);
+    cutUpper_ = nextSection<double>(buffer_, position, numberCuts, size);
+    if (!columnStart_ || !row_ || !element_ || !columnLower_ || !columnUpper_ ||
+            !objective_ || !rowLower_ || !rowUpper_ || !integerType_ ||
+            !priority_ || !originalColumns_ || !cutStart_ || !cutIndex_ ||
+            !cutElement_ || !cutLower_ || !cutUpper_)
+        return 1;
+    if (numberOriginalRows >= 0) {
+        CoinBigIndex numberOriginalElements = header->numberOriginalElements;
+        originalStart_ = nextSection<CoinBigIndex>(buffer_, position, static_cast<size_t> (numberOriginalColumns) + 1, size);
+        originalRow_ = nextSection<int>(buffer_, position, numberOriginalElements, size);
+        originalElement_ = nextSection<double>(buffer_, position, numberOriginalElements, size);
+        originalColumnLower_ = nextSection<double>(buffer_, position, numberOriginalColumns, size);
+        originalColumnUpper_ = nextSection<double>(buffer_, position, numberOriginalColumns, size);
+        originalObjective_ = nextSection<double>(buffer_, position, numberOriginalColumns, size);
+        originalRowLower_ = nextSection<double>(buffer_, position, numberOriginalRows, size);
+        originalRowUpper_ = nextSection<double>(buffer_, position, numberOriginalRows, size);
+        originalIntegerType_ = nextSection<char>(buffer_, position, numberOriginalColumns, size);
+        if (!originalStart_ || !originalRow_ || !originalElement_ ||
+                !originalColumnLower_ || !originalColumnUpper_ ||
+                !originalObjective_ || !originalRowLower_ ||
+                !originalRowUpper_ || !originalIntegerType_ ||
+                !validMatrix(originalStart_, numberOriginalColumns,
+                             numberOriginalElements, originalRow_,
+                             numberOriginalRows))
+            return 1;
+    }
+    if (header->lengthNames) {
+        names_ = nextSection<char>(buffer_, position, header->lengthNames, size);
+        if (!names_ || names_[header->lengthNames-1])
+            return 1;
+        // one name for each original column
+        int numberNames = 0;
+        for (int i = 0; i < header->lengthNames; i++) {
+            if (!names_[i])
+                numberNames++;
+        }
+        if (numberNames != numberOriginalColumns)
+            return 1;
+    }
+    if (position != size)
+        return 1;
+    // offsets and indices
+    if (!validMatrix(columnStart_, numberColumns, header->numberElements,
+                     row_, numberRows) ||
+            !validMatrix(cutStart_, numberCuts, header->numberCutElements,
+                         cutIndex_, numberColumns))
+        return 1;
+    for (int i = 0; i < numberColumns; i++) {
+        if (originalColumns_[i] < -1 || originalColumns_[i] >= numberOriginalColumns)
+            return 1;
+    }
+    return 0;
+}
+
+// Number of rows
+int
+CbcSnapshot::numberRows() const
+{
+    return buffer_ ? reinterpret_cast<const CbcSnapshotHeader *> (buffer_)->numberRows : 0;
+}
+
+// Number of columns
+int
+CbcSnapshot::numberColumns() const
+{
+    return buffer_ ? reinterpret_cast<const CbcSnapshotHeader *> (buffer_)->numberColumns : 0;
+}
+
+// Number of columns in original model
+int
+CbcSnapshot::numberOriginalColumns() const
+{
+    return buffer_ ? reinterpret_cast<const CbcSnapshotHeader *> (buffer_)->numberOriginalColumns : 0;
+}
+
+// Number of cuts
+int
+CbcSnapshot::numberCuts() const
+{
+    return buffer_ ? reinterpret_cast<const CbcSnapshotHeader *> (buffer_)->numberCuts : 0;
+}
+
+// Column names
+std::vector<std::string>
+CbcSnapshot::columnNames() const
+{
+    std::vector<std::string> names;
+    std::vector<std::string> original = originalColumnNames();
+    if (original.size()) {
+        int numberColumns = this->numberColumns();
+        names.reserve(numberColumns);
+        for (int i = 0; i < numberColumns; i++) {
+            int iColumn = originalColumns_[i];
+            if (iColumn >= 0) {
+                names.push_back(original[iColumn]);
+            } else {
+                char name[20];
+                sprintf(name, "C%7.7d", i);
+                names.push_back(std::string(name));
+            }
+        }
+    }
+    return names;
+}
+
+// Names of original columns
+std::vector<std::string>
+CbcSnapshot::originalColumnNames() const
+{
+    std::vector<std::string> names;
+    if (names_) {
+        int numberOriginalColumns = this->numberOriginalColumns();
+        names.reserve(numberOriginalColumns);
+        const char * name = names_;
+        for (int i = 0; i < numberOriginalColumns; i++) {
+            names.push_back(std::string(name));
+            name += strlen(name) + 1;
+        }
+    }
+    return names;
+}
+
+// Row names
+std::vector<std::string>
+CbcSnapshot::rowNames() const
+{
+    std::vector<std::string> names;
+    int numberRows = this->numberRows();
+    names.reserve(numberRows);
+    for (int i = 0; i < numberRows; i++) {
+        char name[20];
+        sprintf(name, "R%7.7d", i);
+        names.push_back(std::string(name));
+    }
+    return names;
+}
+
+// Row names of original model
+std::vector<std::string>
+CbcSnapshot::originalRowNames() const
+{
+    std::vector<std::string> names;
+    if (originalStart_) {
+        int numberOriginalRows =
+            reinterpret_cast<const CbcSnapshotHeader *> (buffer_)->numberOriginalRows;
+        names.reserve(numberOriginalRows);
+        for (int i = 0; i < numberOriginalRows; i++) {
+            char name[20];
+            sprintf(name, "R%7.7d", i);
+            names.push_back(std::string(name));
+        }
+    }
+    return names;
+}
+
+// Load preprocessed model into solver
+void
+CbcSnapshot::loadProblem(OsiSolverInterface * solver) const
+{
+    assert (buffer_);
+    const CbcSnapshotHeader * header =
+        reinterpret_cast<const CbcSnapshotHeader *> (buffer_);
+    int numberColumns = header->numberColumns;
+    solver->loadProblem(numberColumns, header->numberRows,
+                        columnStart_, row_, element_,
+                        columnLower_, columnUpper_, objective_,
+                        rowLower_, rowUpper_);
+    for (int i = 0; i < numberColumns; i++) {
+        if (integerType_[i])
+            solver->setInteger(i);
+    }
+    solver->setObjSense(header->objectiveSense);
+    solver->setDblParam(OsiObjOffset, header->objectiveOffset);
+}
+
+// True if original model was saved
+bool
+CbcSnapshot::hasOriginal() const
+{
+    return originalStart_ != NULL;
+}
+
+// Load original model into solver
+void
+CbcSnapshot::loadOriginal(OsiSolverInterface * solver) const
+{
+    assert (originalStart_);
+    const CbcSnapshotHeader * header =
+        reinterpret_cast<const CbcSnapshotHeader *> (buffer_);
+    int numberOriginalColumns = header->numberOriginalColumns;
+    solver->loadProblem(numberOriginalColumns, header->numberOriginalRows,
+                        originalStart_, originalRow_, originalElement_,
+                        originalColumnLower_, originalColumnUpper_,
+                        originalObjective_, originalRowLower_,
+                        originalRowUpper_);
+    for (int i = 0; i < numberOriginalColumns; i++) {
+        if (originalIntegerType_[i])
+            solver->setInteger(i);
+    }
+    solver->setObjSense(header->objectiveSense);
+    solver->setDblParam(OsiObjOffset, header->originalObjectiveOffset);
+}
+
+// Set priorities and add cuts
+void
+CbcSnapshot::setupModel(CbcModel & model) const
+{
+    assert (buffer_);
+    model.findIntegers(false);
+    int numberObjects = model.numberObjects();
+    OsiObject ** objects = model.objects();
+    int numberColumns = this->numberColumns();
+    for (int i = 0; i < numberObjects; i++) {
+        CbcSimpleInteger * obj =
+            dynamic_cast <CbcSimpleInteger *>(objects[i]) ;
+        if (obj && obj->columnNumber() < numberColumns)
+            obj->setPriority(priority_[obj->columnNumber()]);
+    }
+    int numberCuts = this->numberCuts();
+    for (int i = 0; i < numberCuts; i++) {
+        OsiRowCut rc;
+        CoinBigIndex start = cutStart_[i];
+        rc.setRow(static_cast<int> (cutStart_[i+1] - start), cutIndex_ + start,
+                  cutElement_ + start, false);
+        rc.setLb(cutLower_[i]);
+        rc.setUb(cutUpper_[i]);
+        model.makeGlobalCut(rc);
+    }
+}
+
+// Map solution back onto original solver
+int
+CbcSnapshot::postSolve(OsiSolverInterface * original, const double * solution,
+                       double * originalSolution) const
+{
+    assert (buffer_);
+    int numberOriginalColumns = original->getNumCols();
+    if (numberOriginalColumns != this->numberOriginalColumns())
+        return 2;
+    double * saveLower = CoinCopyOfArray(original->getColLower(), numberOriginalColumns);
+    double * saveUpper = CoinCopyOfArray(original->getColUpper(), numberOriginalColumns);
+    int numberColumns = this->numberColumns();
+    for (int i = 0; i < numberColumns; i++) {
+        int iColumn = originalColumns_[i];
+        if (iColumn >= 0 && original->isInteger(iColumn)) {
+            double value = floor(solution[i] + 0.5);
+            original->setColLower(iColumn, value);
+            original->setColUpper(iColumn, value);
+        }
+    }
+    original->resolve();
+    int returnCode = 1;
+    if (original->isProvenOptimal()) {
+        // any integers dropped by preprocessing must have come out integral
+        const double * value = original->getColSolution();
+        double tolerance;
+        original->getDblParam(OsiPrimalTolerance, tolerance);
+        returnCode = 0;
+        for (int i = 0; i < numberOriginalColumns; i++) {
+            if (original->isInteger(i) &&
+                    fabs(value[i] - floor(value[i] + 0.5)) > 10.0 * tolerance) {
+                returnCode = 1;
+                break;
+            }
+        }
+        if (!returnCode) {
+            CoinMemcpyN(value, numberOriginalColumns, originalSolution);
+        } else {
+            // small search on integers preprocessing took out
+            CbcModel model(*original);
+            model.setLogLevel(0);
+            model.setMaximumNodes(1000);
+            model.branchAndBound();
+            if (model.bestSolution()) {
+                CoinMemcpyN(model.bestSolution(), numberOriginalColumns,
+                            originalSolution);
+                returnCode = 0;
+            }
+        }
+    }
+    original->setColLower(saveLower);
+    original->setColUpper(saveUpper);
+    delete [] saveLower;
+    delete [] saveUpper;
+    return returnCode;
+}
+
+// Default Constructor
+CbcSnapshotEventHandler::CbcSnapshotEventHandler (OsiCuts * cuts)
+    : CbcEventHandler(),
+      cuts_(cuts),
+      finished_(false)
+{
+}
+
+// Copy constructor
+CbcSnapshotEventHandler::CbcSnapshotEventHandler (const CbcSnapshotEventHandler & rhs)
+    : CbcEventHandler(rhs),
+      cuts_(rhs.cuts_),
+      finished_(rhs.finished_)
+{
+}
+
+// Assignment operator
+CbcSnapshotEventHandler &
+CbcSnapshotEventHandler::operator=( const CbcSnapshotEventHandler & rhs)
+{
+    if (this != &rhs) {
+        CbcEventHandler::operator=(rhs);
+        cuts_ = rhs.cuts_;
+        finished_ = rhs.finished_;
+    }
+    return *this;
+}
+
+// Clone
+CbcEventHandler *
+CbcSnapshotEventHandler::clone() const
+{
+    return new CbcSnapshotEventHandler(*this);
+}
+
+// Destructor
+CbcSnapshotEventHandler::~CbcSnapshotEventHandler ()
+{
+}
+
+// Copies global cuts while there is no cutoff
+CbcEventHandler::CbcAction
+CbcSnapshotEventHandler::event(CbcEvent whichEvent)
+{
+    if (cuts_ && model_ && !model_->parentModel() && !finished_ &&
+            (whichEvent == treeStatus || whichEvent == solution ||
+             whichEvent == heuristicSolution || whichEvent == endSearch)) {
+        /* Cuts made once there is a cutoff may depend on it so keep
+           the set from before that (on solution events the new cutoff
+           is not in yet) */
+        if (model_->getCutoff() < 1.0e50) {
+            finished_ = true;
+        } else {
+            *cuts_ = OsiCuts();
+            CbcRowCuts * globalCuts = model_->globalCuts();
+            int numberCuts = globalCuts->sizeRowCuts();
+            for (int i = 0; i < numberCuts; i++) {
+                const OsiRowCut * cut = globalCuts->rowCutPtr(i);
+                if (cut)
+                    cuts_->insert(*cut);
+            }
+        }
+    }
+    return CbcEventHandler::event(whichEvent);
+}
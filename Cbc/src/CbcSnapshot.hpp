@@ -0,0 +1,214 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcSnapshot_H
+#define CbcSnapshot_H
+
+#include <string>
+#include <vector>
+#include "CoinTypes.hpp"
+#include "CbcEventHandler.hpp"
+
+class OsiSolverInterface;
+class OsiCuts;
+class CbcModel;
+
+/** Binary snapshot of a preprocessed model.
+
+    Holds the preprocessed model, the mapping back to original columns
+    (as CbcModel::originalColumns()), priorities of simple integer
+    objects, cuts valid at the root, names of original columns and
+    normally the original model.  All arrays are stored 8 byte aligned
+    in native format after a small header so reading is just a memory
+    map and the model can be loaded straight from the mapped arrays.
+    Counts, offsets and indices are checked when the file is read.
+
+    The presolve stack of CglPreProcess can not be saved so a solution
+    of the snapshot model is mapped back to the original model with
+    postSolve() which fixes integer values and resolves the LP.
+*/
+
+class CbcSnapshot {
+
+public:
+
+    /// Default Constructor
+    CbcSnapshot ();
+
+    /// Destructor
+    ~CbcSnapshot ();
+
+    /** Write snapshot.
+        solver is preprocessed model, model (may be NULL) gives
+        originalColumns and priorities, cuts (may be NULL) are cuts
+        on preprocessed model valid at root, originalNames (may be NULL)
+        are names of original columns and original (may be NULL) is
+        the original model so solutions can be mapped back without it.
+        Returns 0 if OK */
+    static int write(const char * fileName, const OsiSolverInterface * solver,
+                     const CbcModel * model, int numberOriginalColumns,
+                     const OsiCuts * cuts,
+                     const std::vector<std::string> * originalNames,
+                     const OsiSolverInterface * original = NULL);
+
+    /// True if file starts like a snapshot
+    static bool isSnapshot(const char * fileName);
+
+    /** Map snapshot file.
+        Returns 0 if OK, 1 can not open, 2 bad format, wrong version or
+        inconsistent sizes */
+    int read(const char * fileName);
+
+    /// Free any mapped file
+    void clear();
+
+    /// Load preprocessed model into solver
+    void loadProblem(OsiSolverInterface * solver) const;
+
+    /// True if original model was saved
+    bool hasOriginal() const;
+
+    /// Load original model into solver (hasOriginal() must be true)
+    void loadOriginal(OsiSolverInterface * solver) const;
+
+    /** Set priorities of simple integers and add cuts as global cuts.
+        Model solver should have been loaded by loadProblem. */
+    void setupModel(CbcModel & model) const;
+
+    /** Map solution of snapshot model onto original solver - integers
+        are fixed and LP resolved (with a small search if integers which
+        preprocessing removed are not integral).  Bounds of original are
+        restored afterwards.  Returns 0 if feasible and fills
+        originalSolution */
+    int postSolve(OsiSolverInterface * original, const double * solution,
+                  double * originalSolution) const;
+
+    /// Number of rows
+    int numberRows() const;
+    /// Number of columns
+    int numberColumns() const;
+    /// Number of columns in original model
+    int numberOriginalColumns() const;
+    /// Number of cuts
+    int numberCuts() const;
+    /// Original column for each column
+    inline const int * originalColumns() const {
+        return originalColumns_;
+    }
+    /// Column names (empty if not saved)
+    std::vector<std::string> columnNames() const;
+    /// Names of original columns (empty if not saved)
+    std::vector<std::string> originalColumnNames() const;
+    /// Row names (generated as R0000000 as none saved)
+    std::vector<std::string> rowNames() const;
+    /// Row names of original model (generated, empty if not saved)
+    std::vector<std::string> originalRowNames() const;
+
+private:
+    /// No copy
+    CbcSnapshot ( const CbcSnapshot &);
+    /// No assignment
+    CbcSnapshot & operator=( const CbcSnapshot& rhs);
+
+    /// Set pointers into buffer - returns 0 if everything is consistent
+    int setPointers(size_t size);
+
+private:
+    /// Start of file in memory
+    char * buffer_;
+    /// Size of buffer
+    size_t size_;
+    /// True if buffer is memory mapped (else new)
+    bool mapped_;
+    /// Column starts
+    const CoinBigIndex * columnStart_;
+    /// Row indices
+    const int * row_;
+    /// Elements
+    const double * element_;
+    /// Column lower bounds
+    const double * columnLower_;
+    /// Column upper bounds
+    const double * columnUpper_;
+    /// Objective
+    const double * objective_;
+    /// Row lower bounds
+    const double * rowLower_;
+    /// Row upper bounds
+    const double * rowUpper_;
+    /// 1 if integer
+    const char * integerType_;
+    /// Priorities (for integers)
+    const int * priority_;
+    /// Original columns
+    const int * originalColumns_;
+    /// Cut starts
+    const CoinBigIndex * cutStart_;
+    /// Cut indices
+    const int * cutIndex_;
+    /// Cut elements
+    const double * cutElement_;
+    /// Cut lower bounds
+    const double * cutLower_;
+    /// Cut upper bounds
+    const double * cutUpper_;
+    /// Original column starts (NULL if original not saved)
+    const CoinBigIndex * originalStart_;
+    /// Original row indices
+    const int * originalRow_;
+    /// Original elements
+    const double * originalElement_;
+    /// Original column lower bounds
+    const double * originalColumnLower_;
+    /// Original column upper bounds
+    const double * originalColumnUpper_;
+    /// Original objective
+    const double * originalObjective_;
+    /// Original row lower bounds
+    const double * originalRowLower_;
+    /// Original row upper bounds
+    const double * originalRowUpper_;
+    /// 1 if original column integer
+    const char * originalIntegerType_;
+    /// Original column names (null terminated, one after another)
+    const char * names_;
+};
+
+/** Event handler which saves global cuts so they can go in a snapshot
+    (globalCuts are freed at end of branchAndBound).  Only cuts found
+    while there is no cutoff are kept as later ones may depend on the
+    incumbent - so nothing is kept if a cutoff is given.
+*/
+
+class CbcSnapshotEventHandler : public CbcEventHandler {
+
+public:
+    /// Default Constructor
+    CbcSnapshotEventHandler (OsiCuts * cuts = NULL);
+
+    /// Copy constructor
+    CbcSnapshotEventHandler ( const CbcSnapshotEventHandler &);
+
+    /// Assignment operator
+    CbcSnapshotEventHandler & operator=( const CbcSnapshotEventHandler& rhs);
+
+    /// Clone
+    virtual CbcEventHandler * clone() const;
+
+    /// Destructor
+    virtual ~CbcSnapshotEventHandler ();
+
+    /// Copies global cuts (tree status, solution and endSearch events)
+    virtual CbcAction event(CbcEvent whichEvent);
+
+private:
+    /// Where cuts go (not owned)
+    OsiCuts * cuts_;
+    /// True once there is a cutoff
+    bool finished_;
+};
+
+#endif
+
@@ -0,0 +1,536 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <climits>
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+#include "CoinTypes.hpp"
+#include "CbcSolutionPool.hpp"
+
+// Default Constructor
+CbcSolutionPool::CbcSolutionPool ()
+        : reference_(NULL),
+        isHashColumn_(NULL),
+        numberHashColumns_(0),
+        hashAll_(false),
+        numberColumns_(0),
+        maximumSolutions_(0),
+        minimumDistance_(-1)
+{
+}
+
+// Copy constructor
+CbcSolutionPool::CbcSolutionPool ( const CbcSolutionPool & rhs)
+        : reference_(NULL),
+        isHashColumn_(NULL),
+        numberHashColumns_(0),
+        hashAll_(false),
+        numberColumns_(0),
+        maximumSolutions_(0),
+        minimumDistance_(-1)
+{
+    gutsOfCopy(rhs);
+}
+
+// Assignment operator
+CbcSolutionPool &
+CbcSolutionPool::operator=( const CbcSolutionPool & rhs)
+{
+    if (this != &rhs) {
+        gutsOfDelete();
+        gutsOfCopy(rhs);
+    }
+    return *this;
+}
+
+// Destructor
+CbcSolutionPool::~CbcSolutionPool ()
+{
+    gutsOfDelete();
+}
+
+void
+CbcSolutionPool::gutsOfCopy(const CbcSolutionPool & rhs)
+{
+    numberColumns_ = rhs.numberColumns_;
+    maximumSolutions_ = rhs.maximumSolutions_;
+    minimumDistance_ = rhs.minimumDistance_;
+    numberHashColumns_ = rhs.numberHashColumns_;
+    hashAll_ = rhs.hashAll_;
+    reference_ = CoinCopyOfArray(rhs.reference_, numberColumns_);
+    isHashColumn_ = CoinCopyOfArray(rhs.isHashColumn_, numberColumns_);
+    int n = rhs.numberSolutions();
+    entries_.reserve(n);
+    for (int i = 0; i < n; i++) {
+        const Entry * from = rhs.entries_[i];
+        Entry * entry = new Entry;
+        entry->objective = from->objective;
+        entry->hash = from->hash;
+        entry->numberDifferences = from->numberDifferences;
+        entry->index = CoinCopyOfArray(from->index, from->numberDifferences);
+        entry->value = CoinCopyOfArray(from->value, from->numberDifferences);
+        entry->dense = NULL;
+        entries_.push_back(entry);
+        hashTable_.insert(std::make_pair(entry->hash, entry));
+    }
+}
+
+void
+CbcSolutionPool::gutsOfDelete()
+{
+    for (int i = 0; i < numberSolutions(); i++)
+        deleteEntry(entries_[i]);
+    entries_.clear();
+    hashTable_.clear();
+    delete [] reference_;
+    reference_ = NULL;
+    delete [] isHashColumn_;
+    isHashColumn_ = NULL;
+    numberHashColumns_ = 0;
+}
+
+void
+CbcSolutionPool::deleteEntry(Entry * entry)
+{
+    delete [] entry->index;
+    delete [] entry->value;
+    delete [] entry->dense;
+    delete entry;
+}
+
+// Delete all solutions (keeps maximum)
+void
+CbcSolutionPool::clear()
+{
+    gutsOfDelete();
+}
+
+// Set maximum number of solutions kept (may delete worst)
+void
+CbcSolutionPool::setMaximumSolutions(int value)
+{
+    value = CoinMax(value, 0);
+    while (numberSolutions() > value)
+        deleteSolution(numberSolutions() - 1);
+    maximumSolutions_ = value;
+    if (!maximumSolutions_)
+        gutsOfDelete();
+}
+
+// Delete solution (0 best in pool)
+void
+CbcSolutionPool::deleteSolution(int which)
+{
+    if (which >= 0 && which < numberSolutions()) {
+        Entry * entry = entries_[which];
+        removeHash(entry);
+        entries_.erase(entries_.begin() + which);
+        deleteEntry(entry);
+    }
+}
+
+void
+CbcSolutionPool::removeHash(const Entry * entry)
+{
+    std::multimap<unsigned int, Entry *>::iterator it =
+        hashTable_.lower_bound(entry->hash);
+    for (; it != hashTable_.end() && it->first == entry->hash; ++it) {
+        if (it->second == entry) {
+            hashTable_.erase(it);
+            break;
+        }
+    }
+}
+
+// Store solution in entry relative to reference
+void
+CbcSolutionPool::storeSparse(Entry * entry, const double * solution,
+                             const double * reference)
+{
+    int n = 0;
+    for (int i = 0; i < numberColumns_; i++) {
+        if (solution[i] != reference[i])
+            n++;
+    }
+    delete [] entry->index;
+    delete [] entry->value;
+    entry->numberDifferences = n;
+    entry->index = n ? new int [n] : NULL;
+    entry->value = n ? new double [n] : NULL;
+    n = 0;
+    for (int i = 0; i < numberColumns_; i++) {
+        if (solution[i] != reference[i]) {
+            entry->index[n] = i;
+            entry->value[n++] = solution[i];
+        }
+    }
+}
+
+// Expand entry into dense array
+void
+CbcSolutionPool::expand(const Entry * entry, double * solution) const
+{
+    if (entry->dense) {
+        CoinMemcpyN(entry->dense, numberColumns_, solution);
+    } else {
+        CoinMemcpyN(reference_, numberColumns_, solution);
+        for (int i = 0; i < entry->numberDifferences; i++)
+            solution[entry->index[i]] = entry->value[i];
+    }
+}
+
+// Hash integer part of solution
+unsigned int
+CbcSolutionPool::hashSolution(const double * solution) const
+{
+    // FNV-1a on nonzero (rounded) values and their columns
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < numberColumns_; i++) {
+        if (!isHashColumn_[i])
+            continue;
+        double value = roundedValue(solution[i]);
+        if (!value)
+            continue;
+        unsigned int bits[3];
+        bits[0] = static_cast<unsigned int> (i);
+        CoinUInt64 valueBits;
+        memcpy(&valueBits, &value, sizeof(double));
+        bits[1] = static_cast<unsigned int> (valueBits);
+        bits[2] = static_cast<unsigned int> (valueBits >> 32);
+        const unsigned char * byte = reinterpret_cast<const unsigned char *> (bits);
+        for (int j = 0; j < static_cast<int> (sizeof(bits)); j++) {
+            hash ^= byte[j];
+            hash *= 16777619u;
+        }
+    }
+    return hash;
+}
+
+// Set which columns are used for hashing (rehashes if changed)
+void
+CbcSolutionPool::setHashColumns(int numberIntegers, const int * integerVariable)
+{
+    bool hashAll = (numberIntegers == 0);
+    int numberHash = hashAll ? numberColumns_ : numberIntegers;
+    if (isHashColumn_ && hashAll == hashAll_ && numberHash == numberHashColumns_) {
+        // same count - only skip if same columns
+        bool same = true;
+        if (!hashAll) {
+            for (int i = 0; i < numberIntegers; i++) {
+                if (!isHashColumn_[integerVariable[i]]) {
+                    same = false;
+                    break;
+                }
+            }
+        }
+        if (same)
+            return;
+    }
+    delete [] isHashColumn_;
+    isHashColumn_ = new char [numberColumns_];
+    hashAll_ = hashAll;
+    numberHashColumns_ = numberHash;
+    if (hashAll) {
+        memset(isHashColumn_, 1, numberColumns_);
+    } else {
+        memset(isHashColumn_, 0, numberColumns_);
+        for (int i = 0; i < numberIntegers; i++)
+            isHashColumn_[integerVariable[i]] = 1;
+    }
+    rebuildHash();
+}
+
+// Recompute all hash values
+void
+CbcSolutionPool::rebuildHash()
+{
+    hashTable_.clear();
+    if (!numberSolutions())
+        return;
+    double * temp = new double [numberColumns_];
+    for (int i = 0; i < numberSolutions(); i++) {
+        Entry * entry = entries_[i];
+        expand(entry, temp);
+        entry->hash = hashSolution(temp);
+        hashTable_.insert(std::make_pair(entry->hash, entry));
+    }
+    delete [] temp;
+}
+
+/* Hamming distance on hashed columns between entry and dense solution.
+   Only columns where entry differs from reference change the answer
+   from the distance between reference and solution. */
+int
+CbcSolutionPool::distance(const Entry * entry, const double * solution,
+                          int numberReferenceDiffers) const
+{
+    int dist = numberReferenceDiffers;
+    for (int i = 0; i < entry->numberDifferences; i++) {
+        int iColumn = entry->index[i];
+        if (!isHashColumn_[iColumn])
+            continue;
+        double value = roundedValue(solution[iColumn]);
+        if (roundedValue(entry->value[i]) != value)
+            dist++;
+        if (roundedValue(reference_[iColumn]) != value)
+            dist--;
+    }
+    return dist;
+}
+
+/* Add a solution.
+   Returns position (0 best) or -1 if not kept */
+int
+CbcSolutionPool::addSolution(const double * solution, double objectiveValue,
+                             int numberColumns, int numberIntegers,
+                             const int * integerVariable)
+{
+    if (!maximumSolutions_)
+        return -1;
+    if (!numberSolutions()) {
+        if (numberColumns != numberColumns_) {
+            gutsOfDelete();
+            numberColumns_ = numberColumns;
+        }
+        delete [] reference_;
+        reference_ = CoinCopyOfArray(solution, numberColumns_);
+    } else if (numberColumns != numberColumns_) {
+        resize(numberColumns);
+    }
+    setHashColumns(numberIntegers, integerVariable);
+    unsigned int hash = hashSolution(solution);
+    int numberReferenceDiffers = 0;
+    for (int i = 0; i < numberColumns_; i++) {
+        if (isHashColumn_[i] &&
+                roundedValue(solution[i]) != roundedValue(reference_[i]))
+            numberReferenceDiffers++;
+    }
+    // See if already there - equal hashes are checked on full integer part
+    std::multimap<unsigned int, Entry *>::iterator it =
+        hashTable_.lower_bound(hash);
+    for (; it != hashTable_.end() && it->first == hash; ++it) {
+        Entry * entry = it->second;
+        if (distance(entry, solution, numberReferenceDiffers))
+            continue;
+        if (objectiveValue >= entry->objective)
+            return -1;
+        // same integer part but better - replace
+        int which;
+        for (which = 0; which < numberSolutions(); which++) {
+            if (entries_[which] == entry)
+                break;
+        }
+        deleteSolution(which);
+        break;
+    }
+    int n = numberSolutions();
+    if (n == maximumSolutions_) {
+        if (objectiveValue >= entries_[n-1]->objective)
+            return -1;
+        int minimumDistance = minimumDistance_;
+        if (minimumDistance < 0)
+            minimumDistance = CoinMax(2, numberHashColumns_ / 100);
+        // find closest solution which is worse
+        int closest = -1;
+        int closestDistance = COIN_INT_MAX;
+        for (int i = n - 1; i >= 0; i--) {
+            if (entries_[i]->objective <= objectiveValue)
+                break;
+            int dist = distance(entries_[i], solution, numberReferenceDiffers);
+            if (dist < closestDistance) {
+                closestDistance = dist;
+                closest = i;
+            }
+        }
+        if (closestDistance < minimumDistance)
+            deleteSolution(closest);
+        else
+            deleteSolution(n - 1);
+    }
+    Entry * entry = new Entry;
+    entry->objective = objectiveValue;
+    entry->hash = hash;
+    entry->numberDifferences = 0;
+    entry->index = NULL;
+    entry->value = NULL;
+    entry->dense = NULL;
+    storeSparse(entry, solution, reference_);
+    int where;
+    for (where = numberSolutions(); where > 0; where--) {
+        if (entries_[where-1]->objective <= objectiveValue)
+            break;
+    }
+    entries_.insert(entries_.begin() + where, entry);
+    hashTable_.insert(std::make_pair(hash, entry));
+    return where;
+}
+
+/* Set reference solution - existing solutions are stored again
+   relative to it. */
+void
+CbcSolutionPool::setReference(const double * solution, int numberColumns)
+{
+    if (numberColumns != numberColumns_) {
+        if (numberSolutions())
+            resize(numberColumns);
+        else
+            numberColumns_ = numberColumns;
+    }
+    double * newReference = CoinCopyOfArray(solution, numberColumns_);
+    if (reference_) {
+        double * temp = new double [numberColumns_];
+        for (int i = 0; i < numberSolutions(); i++) {
+            Entry * entry = entries_[i];
+            expand(entry, temp);
+            storeSparse(entry, temp, newReference);
+        }
+        delete [] temp;
+    }
+    delete [] reference_;
+    reference_ = newReference;
+}
+
+// Change number of columns - new ones are zero
+void
+CbcSolutionPool::resize(int numberColumns)
+{
+    if (numberColumns == numberColumns_)
+        return;
+    int n = CoinMin(numberColumns, numberColumns_);
+    if (reference_) {
+        double * temp = new double [numberColumns];
+        CoinMemcpyN(reference_, n, temp);
+        CoinZeroN(temp + n, numberColumns - n);
+        delete [] reference_;
+        reference_ = temp;
+    }
+    if (isHashColumn_) {
+        char * temp = new char [numberColumns];
+        CoinMemcpyN(isHashColumn_, n, temp);
+        memset(temp + n, hashAll_ ? 1 : 0, numberColumns - n);
+        delete [] isHashColumn_;
+        isHashColumn_ = temp;
+        numberHashColumns_ = 0;
+        for (int i = 0; i < numberColumns; i++) {
+            if (temp[i])
+                numberHashColumns_++;
+        }
+    }
+    for (int i = 0; i < numberSolutions(); i++) {
+        Entry * entry = entries_[i];
+        // new columns are zero as in reference so just drop any off end
+        int k = 0;
+        for (int j = 0; j < entry->numberDifferences; j++) {
+            if (entry->index[j] < numberColumns) {
+                entry->index[k] = entry->index[j];
+                entry->value[k++] = entry->value[j];
+            }
+        }
+        entry->numberDifferences = k;
+        delete [] entry->dense;
+        entry->dense = NULL;
+    }
+    numberColumns_ = numberColumns;
+    rebuildHash();
+}
+
+// Objective of solution (COIN_DBL_MAX if off end)
+double
+CbcSolutionPool::objectiveValue(int which) const
+{
+    if (which >= 0 && which < numberSolutions())
+        return entries_[which]->objective;
+    else
+        return COIN_DBL_MAX;
+}
+
+// Dense solution (NULL if off end)
+const double *
+CbcSolutionPool::solution(int which) const
+{
+    if (which >= 0 && which < numberSolutions()) {
+        Entry * entry = entries_[which];
+        if (!entry->dense) {
+            double * dense = new double [numberColumns_];
+            expand(entry, dense);
+            entry->dense = dense;
+        }
+        return entry->dense;
+    } else {
+        return NULL;
+    }
+}
+
+// Number of values which differ from reference
+int
+CbcSolutionPool::numberDifferences(int which) const
+{
+    assert (which >= 0 && which < numberSolutions());
+    return entries_[which]->numberDifferences;
+}
+
+// Columns which differ from reference
+const int *
+CbcSolutionPool::differenceIndices(int which) const
+{
+    assert (which >= 0 && which < numberSolutions());
+    return entries_[which]->index;
+}
+
+// Values which differ from reference
+const double *
+CbcSolutionPool::differenceValues(int which) const
+{
+    assert (which >= 0 && which < numberSolutions());
+    return entries_[which]->value;
+}
+
+/* For each column count in how many of first numberToUse solutions
+   the value differs from solution by more than tolerance. */
+void
+CbcSolutionPool::countDifferences(const double * solution, int numberToUse,
+                                  int * count, double tolerance) const
+{
+    CoinZeroN(count, numberColumns_);
+    numberToUse = CoinMin(numberToUse, numberSolutions());
+    if (numberToUse <= 0)
+        return;
+    // columns where reference itself differs
+    int * referenceDiffers = new int [numberColumns_];
+    int numberReferenceDiffers = 0;
+    for (int i = 0; i < numberColumns_; i++) {
+        if (fabs(reference_[i] - solution[i]) > tolerance)
+            referenceDiffers[numberReferenceDiffers++] = i;
+    }
+    int * mark = new int [numberColumns_];
+    for (int i = 0; i < numberColumns_; i++)
+        mark[i] = -1;
+    for (int k = 0; k < numberToUse; k++) {
+        const Entry * entry = entries_[k];
+        for (int i = 0; i < entry->numberDifferences; i++) {
+            int iColumn = entry->index[i];
+            mark[iColumn] = k;
+            if (fabs(entry->value[i] - solution[iColumn]) > tolerance)
+                count[iColumn]++;
+        }
+        for (int i = 0; i < numberReferenceDiffers; i++) {
+            int iColumn = referenceDiffers[i];
+            if (mark[iColumn] != k)
+                count[iColumn]++;
+        }
+    }
+    delete [] mark;
+    delete [] referenceDiffers;
+}
+
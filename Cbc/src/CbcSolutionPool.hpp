@@ -0,0 +1,181 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcSolutionPool_H
+#define CbcSolutionPool_H
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+/** Pool of extra (not best) solutions kept by CbcModel.
+
+    Solutions are kept sorted on objective (best first).  Each one is
+    stored sparsely as the values which differ from a reference solution
+    (normally the incumbent) so long runs with many similar solutions use
+    little memory.  The integer part of each solution is hashed into a
+    std::multimap so finding a solution which is already in the pool takes
+    O(log n) plus a full comparison of the integer part of any solutions
+    with the same hash.  A duplicate just keeps the better objective.
+
+    When the pool is full a new solution replaces the closest (in Hamming
+    distance on integer variables) worse solution if that is within
+    minimumDistance(), otherwise the worst solution - so the pool stays
+    diverse rather than filling up with copies.
+*/
+
+class CbcSolutionPool {
+
+public:
+
+    /// Default Constructor
+    CbcSolutionPool ();
+
+    /// Copy constructor
+    CbcSolutionPool ( const CbcSolutionPool &);
+
+    /// Assignment operator
+    CbcSolutionPool & operator=( const CbcSolutionPool& rhs);
+
+    /// Destructor
+    ~CbcSolutionPool ();
+
+    /// Delete all solutions (keeps maximum)
+    void clear();
+
+    /// Set maximum number of solutions kept (may delete worst)
+    void setMaximumSolutions(int value);
+    /// Maximum number of solutions kept
+    inline int maximumSolutions() const {
+        return maximumSolutions_;
+    }
+    /// Number of solutions in pool
+    inline int numberSolutions() const {
+        return static_cast<int> (entries_.size());
+    }
+    /// Number of columns in solutions
+    inline int numberColumns() const {
+        return numberColumns_;
+    }
+    /** Set minimum Hamming distance for a worse solution to be kept
+        when pool is full.  -1 (default) means max(2, 1% of integers) */
+    inline void setMinimumDistance(int value) {
+        minimumDistance_ = value;
+    }
+    /// Minimum Hamming distance (-1 automatic)
+    inline int minimumDistance() const {
+        return minimumDistance_;
+    }
+
+    /** Add a solution.  Integer variables are used for hashing and
+        diversity (if none then all columns are used).
+        Returns position (0 best) or -1 if not kept (duplicate with no
+        better objective or pool full with better solutions).
+    */
+    int addSolution(const double * solution, double objectiveValue,
+                    int numberColumns, int numberIntegers,
+                    const int * integerVariable);
+    /// Delete solution (0 best in pool)
+    void deleteSolution(int which);
+
+    /** Set reference solution - existing solutions are stored again
+        relative to it.  Normally called with new incumbent. */
+    void setReference(const double * solution, int numberColumns);
+    /// Reference solution (may be NULL)
+    inline const double * reference() const {
+        return reference_;
+    }
+    /// Change number of columns - new ones are zero
+    void resize(int numberColumns);
+
+    /// Objective of solution (COIN_DBL_MAX if off end)
+    double objectiveValue(int which) const;
+    /** Dense solution (NULL if off end).  Created on first use and kept
+        until solution deleted. */
+    const double * solution(int which) const;
+    /// Number of values which differ from reference
+    int numberDifferences(int which) const;
+    /// Columns which differ from reference
+    const int * differenceIndices(int which) const;
+    /// Values which differ from reference
+    const double * differenceValues(int which) const;
+
+    /** For each column count in how many of first numberToUse solutions
+        the value differs from solution by more than tolerance.
+        count must be numberColumns long and is zeroed here.
+        Work is proportional to stored differences (plus one pass
+        through solution) so heuristics can use this rather than
+        looking at dense solutions.
+    */
+    void countDifferences(const double * solution, int numberToUse,
+                          int * count, double tolerance = 1.0e-7) const;
+
+private:
+
+    /// One stored solution
+    struct Entry {
+        /// Objective value
+        double objective;
+        /// Hash of integer part
+        unsigned int hash;
+        /// Number of values differing from reference
+        int numberDifferences;
+        /// Columns differing from reference
+        int * index;
+        /// Values differing from reference
+        double * value;
+        /// Dense copy if asked for
+        double * dense;
+    };
+
+    void gutsOfCopy(const CbcSolutionPool & rhs);
+    void gutsOfDelete();
+    /// Free an entry
+    static void deleteEntry(Entry * entry);
+    /// Store solution in entry relative to reference
+    void storeSparse(Entry * entry, const double * solution,
+                     const double * reference);
+    /// Expand entry into dense array
+    void expand(const Entry * entry, double * solution) const;
+    /// Hash integer part of solution
+    unsigned int hashSolution(const double * solution) const;
+    /// Value used for hashing and distance
+    inline double roundedValue(double value) const {
+        return hashAll_ ? floor(value * 1.0e6 + 0.5) : floor(value + 0.5);
+    }
+    /// Set which columns are used for hashing (rehashes if changed)
+    void setHashColumns(int numberIntegers, const int * integerVariable);
+    /// Recompute all hash values
+    void rebuildHash();
+    /** Hamming distance on hashed columns between entry and dense
+        solution.  numberReferenceDiffers is distance from reference. */
+    int distance(const Entry * entry, const double * solution,
+                 int numberReferenceDiffers) const;
+    /// Remove entry from hash table
+    void removeHash(const Entry * entry);
+
+private:
+    /// Solutions in objective order
+    std::vector<Entry *> entries_;
+    /// Hash of integer part to solution
+    std::multimap<unsigned int, Entry *> hashTable_;
+    /// Reference solution
+    double * reference_;
+    /// Marks columns used for hashing and distance
+    char * isHashColumn_;
+    /// Number of columns used for hashing
+    int numberHashColumns_;
+    /// True if no integers so all columns hashed
+    bool hashAll_;
+    /// Number of columns
+    int numberColumns_;
+    /// Maximum number of solutions
+    int maximumSolutions_;
+    /// Minimum distance for diversity (-1 automatic)
+    int minimumDistance_;
+};
+
+#endif
+
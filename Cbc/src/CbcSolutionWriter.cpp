@@ -0,0 +1,352 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include "CbcConfig.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#ifdef CBC_THREAD
+#include <pthread.h>
+#endif
+
+#include "CbcMipStartIO.hpp"
+#include "CbcSolutionWriter.hpp"
+
+namespace {
+
+// Output buffer which goes out in large blocks
+class CbcWriteBuffer {
+public:
+    CbcWriteBuffer(FILE * fp) : fp_(fp), size_(0), error_(false) {}
+    ~CbcWriteBuffer() {
+        flush();
+    }
+    inline void add(const char * text, size_t length) {
+        if (size_ + length > sizeof(buffer_)) {
+            flush();
+            if (length > sizeof(buffer_)) {
+                error_ |= (fwrite(text, 1, length, fp_) != length);
+                return;
+            }
+        }
+        memcpy(buffer_ + size_, text, length);
+        size_ += length;
+    }
+    inline void add(const char * text) {
+        add(text, strlen(text));
+    }
+    inline void addPadded(const char * text, size_t width) {
+        size_t length = strlen(text);
+        add(text, length);
+        static const char blanks[] = "                                ";
+        while (length < width) {
+            size_t n = width - length;
+            if (n > sizeof(blanks) - 1)
+                n = sizeof(blanks) - 1;
+            add(blanks, n);
+            length += n;
+        }
+    }
+    void flush() {
+        if (size_) {
+            error_ |= (fwrite(buffer_, 1, size_, fp_) != size_);
+            size_ = 0;
+        }
+    }
+    inline bool error() const {
+        return error_;
+    }
+private:
+    FILE * fp_;
+    size_t size_;
+    bool error_;
+    char buffer_[1048576];
+};
+
+#ifdef CBC_THREAD
+// Background write
+struct CbcBackgroundWrite {
+    CbcSolutionWriter * writer;
+    std::string fileName;
+    FILE * fp;
+    // who started it (waitForAll only joins its own)
+    const void * owner;
+    pthread_t threadId;
+    // set by thread - nonzero if open, write or close failed
+    int returnCode;
+};
+// Writes not yet joined - guarded by backgroundMutex
+std::vector<CbcBackgroundWrite *> backgroundWrites;
+pthread_mutex_t backgroundMutex = PTHREAD_MUTEX_INITIALIZER;
+bool waitRegistered = false;
+
+void * doBackgroundWrite(void * voidInfo)
+{
+    CbcBackgroundWrite * info = reinterpret_cast<CbcBackgroundWrite *> (voidInfo);
+    int returnCode;
+    if (info->fp) {
+        returnCode = info->writer->write(info->fp);
+        if (info->fp != stdout && info->fp != stderr) {
+            if (fclose(info->fp))
+                returnCode = 1;
+        } else {
+            fflush(info->fp);
+        }
+    } else {
+        returnCode = info->writer->write(info->fileName);
+    }
+    delete info->writer;
+    info->writer = NULL;
+    // info is freed by whoever joins
+    info->returnCode = returnCode;
+    return NULL;
+}
+
+extern "C" void waitForWritersAtExit()
+{
+    CbcSolutionWriter::waitForAll(NULL);
+}
+#endif
+}
+
+// Default Constructor
+CbcSolutionWriter::CbcSolutionWriter (Format format)
+    : format_(format),
+      numberEntries_(0),
+      objectiveValue_(0.0),
+      flaggedPrefix_("** "),
+      normalPrefix_(""),
+      nameWidth_(8),
+      valueFormat_(" %15.8g         %15.8g\n")
+{
+}
+
+// Destructor
+CbcSolutionWriter::~CbcSolutionWriter ()
+{
+}
+
+// Format from file name
+CbcSolutionWriter::Format
+CbcSolutionWriter::formatFromName(const std::string & fileName)
+{
+    size_t length = fileName.size();
+    if (length > 4) {
+        std::string suffix = fileName.substr(length - 4);
+        if (suffix == ".csv")
+            return formatCsv;
+        else if (suffix == ".bin")
+            return formatBinary;
+    }
+    return formatText;
+}
+
+// Set text layout
+void
+CbcSolutionWriter::setTextLayout(const char * flaggedPrefix,
+                                 const char * normalPrefix,
+                                 int nameWidth, const char * valueFormat)
+{
+    flaggedPrefix_ = flaggedPrefix;
+    normalPrefix_ = normalPrefix;
+    nameWidth_ = nameWidth;
+    valueFormat_ = valueFormat;
+}
+
+// Add text
+void
+CbcSolutionWriter::addText(const char * text)
+{
+    Record record;
+    record.index = -1;
+    record.flagged = false;
+    record.hasString = true;
+    record.offset = strings_.size();
+    record.value = 0.0;
+    record.dual = 0.0;
+    strings_.insert(strings_.end(), text, text + strlen(text) + 1);
+    records_.push_back(record);
+}
+
+// Add an entry
+void
+CbcSolutionWriter::addEntry(int index, const char * name, double value,
+                            double dual, bool flagged)
+{
+    Record record;
+    record.index = index;
+    record.flagged = flagged;
+    record.hasString = (name != NULL);
+    record.offset = strings_.size();
+    record.value = value;
+    record.dual = dual;
+    if (name)
+        strings_.insert(strings_.end(), name, name + strlen(name) + 1);
+    records_.push_back(record);
+    numberEntries_++;
+}
+
+// Write to open file
+int
+CbcSolutionWriter::write(FILE * fp) const
+{
+    if (format_ == formatBinary)
+        return 1; // needs file name
+    return writeLines(fp);
+}
+
+// Write to file
+int
+CbcSolutionWriter::write(const std::string & fileName) const
+{
+    if (format_ == formatBinary)
+        return writeBinary(fileName);
+    FILE * fp = fopen(fileName.c_str(), "w");
+    if (!fp)
+        return 1;
+    int returnCode = writeLines(fp);
+    if (fclose(fp))
+        returnCode = 1;
+    return returnCode;
+}
+
+// Write text or csv
+int
+CbcSolutionWriter::writeLines(FILE * fp) const
+{
+    // buffer is big so not on stack
+    CbcWriteBuffer * buffer = new CbcWriteBuffer(fp);
+    char line[200];
+    if (format_ == formatCsv)
+        buffer->add("index,name,value,dual\n");
+    for (size_t i = 0; i < records_.size(); i++) {
+        const Record & record = records_[i];
+        const char * name = record.hasString ? &strings_[record.offset] : NULL;
+        if (record.index < 0) {
+            if (format_ == formatText)
+                buffer->add(name);
+        } else if (format_ == formatText) {
+            buffer->add(record.flagged ? flaggedPrefix_.c_str() : normalPrefix_.c_str());
+            sprintf(line, "%7d ", record.index);
+            buffer->add(line);
+            if (name)
+                buffer->addPadded(name, nameWidth_);
+            sprintf(line, valueFormat_.c_str(), record.value, record.dual);
+            buffer->add(line);
+        } else {
+            sprintf(line, "%d,", record.index);
+            buffer->add(line);
+            if (name)
+                buffer->add(name);
+            sprintf(line, ",%.15g,%.15g\n", record.value, record.dual);
+            buffer->add(line);
+        }
+    }
+    buffer->flush();
+    int returnCode = buffer->error() ? 1 : 0;
+    delete buffer;
+    return returnCode;
+}
+
+// Write binary
+int
+CbcSolutionWriter::writeBinary(const std::string & fileName) const
+{
+    std::vector<double> values;
+    std::vector<char> names;
+    values.reserve(numberEntries_);
+    for (size_t i = 0; i < records_.size(); i++) {
+        const Record & record = records_[i];
+        if (record.index < 0)
+            continue;
+        values.push_back(record.value);
+        if (record.hasString) {
+            const char * name = &strings_[record.offset];
+            names.insert(names.end(), name, name + strlen(name) + 1);
+        } else {
+            char name[20];
+            sprintf(name, "C%7.7d", record.index);
+            names.insert(names.end(), name, name + strlen(name) + 1);
+        }
+    }
+    return writeBinaryMIPStart(fileName.c_str(), static_cast<int>(values.size()),
+                               values.size() ? &values[0] : NULL,
+                               names.size() ? &names[0] : NULL, names.size(),
+                               objectiveValue_);
+}
+
+// Write in background thread
+void
+CbcSolutionWriter::writeInBackground(CbcSolutionWriter * writer,
+                                     const std::string & fileName, FILE * fp,
+                                     const void * owner)
+{
+#ifdef CBC_THREAD
+    CbcBackgroundWrite * info = new CbcBackgroundWrite;
+    info->writer = writer;
+    info->fileName = fileName;
+    info->fp = fp;
+    info->owner = owner;
+    info->returnCode = 0;
+    pthread_mutex_lock(&backgroundMutex);
+    if (!pthread_create(&info->threadId, NULL, doBackgroundWrite, info)) {
+        backgroundWrites.push_back(info);
+        if (!waitRegistered) {
+            // make sure files complete before process ends
+            atexit(waitForWritersAtExit);
+            waitRegistered = true;
+        }
+        pthread_mutex_unlock(&backgroundMutex);
+        return;
+    }
+    pthread_mutex_unlock(&backgroundMutex);
+    delete info;
+#endif
+    if (fp) {
+        writer->write(fp);
+        if (fp != stdout && fp != stderr)
+            fclose(fp);
+    } else {
+        writer->write(fileName);
+    }
+    delete writer;
+}
+
+// Wait for background writes
+int
+CbcSolutionWriter::waitForAll(const void * owner)
+{
+    int numberFailed = 0;
+#ifdef CBC_THREAD
+    // take ours off list so other callers can carry on
+    std::vector<CbcBackgroundWrite *> mine;
+    pthread_mutex_lock(&backgroundMutex);
+    size_t nKept = 0;
+    for (size_t i = 0; i < backgroundWrites.size(); i++) {
+        CbcBackgroundWrite * info = backgroundWrites[i];
+        if (!owner || info->owner == owner)
+            mine.push_back(info);
+        else
+            backgroundWrites[nKept++] = info;
+    }
+    backgroundWrites.resize(nKept);
+    pthread_mutex_unlock(&backgroundMutex);
+    for (size_t i = 0; i < mine.size(); i++) {
+        pthread_join(mine[i]->threadId, NULL);
+        if (mine[i]->returnCode)
+            numberFailed++;
+        delete mine[i];
+    }
+#endif
+    return numberFailed;
+}
@@ -0,0 +1,135 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcSolutionWriter_H
+#define CbcSolutionWriter_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/** Buffered writer for solution files.
+
+    Entries (index, name, value and dual) and lines of text are collected
+    first and then formatted into a large buffer which goes out with a few
+    big fwrites rather than an fprintf per field.  Everything is copied
+    in so the file can be written in a background thread while the
+    caller carries on (and waitForAll is called at exit).
+
+    Formats are
+    - text - lines as from solution command (text lines kept)
+    - csv - columnar with one header line index,name,value,dual
+    - binary - as readMIPStart binary format (values and name table)
+*/
+
+class CbcSolutionWriter {
+
+public:
+
+    /// Formats
+    enum Format {
+        formatText = 0,
+        formatCsv,
+        formatBinary
+    };
+
+    /// Default Constructor
+    CbcSolutionWriter (Format format = formatText);
+
+    /// Destructor
+    ~CbcSolutionWriter ();
+
+    /// Format from file name (.csv or .bin else text)
+    static Format formatFromName(const std::string & fileName);
+
+    /// Set format
+    inline void setFormat(Format format) {
+        format_ = format;
+    }
+    /// Format
+    inline Format format() const {
+        return format_;
+    }
+    /** Set text layout - prefixes for flagged (e.g. infeasible) and
+        other entries, width names are padded to and printf format
+        for value and dual (including newline) */
+    void setTextLayout(const char * flaggedPrefix, const char * normalPrefix,
+                       int nameWidth, const char * valueFormat);
+    /// Set objective value (for binary)
+    inline void setObjectiveValue(double value) {
+        objectiveValue_ = value;
+    }
+    /// Add text to be written as is (text format only)
+    void addText(const char * text);
+    /// Add an entry (name may be NULL)
+    void addEntry(int index, const char * name, double value, double dual,
+                  bool flagged = false);
+    /// Number of entries
+    inline int numberEntries() const {
+        return numberEntries_;
+    }
+
+    /// Write to open file (not closed) - returns 0 if OK
+    int write(FILE * fp) const;
+    /// Write to file - returns 0 if OK
+    int write(const std::string & fileName) const;
+
+    /** Write in a background thread if possible (else now).  Writer is
+        deleted afterwards.  If fp is given it is written to (and closed
+        unless stdout or stderr) otherwise fileName is opened.
+        owner (e.g. the model) is only used to match in waitForAll */
+    static void writeInBackground(CbcSolutionWriter * writer,
+                                  const std::string & fileName,
+                                  FILE * fp = NULL,
+                                  const void * owner = NULL);
+    /** Wait for background writes started with this owner (all if NULL)
+        to finish.  Returns number which failed to open or write */
+    static int waitForAll(const void * owner = NULL);
+
+private:
+    /// No copy
+    CbcSolutionWriter ( const CbcSolutionWriter &);
+    /// No assignment
+    CbcSolutionWriter & operator=( const CbcSolutionWriter& rhs);
+
+    /// Write text or csv
+    int writeLines(FILE * fp) const;
+    /// Write binary
+    int writeBinary(const std::string & fileName) const;
+
+private:
+    /// One entry or line of text (index -1)
+    struct Record {
+        int index;
+        bool flagged;
+        /// True if offset gives name or text
+        bool hasString;
+        /// Offset of name or text in strings_
+        size_t offset;
+        double value;
+        double dual;
+    };
+    /// Format
+    Format format_;
+    /// Entries and text
+    std::vector<Record> records_;
+    /// Names and text (null terminated)
+    std::vector<char> strings_;
+    /// Number of entries
+    int numberEntries_;
+    /// Objective value
+    double objectiveValue_;
+    /// Prefix for flagged entries
+    std::string flaggedPrefix_;
+    /// Prefix for other entries
+    std::string normalPrefix_;
+    /// Width names are padded to
+    int nameWidth_;
+    /// Format for value and dual
+    std::string valueFormat_;
+};
+
+#endif
+
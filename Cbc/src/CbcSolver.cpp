@@ -53,6 +53,12 @@
 #include "OsiChooseVariable.hpp"
 #include "OsiAuxInfo.hpp"
 #include "CbcMipStartIO.hpp"
+#include "CbcMpsImport.hpp"
+#include "CbcSnapshot.hpp"
+#include "CbcPreProcessCache.hpp"
+#include "CbcTrace.hpp"
+#include "CbcProgress.hpp"
+#include "CbcSolutionWriter.hpp"
 // for printing
 #ifndef CLP_OUTPUT_FORMAT
 #define CLP_OUTPUT_FORMAT %15.8g
@@ -238,6 +244,171 @@ extern int debugNumberColumns;
 #define IN_BRANCH_AND_BOUND (0x01000000|262144|128|1024|2048)
 //#define IN_BRANCH_AND_BOUND (0x01000000|262144|128)
 
+/*
+  Parameters only known to this driver.  They are added after those
+  from establishParams and use free values at the end of each range of
+  CbcOrClpParameterType so they are parsed and listed as usual.  All of
+  them are in this one block and in cbcDriverParameterTypes below -
+  addCbcParameters checks none of them is already taken.
+*/
+#ifndef CBC_DRIVER_PARAMETER_TYPES
+#define CBC_DRIVER_PARAMETER_TYPES
+static const CbcOrClpParameterType CBC_PARAM_DBL_PROGRESSINTERVAL =
+    static_cast<CbcOrClpParameterType> (97);
+static const CbcOrClpParameterType CBC_PARAM_DBL_MAXMEMORY =
+    static_cast<CbcOrClpParameterType> (98);
+static const CbcOrClpParameterType CBC_PARAM_INT_FASTMPS =
+    static_cast<CbcOrClpParameterType> (191);
+static const CbcOrClpParameterType CBC_PARAM_INT_CACHEMB =
+    static_cast<CbcOrClpParameterType> (192);
+static const CbcOrClpParameterType CBC_PARAM_INT_BACKGROUNDWRITE =
+    static_cast<CbcOrClpParameterType> (193);
+static const CbcOrClpParameterType CBC_PARAM_INT_WORKCLOCK =
+    static_cast<CbcOrClpParameterType> (194);
+static const CbcOrClpParameterType CBC_PARAM_INT_PINTHREADS =
+    static_cast<CbcOrClpParameterType> (195);
+static const CbcOrClpParameterType CBC_PARAM_ACTION_CACHEDIR =
+    static_cast<CbcOrClpParameterType> (391);
+static const CbcOrClpParameterType CBC_PARAM_ACTION_TRACE =
+    static_cast<CbcOrClpParameterType> (392);
+static const CbcOrClpParameterType CBC_PARAM_ACTION_PROGRESS =
+    static_cast<CbcOrClpParameterType> (393);
+static const CbcOrClpParameterType cbcDriverParameterTypes[] = {
+    CBC_PARAM_DBL_PROGRESSINTERVAL,
+    CBC_PARAM_DBL_MAXMEMORY,
+    CBC_PARAM_INT_FASTMPS,
+    CBC_PARAM_INT_CACHEMB,
+    CBC_PARAM_INT_BACKGROUNDWRITE,
+    CBC_PARAM_INT_WORKCLOCK,
+    CBC_PARAM_INT_PINTHREADS,
+    CBC_PARAM_ACTION_CACHEDIR,
+    CBC_PARAM_ACTION_TRACE,
+    CBC_PARAM_ACTION_PROGRESS
+};
+static const int numberCbcDriverParameters =
+    static_cast<int> (sizeof(cbcDriverParameterTypes) / sizeof(CbcOrClpParameterType));
+#endif
+
+static void addCbcParameters(int & numberParameters, CbcOrClpParam * parameters,
+                             int maximumParameters)
+{
+    // A new parameter in CbcOrClpParam may have taken one of our values
+    for (int i = 0; i < numberParameters; i++) {
+        CbcOrClpParameterType type = parameters[i].type();
+        for (int j = 0; j < numberCbcDriverParameters; j++) {
+            if (type == cbcDriverParameterTypes[j]) {
+                printf("Parameter %s already uses type %d - renumber driver parameters in CbcSolver.cpp\n",
+                       parameters[i].name().c_str(), static_cast<int> (type));
+                abort();
+            }
+        }
+    }
+    assert (numberParameters + numberCbcDriverParameters <= maximumParameters);
+    parameters[numberParameters++] =
+        CbcOrClpParam("fastMps", "Whether to use fast parallel MPS reader",
+                      0, 1, CBC_PARAM_INT_FASTMPS);
+    parameters[numberParameters-1].setLonghelp
+    (
+        "If 1 then import of a plain MPS file uses a memory mapped reader"
+        " which parses the COLUMNS section in threads (see threads).  Anything"
+        " it can not handle (including duplicate entries) goes to the normal"
+        " reader."
+    );
+    parameters[numberParameters-1].setIntValue(0);
+    parameters[numberParameters++] =
+        CbcOrClpParam("cacheDir!ectory", "Directory for cache of preprocessed models",
+                      CBC_PARAM_ACTION_CACHEDIR);
+    parameters[numberParameters-1].setLonghelp
+    (
+        "If set then preprocessed models are kept in this directory named by a"
+        " fingerprint of the model and preprocessing options.  When branchAndBound"
+        " sees the same model again preprocessing is skipped.  Least recently used"
+        " entries are deleted when the directory is bigger than cacheMB megabytes."
+        "  off switches the cache off."
+    );
+    parameters[numberParameters-1].setStringValue("off");
+    parameters[numberParameters++] =
+        CbcOrClpParam("cacheMB", "Maximum size of preprocess cache in megabytes",
+                      1, COIN_INT_MAX, CBC_PARAM_INT_CACHEMB);
+    parameters[numberParameters-1].setLonghelp
+    (
+        "When the cache directory (see cacheDirectory) is bigger than this"
+        " least recently used entries are deleted."
+    );
+    parameters[numberParameters-1].setIntValue(1024);
+    parameters[numberParameters++] =
+        CbcOrClpParam("backgroundW!rite", "Whether to write solution files in background",
+                      0, 1, CBC_PARAM_INT_BACKGROUNDWRITE);
+    parameters[numberParameters-1].setLonghelp
+    (
+        "If 1 then solution files (see solution and printingOptions) are formatted"
+        " and written by a thread so the next command can start.  Each file is"
+        " complete before the next one is started or the program exits."
+    );
+    parameters[numberParameters-1].setIntValue(0);
+    parameters[numberParameters++] =
+        CbcOrClpParam("traceF!ile", "File for trace of search activity",
+                      CBC_PARAM_ACTION_TRACE);
+    parameters[numberParameters-1].setLonghelp
+    (
+        "If set then phases of branchAndBound, nodes and thread waits are written"
+        " as a Chrome trace event file (chrome://tracing or Perfetto can show it)."
+        "  The file is finished when another is given or at the end.  off"
+        " switches tracing off."
+    );
+    parameters[numberParameters-1].setStringValue("off");
+    parameters[numberParameters++] =
+        CbcOrClpParam("progressF!ile", "File for machine readable progress of search",
+                      CBC_PARAM_ACTION_PROGRESS);
+    parameters[numberParameters-1].setLonghelp
+    (
+        "If set then branchAndBound writes a row every progressInterval seconds"
+        " with bound, incumbent, gap, nodes, iterations, memory and primal and dual"
+        " integrals.  The file is CSV if the name ends in .csv else JSON lines."
+        "  off switches progress rows off."
+    );
+    parameters[numberParameters-1].setStringValue("off");
+    parameters[numberParameters++] =
+        CbcOrClpParam("progressI!nterval", "Seconds between rows of progress file",
+                      1.0e-3, COIN_DBL_MAX, CBC_PARAM_DBL_PROGRESSINTERVAL);
+    parameters[numberParameters-1].setLonghelp
+    (
+        "Rows are written to progressFile this often (and at end of each search)."
+    );
+    parameters[numberParameters-1].setDoubleValue(1.0);
+    parameters[numberParameters++] =
+        CbcOrClpParam("maxMem!ory", "Maximum memory in megabytes for branch and bound",
+                      0.0, COIN_DBL_MAX, CBC_PARAM_DBL_MAXMEMORY);
+    parameters[numberParameters-1].setLonghelp
+    (
+        "If nonzero then as estimated memory of branchAndBound gets near this the"
+        " search is degraded (fewer cuts kept, depth first, no heuristics) and it"
+        " stops if it goes over.  0 leaves the limit on the model."
+    );
+    parameters[numberParameters-1].setDoubleValue(0.0);
+    parameters[numberParameters++] =
+        CbcOrClpParam("workC!lock", "Whether to measure time in deterministic work units",
+                      0, 1, CBC_PARAM_INT_WORKCLOCK);
+    parameters[numberParameters-1].setLonghelp
+    (
+        "If 1 then time limits and times in the node log of branchAndBound are in"
+        " work units (iterations, nodes, cut generator calls and heuristic runs"
+        " scaled by size of problem) instead of seconds so runs do not depend on"
+        " the machine.  0 leaves the setting on the model."
+    );
+    parameters[numberParameters-1].setIntValue(0);
+    parameters[numberParameters++] =
+        CbcOrClpParam("pinT!hreads", "Whether to pin threads to cpus",
+                      0, 1, CBC_PARAM_INT_PINTHREADS);
+    parameters[numberParameters-1].setLonghelp
+    (
+        "If 1 then threads of branchAndBound (see threads) are pinned to cpus,"
+        " filling one socket before the next, and their solvers are kept in memory"
+        " local to that socket.  Only on Linux.  0 leaves the setting on the model."
+    );
+    parameters[numberParameters-1].setIntValue(0);
+}
+
 /*
   CbcStopNow class definitions.
 */
@@ -527,10 +698,11 @@ CbcUser * CbcSolver::userFunction(const char * name) const
 }
 void CbcSolver::fillParameters()
 {
-    int maxParam = 200;
+    int maxParam = CBCMAXPARAMETERS + CBC_EXTRA_PARAMETERS;
     CbcOrClpParam * parameters = new CbcOrClpParam [maxParam];
     numberParameters_ = 0 ;
     establishParams(numberParameters_, parameters) ;
+    addCbcParameters(numberParameters_, parameters, maxParam);
     assert (numberParameters_ <= maxParam);
     parameters_ = new CbcOrClpParam [numberParameters_];
     int i;
@@ -1167,8 +1339,7 @@ int CbcMain1 (int argc, const char *argv[],
     return CbcMain1(argc, argv, model, dummyCallBack);
 }
 
-#ifdef CBC_THREAD_SAFE
-// Copies of some input decoding
+// Copies of some input decoding (used if thread safe)
 
 static std::string
 CoinReadGetCommand(int &whichArgument, int argc, const char *argv[])
@@ -1236,18 +1407,20 @@ CoinReadGetDoubleField(int &whichArgument, int argc, const char *argv[], int * v
   return value;
 }
 // Redefine all
-#define CoinReadGetCommand(x,y) CoinReadGetCommand(whichArgument,x,y)
-#define CoinReadGetString(x,y) CoinReadGetString(whichArgument,x,y)
-#define CoinReadGetIntField(x,y,z) CoinReadGetIntField(whichArgument,x,y,z)
-#define CoinReadGetDoubleField(x,y,z) CoinReadGetDoubleField(whichArgument,x,y,z)
-#endif
+#define CoinReadGetCommand(x,y) (threadSafe ? CoinReadGetCommand(whichArgument,x,y) : ::CoinReadGetCommand(x,y))
+#define CoinReadGetString(x,y) (threadSafe ? CoinReadGetString(whichArgument,x,y) : ::CoinReadGetString(x,y))
+#define CoinReadGetIntField(x,y,z) (threadSafe ? CoinReadGetIntField(whichArgument,x,y,z) : ::CoinReadGetIntField(x,y,z))
+#define CoinReadGetDoubleField(x,y,z) (threadSafe ? CoinReadGetDoubleField(whichArgument,x,y,z) : ::CoinReadGetDoubleField(x,y,z))
 // Default Constructor
 CbcSolverUsefulData::CbcSolverUsefulData()
 {
   totalTime_ = 0.0;
   noPrinting_ = true;
   useSignalHandler_ = false;
+  threadSafe_ = false;
+  initialPumpTune_ = -1;
   establishParams(numberParameters_,parameters_);
+  addCbcParameters(numberParameters_,parameters_,CBCMAXPARAMETERS+CBC_EXTRA_PARAMETERS);
 }
 
 /* Copy constructor .
@@ -1257,7 +1430,9 @@ CbcSolverUsefulData::CbcSolverUsefulData(const CbcSolverUsefulData & rhs)
   totalTime_ = rhs.totalTime_;
   noPrinting_ = rhs.noPrinting_;
   useSignalHandler_ = rhs.useSignalHandler_;
+  threadSafe_ = rhs.threadSafe_;
   numberParameters_ = rhs.numberParameters_;
+  initialPumpTune_ = rhs.initialPumpTune_;
   memcpy(parameters_,rhs.parameters_,sizeof(parameters_));
 }
 
@@ -1268,7 +1443,9 @@ CbcSolverUsefulData & CbcSolverUsefulData::operator=(const CbcSolverUsefulData&
     totalTime_ = rhs.totalTime_;
     noPrinting_ = rhs.noPrinting_;
     useSignalHandler_ = rhs.useSignalHandler_;
+    threadSafe_ = rhs.threadSafe_;
     numberParameters_ = rhs.numberParameters_;
+    initialPumpTune_ = rhs.initialPumpTune_;
     memcpy(parameters_,rhs.parameters_,sizeof(parameters_));
   }
   return *this;
@@ -1320,9 +1497,17 @@ int CbcMain1 (int argc, const char *argv[],
     bool useSignalHandler = parameterData.useSignalHandler_;
     CbcModel & model_ = model;
 #ifdef CBC_THREAD_SAFE
+    const bool threadSafe = true;
+#else
+    bool threadSafe = parameterData.threadSafe_;
+#endif
     // Initialize argument
     int whichArgument=1;
-#endif
+    // Local copies of file scope variables so calls can run in parallel
+    int localReadMode = 1;
+    int & CbcOrClpRead_mode = threadSafe ? localReadMode : ::CbcOrClpRead_mode;
+    int localPumpTune = parameterData.initialPumpTune_;
+    int & initialPumpTune = threadSafe ? localPumpTune : ::initialPumpTune;
 #ifdef CBC_USE_INITIAL_TIME
     if (model_.useElapsedTime())
       model_.setDblParam(CbcModel::CbcStartSeconds, CoinGetTimeOfDay());
@@ -1689,6 +1874,26 @@ int CbcMain1 (int argc, const char *argv[],
         std::string importPriorityFile = "";
         std::string debugFile = "";
         std::string printMask = "";
+        // snapshot of preprocessed model (read or to be written)
+        CbcSnapshot snapshot;
+        bool useSnapshot = false;
+        std::string snapshotFile = "";
+        // snapshot to use instead of preprocessing at next branchAndBound
+        std::string restoreSnapshotFile = "";
+        OsiSolverInterface * snapshotSolver = NULL;
+        OsiCuts snapshotCuts;
+        // cache of preprocessed models
+        CbcPreProcessCache preProcessCache;
+        // trace of search activity for chrome://tracing
+        CbcTrace searchTrace;
+        // progress rows (csv or json lines)
+        CbcProgress searchProgress;
+        std::string cacheKey = "";
+        CbcSnapshot cacheSnapshot;
+        OsiSolverInterface * cacheOriginal = NULL;
+        int cachePreProcess = 0;
+        // set if cached model could not be mapped back
+        bool solveWithoutCache = false;
         double * debugValues = NULL;
         int numberDebugValues = -1;
         int basisHasValues = 0;
@@ -1900,7 +2105,14 @@ int CbcMain1 (int argc, const char *argv[],
 #endif
         while (1) {
             // next command
-            field = CoinReadGetCommand(argc, argv);
+            bool noCache = solveWithoutCache;
+            solveWithoutCache = false;
+            if (noCache) {
+                // search again without cached preprocessed model
+                field = "branch";
+            } else {
+                field = CoinReadGetCommand(argc, argv);
+            }
             // Reset time
             time1 = CoinCpuTime();
 	    time1Elapsed = CoinGetTimeOfDay();
@@ -3437,6 +3649,20 @@ int CbcMain1 (int argc, const char *argv[],
 			    double * truncatedRhsLower=NULL;
 			    double * truncatedRhsUpper=NULL;
 			    int * newPriorities=NULL;
+                            if (cacheOriginal) {
+                                // last search used cache but found no usable solution
+                                delete cacheOriginal;
+                                cacheOriginal = NULL;
+                                cacheSnapshot.clear();
+                                preProcess = cachePreProcess;
+                            }
+                            if (cacheKey != "") {
+                                // last search did not get as far as saving
+                                cacheKey = "";
+                                if (snapshotFile != "")
+                                    remove(snapshotFile.c_str());
+                                snapshotFile = "";
+                            }
                             // Reduce printout
                             if (logLevel <= 1) {
                                 model_.solver()->setHintParam(OsiDoReducePrint, true, OsiHintTry);
@@ -3980,6 +4206,11 @@ int CbcMain1 (int argc, const char *argv[],
                             //time1 = time2;
                             double timeLeft = babModel_->getMaximumSeconds();
                             int numberOriginalColumns = babModel_->solver()->getNumCols();
+                            if (useSnapshot && type == CBC_PARAM_ACTION_BAB) {
+                                // already preprocessed - add priorities and cuts
+                                preProcess = 0;
+                                snapshot.setupModel(*babModel_);
+                            }
                             if (preProcess == 7) {
                                 // use strategy instead
                                 preProcess = 0;
@@ -4018,6 +4249,83 @@ int CbcMain1 (int argc, const char *argv[],
                                         limit*clpSolver->getObjSense())
                                     preProcess = 0;
                             }
+                            // information kept for resolveIncremental is in terms of model as given
+                            OsiSolverInterface * resolveOriginal = NULL;
+                            bool resolving = false;
+                            if (type == CBC_PARAM_ACTION_BAB && babModel_->keepForResolve()) {
+                                resolving = babModel_->resolving();
+                                // only for this search
+                                model_.setMoreSpecialOptions2(model_.moreSpecialOptions2() & ~2097152);
+                                if (resolving) {
+                                    // cuts, incumbent and pseudocosts are for unpreprocessed model
+                                    if (preProcess || restoreSnapshotFile != "") {
+                                        sprintf(generalPrint, "Preprocessing switched off for resolve");
+                                        printGeneralMessage(model_, generalPrint);
+                                    }
+                                    preProcess = 0;
+                                    restoreSnapshotFile = "";
+                                } else if (preProcess || restoreSnapshotFile != "") {
+                                    // search may be on preprocessed model
+                                    resolveOriginal = babModel_->solver()->clone();
+                                }
+                            }
+                            if (restoreSnapshotFile != "" && type == CBC_PARAM_ACTION_BAB) {
+                                // preprocessed model from snapshot (mapped back after search)
+                                if (!mipStartBefore.size() && !model_.bestSolution() &&
+                                        !cacheSnapshot.read(restoreSnapshotFile.c_str()) &&
+                                        cacheSnapshot.numberOriginalColumns() == numberOriginalColumns) {
+                                    delete cacheOriginal;
+                                    cacheOriginal = babModel_->solver()->clone();
+                                    cacheSnapshot.loadProblem(babModel_->solver());
+                                    babModel_->deleteObjects(false);
+                                    cacheSnapshot.setupModel(*babModel_);
+                                    babModel_->initialSolve();
+                                    // put back after search
+                                    cachePreProcess = preProcess;
+                                    preProcess = 0;
+                                    sprintf(generalPrint, "Preprocessed model with %d rows and %d columns taken from %s",
+                                            cacheSnapshot.numberRows(), cacheSnapshot.numberColumns(),
+                                            restoreSnapshotFile.c_str());
+                                } else {
+                                    cacheSnapshot.clear();
+                                    sprintf(generalPrint, "Unable to use preprocessed model in %s",
+                                            restoreSnapshotFile.c_str());
+                                }
+                                printGeneralMessage(model_, generalPrint);
+                                restoreSnapshotFile = "";
+                            } else if (preProcess && type == CBC_PARAM_ACTION_BAB &&
+                                    preProcessCache.active() && !mipStartBefore.size() &&
+                                    !model_.bestSolution()) {
+                                // see if preprocessed model is in cache
+                                preProcessCache.setMaximumSize(1024.0 * 1024.0 *
+                                                               parameters_[whichParam(CBC_PARAM_INT_CACHEMB, numberParameters_, parameters_)].intValue());
+                                cacheKey = CbcPreProcessCache::fingerprint(babModel_->solver(),
+                                           preProcess, tunePreProcess);
+                                std::string cacheFile = noCache ? "" : preProcessCache.lookup(cacheKey);
+                                if (cacheFile != "" && !cacheSnapshot.read(cacheFile.c_str()) &&
+                                        cacheSnapshot.numberOriginalColumns() == numberOriginalColumns) {
+                                    delete cacheOriginal;
+                                    cacheOriginal = babModel_->solver()->clone();
+                                    cacheSnapshot.loadProblem(babModel_->solver());
+                                    babModel_->deleteObjects(false);
+                                    cacheSnapshot.setupModel(*babModel_);
+                                    babModel_->initialSolve();
+                                    // put back after search
+                                    cachePreProcess = preProcess;
+                                    preProcess = 0;
+                                    cacheKey = "";
+                                    sprintf(generalPrint, "Preprocessed model with %d rows and %d columns taken from cache",
+                                            cacheSnapshot.numberRows(), cacheSnapshot.numberColumns());
+                                    printGeneralMessage(model_, generalPrint);
+                                } else if (snapshotFile == "") {
+                                    // save preprocessed model after search
+                                    snapshotFile = preProcessCache.temporaryName(cacheKey);
+                                    if (snapshotFile == "")
+                                        cacheKey = "";
+                                } else {
+                                    cacheKey = "";
+                                }
+                            }
 			    if (mipStartBefore.size())
 			      {
 				CbcModel tempModel=*babModel_;
@@ -4229,7 +4537,8 @@ int CbcMain1 (int argc, const char *argv[],
 #endif
 					if ((model_.moreSpecialOptions()&65536)!=0)
 					  process.setOptions(2+4+8); // no cuts
-					cbcPreProcessPointer = & process;
+					if (!threadSafe)
+					  cbcPreProcessPointer = & process;
 					int saveOptions = osiclp->getModelPtr()->moreSpecialOptions();
 					if ((model_.specialOptions()&16777216)!=0&&
 					    model_.getCutoff()>1.0e30) {
@@ -4250,7 +4559,8 @@ int CbcMain1 (int argc, const char *argv[],
 					}
                                     }
 #elif CBC_OTHER_SOLVER==1
-				    cbcPreProcessPointer = & process;
+				    if (!threadSafe)
+				      cbcPreProcessPointer = & process;
                                     solver2 = process.preProcessNonDefault(*saveSolver, translate[preProcess], numberPasses,
                                                                            tunePreProcess);
 #endif
@@ -4765,8 +5075,19 @@ int CbcMain1 (int argc, const char *argv[],
                                 babModel_->assignSolver(solver2);
                                 babModel_->setOriginalColumns(process.originalColumns(),
 							      truncateColumns);
+                                if (snapshotFile != "") {
+                                    // keep preprocessed model and collect global cuts
+                                    delete snapshotSolver;
+                                    snapshotSolver = solver2->clone();
+                                    snapshotCuts = OsiCuts();
+                                    if (!babModel_->getEventHandler()) {
+                                        CbcSnapshotEventHandler handler(&snapshotCuts);
+                                        babModel_->passInEventHandler(&handler);
+                                    }
+                                }
                                 babModel_->initialSolve();
-                                babModel_->setMaximumSeconds(timeLeft - (CoinCpuTime() - time2));
+                                if (!babModel_->useWorkClock())
+                                    babModel_->setMaximumSeconds(timeLeft - (CoinCpuTime() - time2));
                             }
                             // now tighten bounds
                             if (!miplib) {
@@ -5388,7 +5709,9 @@ int CbcMain1 (int argc, const char *argv[],
 #endif
                             // probably faster to use a basis to get integer solutions
                             babModel_->setSpecialOptions(babModel_->specialOptions() | 2);
-                            currentBranchModel = babModel_;
+                            // only needed (and only safe) if signal handler
+                            if (useSignalHandler)
+                                currentBranchModel = babModel_;
                             //OsiSolverInterface * strengthenedModel=NULL;
                             if (type == CBC_PARAM_ACTION_BAB ||
                                     type == CBC_PARAM_ACTION_MIPLIB) {
@@ -6556,6 +6879,21 @@ int CbcMain1 (int argc, const char *argv[],
                                     babModel_->addCutGenerator(&storedAmpl, 1, "Stored");
                                 }
 #endif
+                                if (searchTrace.isOpen()) {
+                                    // spans from all threads go to trace
+                                    babModel_->profile().setTrace(&searchTrace, 0);
+                                }
+                                if (searchProgress.isOpen()) {
+                                    searchProgress.setInterval(parameters_[whichParam(CBC_PARAM_DBL_PROGRESSINTERVAL, numberParameters_, parameters_)].doubleValue());
+                                    babModel_->setProgress(&searchProgress);
+                                }
+                                double maximumMemory = parameters_[whichParam(CBC_PARAM_DBL_MAXMEMORY, numberParameters_, parameters_)].doubleValue();
+                                if (maximumMemory > 0.0)
+                                    babModel_->setMaximumMemory(maximumMemory);
+                                if (parameters_[whichParam(CBC_PARAM_INT_WORKCLOCK, numberParameters_, parameters_)].intValue())
+                                    babModel_->setUseWorkClock(true);
+                                if (parameters_[whichParam(CBC_PARAM_INT_PINTHREADS, numberParameters_, parameters_)].intValue())
+                                    babModel_->setPinThreads(true);
                                 if (useSolution > 1) {
                                     // use hotstart to try and find solution
                                     CbcHeuristicPartial partial(*babModel_, 10000, useSolution);
@@ -6863,7 +7201,16 @@ int CbcMain1 (int argc, const char *argv[],
 				}
 				if (biLinearProblem)
 				  babModel_->setSpecialOptions(babModel_->specialOptions() &(~(512|32768)));
-                                babModel_->setMoreSpecialOptions2(parameters_[whichParam(CBC_PARAM_INT_MOREMOREMIPOPTIONS, numberParameters_, parameters_)].intValue());
+                                {
+                                  /* bits owned by model (keep for resolve, resolve
+                                     information kept, work clock, pin threads and
+                                     resolving)
+                                     stay as on model - rest come from parameter */
+                                  const int modelBits = 131072 | 262144 | 524288 | 1048576 | 2097152;
+                                  int more2 = parameters_[whichParam(CBC_PARAM_INT_MOREMOREMIPOPTIONS, numberParameters_, parameters_)].intValue();
+                                  babModel_->setMoreSpecialOptions2((babModel_->moreSpecialOptions2() & modelBits) |
+                                                                    (more2 & ~modelBits));
+                                }
 #ifdef COIN_HAS_NTY
 				{
 				  int jParam = whichParam(CBC_PARAM_STR_ORBITAL, 
@@ -6875,6 +7222,61 @@ int CbcMain1 (int argc, const char *argv[],
 				}
 #endif
                                 babModel_->branchAndBound(statistics);
+                                if (resolveOriginal) {
+                                    // kept cuts and pseudocosts are for preprocessed model
+                                    babModel_->setResolveOriginal(resolveOriginal);
+                                    resolveOriginal = NULL;
+                                    if (babModel_->keepForResolve()) {
+                                        sprintf(generalPrint, "Model was preprocessed so only incumbent kept for resolve");
+                                        printGeneralMessage(model_, generalPrint);
+                                    }
+                                }
+                                if (cacheOriginal && babModel_->bestSolution()) {
+                                    // check solution can be mapped back before trusting cache
+                                    std::vector<double> mapped(cacheOriginal->getNumCols() + 1);
+                                    if (cacheSnapshot.postSolve(cacheOriginal, babModel_->bestSolution(),
+                                                                &mapped[0])) {
+                                        sprintf(generalPrint, "Unable to map cached solution back - solving again without cache");
+                                        printGeneralMessage(model_, generalPrint);
+                                        // throw away result - original model put back at next branchAndBound
+                                        babModel_->deleteSolutions();
+                                        babModel_->setMinimizationObjValue(COIN_DBL_MAX);
+                                        babModel_->setProblemStatus(2);
+                                        solveWithoutCache = true;
+                                    }
+                                }
+                                if (snapshotSolver) {
+                                    int returnCode =
+                                        CbcSnapshot::write(snapshotFile.c_str(), snapshotSolver,
+                                                           babModel_, numberOriginalColumns,
+                                                           &snapshotCuts,
+                                                           lengthName ? &columnNames : NULL,
+                                                           (cacheKey == "") ? model_.solver() : NULL);
+                                    if (cacheKey != "") {
+                                        // add to cache
+                                        if (!returnCode)
+                                            returnCode = preProcessCache.store(cacheKey, snapshotFile);
+                                        else
+                                            remove(snapshotFile.c_str());
+                                        if (!returnCode)
+                                            sprintf(generalPrint, "Preprocessed model added to cache as %s",
+                                                    preProcessCache.fileName(cacheKey).c_str());
+                                        else
+                                            sprintf(generalPrint, "Unable to add preprocessed model to cache");
+                                        cacheKey = "";
+                                    } else if (!returnCode) {
+                                        sprintf(generalPrint, "Snapshot of preprocessed model (%d cuts) saved on %s",
+                                                snapshotCuts.sizeRowCuts(), snapshotFile.c_str());
+                                    } else {
+                                        sprintf(generalPrint, "Unable to save snapshot on %s",
+                                                snapshotFile.c_str());
+                                    }
+                                    printGeneralMessage(model_, generalPrint);
+                                    delete snapshotSolver;
+                                    snapshotSolver = NULL;
+                                    snapshotCuts = OsiCuts();
+                                    snapshotFile = "";
+                                }
 				if (truncateColumns<babModel_->solver()->getNumCols()) {
 				  OsiSolverInterface * solverX = babModel_->solver();
 				  int numberColumns=solverX->getNumCols();
@@ -7060,7 +7462,8 @@ int CbcMain1 (int argc, const char *argv[],
                                 abort(); // can't get here
                                 //strengthenedModel = babModel_->strengthenedModel();
                             }
-                            currentBranchModel = NULL;
+                            if (useSignalHandler)
+                                currentBranchModel = NULL;
 #ifndef CBC_OTHER_SOLVER
                             osiclp = dynamic_cast< OsiClpSolverInterface*> (babModel_->solver());
                             if (debugFile == "createAfterPre" && babModel_->bestSolution()) {
@@ -7336,6 +7739,19 @@ int CbcMain1 (int argc, const char *argv[],
 #endif
                                     babModel_->assignSolver(saveSolver);
                                     memcpy(bestSolution, babModel_->solver()->getColSolution(), n*sizeof(double));
+                                } else if (cacheOriginal) {
+                                    // preprocessed model came from cache - map back
+                                    n = cacheOriginal->getNumCols();
+                                    bestSolution = new double [n];
+                                    if (cacheSnapshot.postSolve(cacheOriginal, babModel_->bestSolution(),
+                                                                bestSolution)) {
+                                        // checked after search so should not happen
+                                        memcpy(bestSolution, cacheOriginal->getColSolution(), n*sizeof(double));
+                                    }
+                                    babModel_->assignSolver(cacheOriginal);
+                                    cacheOriginal = NULL;
+                                    cacheSnapshot.clear();
+                                    preProcess = cachePreProcess;
                                 } else {
                                     n = babModel_->solver()->getNumCols();
                                     bestSolution = new double [n];
@@ -7468,6 +7884,7 @@ int CbcMain1 (int argc, const char *argv[],
                                 }
 #endif
 				delete saveSolver;
+                                delete resolveOriginal;
                                 delete [] bestSolution;
 				std::string statusName[] = {"", "Stopped on ", "Run abandoned", "", "", "User ctrl-c"};
 				std::string minor[] = {"Optimal solution found", "Linear relaxation infeasible", "Optimal solution found (within gap tolerance)", "node limit", "time limit", "user ctrl-c", "solution limit", "Linear relaxation unbounded", "Problem proven infeasible"};
@@ -7768,12 +8185,69 @@ int CbcMain1 (int argc, const char *argv[],
                         }
                         if (canOpen) {
                             int status;
+                            useSnapshot = false;
+                            restoreSnapshotFile = "";
+                            snapshot.clear();
 #ifndef CBC_OTHER_SOLVER
                             ClpSimplex * lpSolver = clpSolver->getModelPtr();
-                            if (!gmpl) {
-                                status = clpSolver->readMps(fileName.c_str(),
-                                                            keepImportNames != 0,
-                                                            allowImportErrors != 0);
+                            if (!gmpl && fileName != "-" &&
+                                    CbcSnapshot::isSnapshot(fileName.c_str())) {
+                                // preprocessed model saved earlier
+                                status = snapshot.read(fileName.c_str());
+                                if (!status && snapshot.hasOriginal()) {
+                                    /* original model - preprocessed one is used by
+                                       next branchAndBound and solution mapped back */
+                                    snapshot.loadOriginal(clpSolver);
+                                    std::vector<std::string> originalNames = snapshot.originalColumnNames();
+                                    if (keepImportNames && originalNames.size())
+                                        lpSolver->copyNames(snapshot.originalRowNames(), originalNames);
+                                    restoreSnapshotFile = fileName;
+                                    sprintf(generalPrint, "Snapshot has %d rows, %d columns and %d cuts (original model %d rows, %d columns)",
+                                            snapshot.numberRows(), snapshot.numberColumns(),
+                                            snapshot.numberCuts(), clpSolver->getNumRows(),
+                                            snapshot.numberOriginalColumns());
+                                    printGeneralMessage(model_, generalPrint);
+                                    snapshot.clear();
+                                } else if (!status) {
+                                    // no original so solution is for preprocessed model
+                                    snapshot.loadProblem(clpSolver);
+                                    std::vector<std::string> snapshotNames = snapshot.columnNames();
+                                    if (keepImportNames && snapshotNames.size())
+                                        lpSolver->copyNames(snapshot.rowNames(), snapshotNames);
+                                    useSnapshot = true;
+                                    sprintf(generalPrint, "Snapshot of preprocessed model has %d rows, %d columns (from %d) and %d cuts",
+                                            snapshot.numberRows(), snapshot.numberColumns(),
+                                            snapshot.numberOriginalColumns(),
+                                            snapshot.numberCuts());
+                                    printGeneralMessage(model_, generalPrint);
+                                }
+                            } else if (!gmpl) {
+                                // fast (threaded) reader if wanted
+                                CbcMpsImport fastImport;
+                                status = -1;
+                                if (parameters_[whichParam(CBC_PARAM_INT_FASTMPS, numberParameters_, parameters_)].intValue()) {
+                                    int numberThreads =
+                                        parameters_[whichParam(CBC_PARAM_INT_THREADS, numberParameters_, parameters_)].intValue() % 100;
+                                    status = fastImport.readMps(fileName.c_str(), numberThreads,
+                                                                keepImportNames != 0);
+                                }
+                                if (!status) {
+                                    fastImport.assignProblem(clpSolver);
+                                    if (keepImportNames)
+                                        lpSolver->copyNames(fastImport.rowNames(),
+                                                            fastImport.columnNames());
+                                    sprintf(generalPrint, "Problem %s has %d rows, %d columns (%d integer) and %d elements",
+                                            fastImport.problemName().c_str(),
+                                            fastImport.numberRows(), fastImport.numberColumns(),
+                                            fastImport.numberIntegers(),
+                                            static_cast<int> (fastImport.numberElements()));
+                                    printGeneralMessage(model_, generalPrint);
+                                } else {
+                                    // not handled - use CoinMpsIO
+                                    status = clpSolver->readMps(fileName.c_str(),
+                                                                keepImportNames != 0,
+                                                                allowImportErrors != 0);
+                                }
                             } else if (gmpl > 0) {
                                 status = lpSolver->readGMPL(fileName.c_str(),
                                                             (gmpl == 2) ? gmplData.c_str() : NULL,
@@ -7814,7 +8288,7 @@ int CbcMain1 (int argc, const char *argv[],
                                 totalTime += time2 - time1;
                                 time1 = time2;
                                 // Go to canned file if just input file
-                                if (CbcOrClpRead_mode == 2 && argc == 2) {
+                                if (CbcOrClpRead_mode == 2 && argc == 2 && !threadSafe) {
                                     // only if ends .mps
                                     char * find = const_cast<char *>(strstr(fileName.c_str(), ".mps"));
                                     if (find && find[4] == '\0') {
@@ -8715,6 +9189,15 @@ int CbcMain1 (int argc, const char *argv[],
                         } else {
                             fileName = directory + field;
                         }
+                        if (fileName.size() > 5 &&
+                                fileName.substr(fileName.size() - 5) == ".snap") {
+                            // preprocessed model - written at next branchAndBound
+                            snapshotFile = fileName;
+                            sprintf(generalPrint, "Snapshot of preprocessed model will be saved on %s by next branchAndBound",
+                                    fileName.c_str());
+                            printGeneralMessage(model_, generalPrint);
+                            break;
+                        }
                         FILE *fp = fopen(fileName.c_str(), "wb");
                         if (fp) {
                             // can open - lets go for it
@@ -8803,6 +9286,14 @@ int CbcMain1 (int argc, const char *argv[],
 			  sprintf(generalPrint, "Unable to open file %s",fileName.c_str());
 			  printGeneralMessage(model_,generalPrint);
                         }
+                        if (canOpen && CbcSnapshot::isSnapshot(fileName.c_str())) {
+                            // preprocessed model for current model - used at next branchAndBound
+                            restoreSnapshotFile = fileName;
+                            sprintf(generalPrint, "Preprocessed model in %s will be used by next branchAndBound",
+                                    fileName.c_str());
+                            printGeneralMessage(model_, generalPrint);
+                            break;
+                        }
                         if (canOpen) {
                             int status = lpSolver->restoreModel(fileName.c_str());
                             if (!status) {
@@ -8864,6 +9355,46 @@ int CbcMain1 (int argc, const char *argv[],
                         }
                     }
                     break;
+                    case CBC_PARAM_ACTION_CACHEDIR: {
+                        std::string name = CoinReadGetString(argc, argv);
+                        if (name != "EOL") {
+                            parameters_[iParam].setStringValue(name);
+                            preProcessCache.setDirectory(name != "off" ? name : "");
+                        } else {
+                            parameters_[iParam].printString();
+                        }
+                    }
+                    break;
+                    case CBC_PARAM_ACTION_TRACE: {
+                        std::string name = CoinReadGetString(argc, argv);
+                        if (name != "EOL") {
+                            parameters_[iParam].setStringValue(name);
+                            if (name == "off") {
+                                searchTrace.close();
+                            } else if (searchTrace.open(name.c_str())) {
+                                sprintf(generalPrint, "Unable to open trace file %s", name.c_str());
+                                printGeneralMessage(model_, generalPrint);
+                            }
+                        } else {
+                            parameters_[iParam].printString();
+                        }
+                    }
+                    break;
+                    case CBC_PARAM_ACTION_PROGRESS: {
+                        std::string name = CoinReadGetString(argc, argv);
+                        if (name != "EOL") {
+                            parameters_[iParam].setStringValue(name);
+                            if (name == "off") {
+                                searchProgress.close();
+                            } else if (searchProgress.open(name.c_str())) {
+                                sprintf(generalPrint, "Unable to open progress file %s", name.c_str());
+                                printGeneralMessage(model_, generalPrint);
+                            }
+                        } else {
+                            parameters_[iParam].printString();
+                        }
+                    }
+                    break;
                     case CLP_PARAM_ACTION_DIRSAMPLE: {
                         std::string name = CoinReadGetString(argc, argv);
                         if (name != "EOL") {
@@ -9227,6 +9758,52 @@ clp watson.mps -\nscaling off\nprimalsimplex"
                                 } else {
                                     fileName = directory + field;
                                 }
+                                // only one background write at a time
+                                int numberFailed = CbcSolutionWriter::waitForAll(&model_);
+                                if (numberFailed) {
+                                    sprintf(generalPrint, "%d background solution write%s failed",
+                                            numberFailed, numberFailed > 1 ? "s" : "");
+                                    printGeneralMessage(model_, generalPrint);
+                                }
+                                CbcSolutionWriter::Format solutionFormat =
+                                    CbcSolutionWriter::formatFromName(fileName);
+                                if (type == CLP_PARAM_ACTION_SOLUTION && !append &&
+                                        solutionFormat != CbcSolutionWriter::formatText) {
+                                    // compact formats - nonzeros unless all
+                                    CbcSolutionWriter * writer =
+                                        new CbcSolutionWriter(solutionFormat);
+                                    int numberColumns = clpSolver->getNumCols();
+                                    const double * primalColumnSolution =
+                                        clpSolver->getColSolution();
+                                    const double * dualColumnSolution =
+                                        clpSolver->getReducedCost();
+                                    char name[20];
+                                    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+                                        double value = primalColumnSolution[iColumn];
+                                        if (printMode != 4 && (fabs(value) < 1.0e-8 ||
+                                                               (printMode == 1 && !clpSolver->isInteger(iColumn))))
+                                            continue;
+                                        if (!lengthName)
+                                            sprintf(name, "C%7.7d", iColumn);
+                                        writer->addEntry(iColumn, lengthName ?
+                                                         columnNames[iColumn].c_str() : name,
+                                                         value, dualColumnSolution[iColumn]);
+                                    }
+                                    writer->setObjectiveValue(clpSolver->getObjValue());
+                                    sprintf(generalPrint, "Writing %d values to %s",
+                                            writer->numberEntries(), fileName.c_str());
+                                    printGeneralMessage(model_, generalPrint);
+                                    if (parameters_[whichParam(CBC_PARAM_INT_BACKGROUNDWRITE, numberParameters_, parameters_)].intValue()) {
+                                        CbcSolutionWriter::writeInBackground(writer, fileName, NULL, &model_);
+                                    } else {
+                                        if (writer->write(fileName)) {
+                                            sprintf(generalPrint, "Unable to write file %s", fileName.c_str());
+                                            printGeneralMessage(model_, generalPrint);
+                                        }
+                                        delete writer;
+                                    }
+                                    break;
+                                }
 				if (!append)
 				  fp = fopen(fileName.c_str(), "w");
 				else
@@ -9685,12 +10262,15 @@ clp watson.mps -\nscaling off\nprimalsimplex"
 				sprintf(printFormat," %s         %s\n",
 					CLP_QUOTE(CLP_OUTPUT_FORMAT),
 					CLP_QUOTE(CLP_OUTPUT_FORMAT));
+                                // lines are buffered and written at end
+                                CbcSolutionWriter * writer = new CbcSolutionWriter();
+                                writer->setTextLayout("** ", "", static_cast<int>(lengthPrint),
+                                                      printFormat);
                                 if (printMode > 2 && printMode < 5) {
                                     for (iRow = 0; iRow < numberRows; iRow++) {
                                         int type = printMode - 3;
                                         if (primalRowSolution[iRow] > rowUpper[iRow] + primalTolerance ||
                                                 primalRowSolution[iRow] < rowLower[iRow] - primalTolerance) {
-                                            fprintf(fp, "** ");
                                             type = 2;
                                         } else if (fabs(primalRowSolution[iRow]) > 1.0e-8) {
                                             type = 1;
@@ -9700,18 +10280,9 @@ clp watson.mps -\nscaling off\nprimalsimplex"
                                         if (doMask && !maskMatches(maskStarts, masks, rowNames[iRow]))
                                             type = 0;
                                         if (type) {
-                                            fprintf(fp, "%7d ", iRow);
-                                            if (lengthName) {
-                                                const char * name = rowNames[iRow].c_str();
-                                                size_t n = strlen(name);
-                                                size_t i;
-                                                for (i = 0; i < n; i++)
-                                                    fprintf(fp, "%c", name[i]);
-                                                for (; i < lengthPrint; i++)
-                                                    fprintf(fp, " ");
-                                            }
-                                            fprintf(fp, printFormat, primalRowSolution[iRow],
-                                                    dualRowSolution[iRow]);
+                                            writer->addEntry(iRow, lengthName ? rowNames[iRow].c_str() : NULL,
+                                                             primalRowSolution[iRow],
+                                                             dualRowSolution[iRow], type == 2);
                                         }
                                     }
                                 }
@@ -9726,16 +10297,14 @@ clp watson.mps -\nscaling off\nprimalsimplex"
                                 if (printMode != 2) {
                                     if (printMode == 5) {
                                         if (lengthName)
-                                            fprintf(fp, "name");
+                                            writer->addText("name,solution\n");
                                         else
-                                            fprintf(fp, "number");
-                                        fprintf(fp, ",solution\n");
+                                            writer->addText("number,solution\n");
                                     }
                                     for (iColumn = 0; iColumn < numberColumns; iColumn++) {
                                         int type = (printMode > 3) ? 1 : 0;
                                         if (primalColumnSolution[iColumn] > columnUpper[iColumn] + primalTolerance ||
                                                 primalColumnSolution[iColumn] < columnLower[iColumn] - primalTolerance) {
-                                            fprintf(fp, "** ");
                                             type = 2;
                                         } else if (fabs(primalColumnSolution[iColumn]) > 1.0e-8) {
                                             type = 1;
@@ -9751,21 +10320,15 @@ clp watson.mps -\nscaling off\nprimalsimplex"
                                             type = 0;
                                         if (type) {
                                             if (printMode != 5) {
-                                                fprintf(fp, "%7d ", iColumn);
-                                                if (lengthName) {
-                                                    const char * name = columnNames[iColumn].c_str();
-                                                    size_t n = strlen(name);
-                                                    size_t i;
-                                                    for (i = 0; i < n; i++)
-                                                        fprintf(fp, "%c", name[i]);
-                                                    for (; i < lengthPrint; i++)
-                                                        fprintf(fp, " ");
-                                                }
-                                                fprintf(fp, printFormat,
-                                                        primalColumnSolution[iColumn],
-                                                        dualColumnSolution[iColumn]);
+                                                writer->addEntry(iColumn,
+                                                                 lengthName ? columnNames[iColumn].c_str() : NULL,
+                                                                 primalColumnSolution[iColumn],
+                                                                 dualColumnSolution[iColumn],
+                                                                 type == 2);
                                             } else {
-                                                char temp[100];
+                                                char temp[104];
+                                                if (type == 2)
+                                                    writer->addText("** ");
                                                 if (lengthName) {
                                                     const char * name = columnNames[iColumn].c_str();
                                                     for (int i = 0; i < lengthName; i++)
@@ -9782,7 +10345,8 @@ clp watson.mps -\nscaling off\nprimalsimplex"
                                                     if (temp[i] != ' ')
                                                         temp[k++] = temp[i];
                                                 }
-                                                fprintf(fp, "%s\n", temp);
+                                                strcat(temp, "\n");
+                                                writer->addText(temp);
                                             }
                                         }
                                     }
@@ -9840,8 +10404,15 @@ clp watson.mps -\nscaling off\nprimalsimplex"
                                     }
                                     fprintf(fp, "};\n");
                                 }
-                                if (fp != stdout)
-                                    fclose(fp);
+                                if (fp != stdout && parameters_[whichParam(CBC_PARAM_INT_BACKGROUNDWRITE, numberParameters_, parameters_)].intValue()) {
+                                    // writer closes file
+                                    CbcSolutionWriter::writeInBackground(writer, fileName, fp, &model_);
+                                } else {
+                                    writer->write(fp);
+                                    delete writer;
+                                    if (fp != stdout)
+                                        fclose(fp);
+                                }
                                 if (masks) {
                                     delete [] maskStarts;
                                     for (int i = 0; i < maxMasks; i++)
@@ -10150,7 +10721,10 @@ void CbcMain0 (CbcModel  & model,
     parameters[whichParam(CBC_PARAM_DBL_INCREMENT, numberParameters, parameters)].setDoubleValue(model.getDblParam(CbcModel::CbcCutoffIncrement));
     parameters[whichParam(CBC_PARAM_INT_TESTOSI, numberParameters, parameters)].setIntValue(testOsiParameters);
     parameters[whichParam(CBC_PARAM_INT_FPUMPTUNE, numberParameters, parameters)].setIntValue(1003);
+#ifndef CBC_THREAD_SAFE
     initialPumpTune = 1003;
+#endif
+    parameterData.initialPumpTune_ = 1003;
 #ifdef CBC_THREAD
     parameters[whichParam(CBC_PARAM_INT_THREADS, numberParameters, parameters)].setIntValue(0);
 #endif
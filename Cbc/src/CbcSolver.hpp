@@ -236,6 +236,9 @@ private:
 };
 //#############################################################################
 
+/// Room for parameters CbcSolver.cpp adds to those from establishParams
+#define CBC_EXTRA_PARAMETERS 20
+
 /// Structure to hold useful arrays
 typedef struct {
     // Priorities
@@ -283,11 +286,15 @@ public:
     // For time
     double totalTime_;
     // Parameters
-    CbcOrClpParam parameters_[CBCMAXPARAMETERS];
+    CbcOrClpParam parameters_[CBCMAXPARAMETERS+CBC_EXTRA_PARAMETERS];
     // Printing
     bool noPrinting_;
     // Whether to use signal handler
     bool useSignalHandler_;
+    /* Keep all state in CbcMain1 local so calls can run in parallel.
+       Arguments are then only taken from argv (no stdin) - always
+       true if built with CBC_THREAD_SAFE */
+    bool threadSafe_;
     // Number of Parameters
     int numberParameters_;
     // Default pump tuning
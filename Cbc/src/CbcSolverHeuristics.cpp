@@ -1677,6 +1677,17 @@ int doHeuristics(CbcModel * model, int type, CbcOrClpParam* parameters_,
         model->setMaximumSavedSolutions(5);
         anyToDo = true;
     }
+    int more2 = parameters_[whichParam(CBC_PARAM_INT_MOREMOREMIPOPTIONS, numberParameters_, parameters_)].intValue();
+    if ((more2 & 32768) != 0 && kType == 1) {
+        // genetic improvement phase after incumbent
+        CbcHeuristicGenetic heuristic2b(*model);
+        heuristic2b.setHeuristicName("genetic");
+        heuristic2b.setNumberNodes(50);
+        model->addHeuristic(&heuristic2b);
+        if (model->maximumSavedSolutions() < heuristic2b.populationSize())
+            model->setMaximumSavedSolutions(heuristic2b.populationSize());
+        anyToDo = true;
+    }
     int heurSwitches = parameters_[whichParam(CBC_PARAM_INT_HOPTIONS, numberParameters_, parameters_)].intValue() % 100;
     if (heurSwitches) {
         for (int iHeur = 0; iHeur < model->numberHeuristics(); iHeur++) {
@@ -15,6 +15,7 @@
 #include <cassert>
 #include <cmath>
 #include <cfloat>
+#include <cstdio>
 
 #include "CbcEventHandler.hpp"
 
@@ -25,13 +26,20 @@
 #include "CbcHeuristic.hpp"
 #include "CbcCutGenerator.hpp"
 #include "CbcModel.hpp"
+#include "CbcTrace.hpp"
 #include "CbcFathom.hpp"
 #include "CbcSimpleIntegerDynamicPseudoCost.hpp"
 #include "ClpDualRowDantzig.hpp"
 #include "OsiAuxInfo.hpp"
 
 #include "CoinTime.hpp"
+#include "CoinSort.hpp"
 #ifdef CBC_THREAD
+#ifdef __linux__
+#include <sched.h>
+#endif
+// most cpus looked at when pinning threads
+#define CBC_MAX_CPUS 1024
 /// Thread functions
 static void * doNodesThread(void * voidInfo);
 static void * doCutsThread(void * voidInfo);
@@ -178,6 +186,13 @@ static double getTime()
       static_cast<double>(absTime2.tv_nsec);
     return time2;
 }
+// Add span to trace of model (if tracing)
+static void traceSpan(const CbcModel * model, const char * name,
+                      double start, double end)
+{
+    if (model && model->profile().trace())
+        model->profile().traceSpan(name, start, end);
+}
 // Timed wait in nanoseconds - if negative then seconds
 void
 CbcSpecificThread::timedWait(int time)
@@ -218,6 +233,19 @@ CbcSpecificThread::startThread(void * (*routine ) (void *), CbcThread * thread)
 #else
 #endif
 }
+// Pins calling thread to a cpu
+void
+CbcSpecificThread::pinToCpu(int cpu)
+{
+#if defined(CBC_PTHREAD) && defined(__linux__)
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#endif
+}
 // Exits thread (from master)
 int
 CbcSpecificThread::exit()
@@ -299,7 +327,9 @@ CbcThread::CbcThread()
         maxDeleteNode_(0),
         nodesThisTime_(0),
         iterationsThisTime_(0),
-        deterministic_(0)
+        deterministic_(0),
+        cpu_(-1),
+        socket_(0)
 {
 }
 void
@@ -348,10 +378,15 @@ CbcThread::setUsefulStuff (CbcModel * model, int deterministic, CbcModel * baseM
         thisModel_->setInfoInChild(-3, this);
         if (deterministic_ >= 0)
             thisModel_->moveToModel(baseModel, -1);
+        // if pinned say busy until thread has placed itself
+        if (cpu_ >= 0)
+            returnCode_ = 0;
         if (deterministic == -1)
             threadStuff_.startThread( doCutsThread, this);
         else
             threadStuff_.startThread( doNodesThread, this);
+        if (cpu_ >= 0)
+            wait(1, 0);
     }
 }
 /*
@@ -368,6 +403,7 @@ CbcThread::lockThread()
         timeWhenLocked_ = getTime();
         timeWaitingToLock_ += timeWhenLocked_ - time2;;
         numberTimesLocked_++;
+        traceSpan(thisModel_, "waiting on lock", time2, timeWhenLocked_);
 #ifdef THREAD_DEBUG
         lockCount_ ++;
 #if THREAD_DEBUG>1
@@ -396,6 +432,7 @@ CbcThread::unlockThread()
         double time2 = getTime();
         timeLocked_ += time2 - timeWhenLocked_;
         numberTimesUnlocked_++;
+        traceSpan(thisModel_, "locked", timeWhenLocked_, time2);
 #ifdef THREAD_DEBUG
 #if THREAD_DEBUG>1
         if (threadNumber_ == -1)
@@ -460,8 +497,10 @@ CbcThread::waitThread()
     while (returnCode_) {
         threadStuff_.timedWait(-10); // 10 seconds
     }
-    timeWaitingToStart_ += getTime() - time;
+    double time2 = getTime();
+    timeWaitingToStart_ += time2 - time;
     numberTimesWaitingToStart_++;
+    traceSpan(thisModel_, "waiting for work", time, time2);
 }
 // Just wait for so many nanoseconds
 void
@@ -517,6 +556,44 @@ CbcThread::exitThread()
 {
     threadStuff_.exitThread();
 }
+/* Fills cpu (and socket) with cpus this process may use, sorted so
+   those on one socket come together.  Returns number (0 if not known) */
+static int
+availableCpus(int * cpu, int * socket, int maximum)
+{
+    int n = 0;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set))
+        return 0;
+    for (int i = 0; i < CPU_SETSIZE && n < maximum; i++) {
+        if (!CPU_ISSET(i, &set))
+            continue;
+        char name[100];
+        sprintf(name, "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", i);
+        int id = 0;
+        FILE * fp = fopen(name, "r");
+        if (fp) {
+            if (fscanf(fp, "%d", &id) != 1)
+                id = 0;
+            fclose(fp);
+        }
+        cpu[n] = i;
+        socket[n] = id;
+        n++;
+    }
+    // sort on socket then cpu
+    int * key = new int [n];
+    for (int i = 0; i < n; i++)
+        key[i] = socket[i] * CPU_SETSIZE + cpu[i];
+    CoinSort_2(key, key + n, cpu);
+    for (int i = 0; i < n; i++)
+        socket[i] = key[i] / CPU_SETSIZE;
+    delete [] key;
+#endif
+    return n;
+}
 // Default constructor
 CbcBaseModel::CbcBaseModel()
         :
@@ -527,6 +604,7 @@ CbcBaseModel::CbcBaseModel()
         threadModel_(NULL),
         numberObjects_(0),
         saveObjects_(NULL),
+        lastSocket_(0),
         defaultParallelIterations_(400),
         defaultParallelNodes_(2)
 {
@@ -540,6 +618,7 @@ CbcBaseModel::CbcBaseModel (CbcModel & model,  int type)
         threadModel_(NULL),
         numberObjects_(0),
         saveObjects_(NULL),
+        lastSocket_(0),
         defaultParallelIterations_(400),
         defaultParallelNodes_(2)
 {
@@ -569,6 +648,15 @@ CbcBaseModel::CbcBaseModel (CbcModel & model,  int type)
         // we don't want a strategy object
         CbcStrategy * saveStrategy = model.strategy();
         model.setStrategy(NULL);
+        if (model.pinThreads()) {
+            // fill one socket before next (more threads than cpus wrap)
+            int * cpu = new int [2*CBC_MAX_CPUS];
+            int * socket = cpu + CBC_MAX_CPUS;
+            int numberCpus = availableCpus(cpu, socket, CBC_MAX_CPUS);
+            for (int i = 0; i < numberThreads_ && numberCpus; i++)
+                children_[i].setCpu(cpu[i%numberCpus], socket[i%numberCpus]);
+            delete [] cpu;
+        }
         for (int i = 0; i < numberThreads_; i++) {
             //threadModel_[i] = new CbcModel(model, true);
             threadModel_[i] = model. clone (true);
@@ -581,6 +669,14 @@ CbcBaseModel::CbcBaseModel (CbcModel & model,  int type)
             if (solver)
                 solver->setCbcModel(thisModel);
 #endif
+            CbcTrace * trace = model.profile().trace();
+            if (trace) {
+                // spans from thread i go on trace thread i+1
+                char name[20];
+                sprintf(name, "Thread %d", i);
+                trace->nameThread(i + 1, name);
+                threadModel_[i]->profile().setTrace(trace, i + 1);
+            }
             children_[i].setUsefulStuff(threadModel_[i], type_, &model,
                                         children_ + numberThreads_, mutex_main);
 #ifdef THREAD_DEBUG
@@ -674,6 +770,7 @@ CbcBaseModel::waitForThreadsInTree(int type)
                 children_[iThread].wait(1, 0);
                 assert(children_[iThread].returnCode() == 1);
                 threadModel_[iThread]->moveToModel(baseModel, 1);
+                lastSocket_ = children_[iThread].socket();
 #ifdef THREAD_PRINT
                 printf("off thread2 %d node %x\n", iThread, children_[iThread].node());
 #endif
@@ -713,6 +810,7 @@ CbcBaseModel::waitForThreadsInTree(int type)
                     unlockThread();
                     locked = false;
                     threadModel_[iThread]->moveToModel(baseModel, 1);
+                    lastSocket_ = children_[iThread].socket();
 #ifdef THREAD_PRINT
                     printf("off thread3 %d node %x\n", iThread, children_[iThread].node());
 #endif
@@ -763,12 +861,19 @@ CbcBaseModel::waitForThreadsInTree(int type)
         threadStats_[0]++;
         //need to think
         int iThread;
-        // Start one off if any available
+        // Start one off if any available - preferably on same socket as
+        // last one back as its new nodes are likely to be chosen
+        int firstAvailable = numberThreads_;
         for (iThread = 0; iThread < numberThreads_; iThread++) {
 	  if (children_[iThread].returnCode() == -1) {
-                break;
+                if (firstAvailable == numberThreads_)
+                    firstAvailable = iThread;
+                if (children_[iThread].socket() == lastSocket_)
+                    break;
 	  }
         }
+        if (iThread == numberThreads_)
+            iThread = firstAvailable;
         if (iThread < numberThreads_) {
             children_[iThread].setNode(node);
 #ifdef THREAD_PRINT
@@ -791,6 +896,7 @@ CbcBaseModel::waitForThreadsInTree(int type)
         unlockThread();
         if (iThread < numberThreads_) {
             threadModel_[iThread]->moveToModel(baseModel, 1);
+            lastSocket_ = children_[iThread].socket();
 #ifdef THREAD_PRINT
             printf("off thread4 %d node %x\n", iThread, children_[iThread].node());
 #endif
@@ -821,7 +927,9 @@ CbcBaseModel::waitForThreadsInTree(int type)
             while (!finished) {
                 double time = getTime();
                 children_[numberThreads_].wait(0, 0);
-                children_[numberThreads_].incrementTimeInThread(getTime() - time);
+                double time2 = getTime();
+                children_[numberThreads_].incrementTimeInThread(time2 - time);
+                traceSpan(baseModel, "waiting for threads", time, time2);
                 for (iThread = 0; iThread < numberThreads_; iThread++) {
                     if (children_[iThread].returnCode() > 0) {
                         finished = true;
@@ -834,6 +942,7 @@ CbcBaseModel::waitForThreadsInTree(int type)
             assert (iThread < numberThreads_);
             // move information to model
             threadModel_[iThread]->moveToModel(baseModel, 1);
+            lastSocket_ = children_[iThread].socket();
             anyLeft = 1;
 #ifdef THREAD_PRINT
             printf("off thread %d node %x\n", iThread, children_[iThread].node());
@@ -864,7 +973,9 @@ CbcBaseModel::waitForThreadsInTree(int type)
 	      if (children_[iThread].returnCode() == 0) { 
 		double time = getTime();
 		children_[numberThreads_].wait(0, 0);
-		children_[numberThreads_].incrementTimeInThread(getTime() - time);
+		double time2 = getTime();
+		children_[numberThreads_].incrementTimeInThread(time2 - time);
+		traceSpan(baseModel, "waiting for threads", time, time2);
 		finished = false;
 		children_[iThread].signal(); // unlock
 	      }
@@ -883,7 +994,9 @@ CbcBaseModel::waitForThreadsInTree(int type)
                 children_[i].signal();
                 double time = getTime();
                 children_[numberThreads_].wait(0, 0);
-                children_[numberThreads_].incrementTimeInThread(getTime() - time);
+                double time2 = getTime();
+                children_[numberThreads_].incrementTimeInThread(time2 - time);
+                traceSpan(baseModel, "waiting for threads", time, time2);
             }
             children_[i].lockFromMaster();
             threadModel_[i]->setNumberThreads(0); // say exit
@@ -914,6 +1027,10 @@ CbcBaseModel::waitForThreadsInTree(int type)
             baseModel->messageHandler()->printing(true) << children_[i].numberTimesLocked()
             << children_[i].timeLocked() << children_[i].timeWaitingToLock()
             << CoinMessageEol;
+            baseModel->profile().addTime(CbcProfile::threadWait,
+                                         children_[i].timeWaitingToStart() +
+                                         children_[i].timeWaitingToLock(),
+                                         children_[i].numberTimesLocked());
         }
         assert (children_[numberThreads_].numberTimesLocked() == children_[numberThreads_].numberTimesUnlocked());
         baseModel->messageHandler()->message(CBC_THREAD_STATS, baseModel->messages())
@@ -924,6 +1041,10 @@ CbcBaseModel::waitForThreadsInTree(int type)
         baseModel->messageHandler()->printing(true) << children_[numberThreads_].numberTimesLocked()
         << children_[numberThreads_].timeLocked() << children_[numberThreads_].timeWaitingToLock()
         << CoinMessageEol;
+        baseModel->profile().addTime(CbcProfile::threadWait,
+                                     children_[numberThreads_].timeInThread() +
+                                     children_[numberThreads_].timeWaitingToLock(),
+                                     children_[numberThreads_].numberTimesLocked());
         // delete models (here in case some point to others)
         for (i = 0; i < numberThreads_; i++) {
             // make sure handler will be deleted
@@ -1067,7 +1188,9 @@ CbcBaseModel::deterministicParallel()
 	finished=false;
     }
 #endif
-    children_[numberThreads_].incrementTimeInThread(getTime() - time);
+    double time2 = getTime();
+    children_[numberThreads_].incrementTimeInThread(time2 - time);
+    traceSpan(baseModel, "waiting for threads", time, time2);
     // Unmark marked
     for (int i = 0; i < nAffected; i++) {
         baseModel->walkback()[i]->unmark();
@@ -1128,11 +1251,24 @@ CbcBaseModel::setDantzigState()
         children_[i].setDantzigState(-1);
     }
 }
+/* Pins thread (if wanted) and then copies model's solvers so memory
+   is first touched by this thread i.e. on its NUMA node */
+static void placeThread(CbcThread * stuff)
+{
+    if (stuff->cpu() < 0)
+        return;
+    stuff->threadStuff_.pinToCpu(stuff->cpu());
+    if (stuff->deterministic() >= 0)
+        stuff->thisModel()->moveToModel(stuff->baseModel(), -2);
+    // say available
+    stuff->setReturnCode(-1);
+}
 static void * doNodesThread(void * voidInfo)
 {
     CbcThread * stuff = reinterpret_cast<CbcThread *> (voidInfo);
     CbcModel * thisModel = stuff->thisModel();
     CbcModel * baseModel = stuff->baseModel();
+    placeThread(stuff);
     while (true) {
         stuff->waitThread();
         //printf("start node %x\n",stuff->node);
@@ -1285,6 +1421,7 @@ static void * doCutsThread(void * voidInfo)
 {
     CbcThread * stuff = reinterpret_cast<CbcThread *> (voidInfo);
     CbcModel * thisModel =  stuff->thisModel();
+    placeThread(stuff);
     while (true) {
         stuff->waitThread();
         //printf("start node %x\n",stuff->node);
@@ -1459,6 +1596,10 @@ CbcModel::moveToModel(CbcModel * baseModel, int mode)
         numberIterations_ = baseModel->numberIterations_;
         numberFixedAtRoot_ = numberIterations_; // for statistics
         numberSolves_ = 0;
+        // carry on from clock of base
+        workScale_ = baseModel->workScale_;
+        workStart_ = countedWork();
+        extraWork_ = baseModel->workUnits();
         phase_ = baseModel->phase_;
         assert (!nextRowCut_);
         nodeCompare_ = baseModel->nodeCompare_;
@@ -1496,6 +1637,8 @@ CbcModel::moveToModel(CbcModel * baseModel, int mode)
 	  thisGlobal->addCutIfNotDuplicate(*baseGlobal->cut(i));
 	}
 	numberGlobalCutsIn_ = baseNumberCuts; 
+        // follow base if it has had to save memory
+        copyMemoryState(baseModel);
     } else if (mode == 1) {
         lockThread();
         CbcThread * stuff = reinterpret_cast<CbcThread *> (masterThread_);
@@ -1528,6 +1671,8 @@ CbcModel::moveToModel(CbcModel * baseModel, int mode)
         if (eventHappened_)
             baseModel->eventHappened_ = true;
         baseModel->numberNodes_++;
+        baseModel->treeEstimate_.add(treeEstimate_);
+        treeEstimate_.clear();
         baseModel->numberIterations_ +=
             numberIterations_ - numberFixedAtRoot_;
         baseModel->numberSolves_ += numberSolves_;
@@ -1563,6 +1708,7 @@ CbcModel::moveToModel(CbcModel * baseModel, int mode)
         baseModel->maximumDepthActual_ = CoinMax(baseModel->maximumDepthActual_, maximumDepthActual_);
         baseModel->numberDJFixed_ += numberDJFixed_;
         baseModel->numberStrongIterations_ += numberStrongIterations_;
+        baseModel->profile_.add(profile_);
         int i;
         for (i = 0; i < 3; i++)
             baseModel->strongInfo_[i] += strongInfo_[i];
@@ -1585,6 +1731,26 @@ CbcModel::moveToModel(CbcModel * baseModel, int mode)
             numberObjects_ = 0;
             object_ = NULL;
         }
+    } else if (mode == -2) {
+        // called by thread so copies are on its memory node
+        OsiSolverInterface * solver = solver_->clone();
+        delete solver_;
+        solver_ = solver;
+        solver_->passInMessageHandler(handler_);
+        if (continuousSolver_) {
+            solver = continuousSolver_->clone();
+            delete continuousSolver_;
+            continuousSolver_ = solver;
+            continuousSolver_->passInMessageHandler(handler_);
+        }
+        if (solverCharacteristics_)
+            solverCharacteristics_->setSolver(solver_);
+#ifdef COIN_HAS_CLP
+        CbcOsiSolver * clpSolver = dynamic_cast<CbcOsiSolver *>(solver_) ;
+        if (clpSolver)
+            clpSolver->setCbcModel(this);
+#endif
+        setPointers(solver_);
     } else if (mode == -1) {
         delete eventHandler_;
 	if ((moreSpecialOptions2_&32)==0||!baseModel->eventHandler_) {
@@ -1662,6 +1828,10 @@ CbcModel::moveToModel(CbcModel * baseModel, int mode)
         //numberNodes_ = baseModel->numberNodes_;
         //numberIterations_ = baseModel->numberIterations_;
         //numberFixedAtRoot_ = numberIterations_; // for statistics
+        // carry on from clock of base
+        workScale_ = baseModel->workScale_;
+        workStart_ = countedWork();
+        extraWork_ = baseModel->workUnits();
         phase_ = baseModel->phase_;
         assert (!nextRowCut_);
         delete nodeCompare_;
@@ -1685,6 +1855,7 @@ CbcModel::moveToModel(CbcModel * baseModel, int mode)
         for (int iObject = 0 ; iObject < numberObjects_ ; iObject++) {
             object_[iObject]->updateBefore(baseObject[iObject]);
         }
+        copyMemoryState(baseModel);
         //delete [] stuff->nodeCount;
         //stuff->nodeCount = new int [baseModel->maximumDepth_+1];
     } else if (mode == 11) {
@@ -1734,6 +1905,8 @@ CbcModel::moveToModel(CbcModel * baseModel, int mode)
                 baseModel->eventHappened_ = true;
             baseModel->numberNodes_ += stuff->nodesThisTime();
             baseModel->numberIterations_ += stuff->iterationsThisTime();
+            baseModel->treeEstimate_.add(treeEstimate_);
+            treeEstimate_.clear();
             double cutoff = baseModel->getCutoff();
             while (!tree_->empty()) {
                 CbcNode * node = tree_->bestNode(COIN_DBL_MAX) ;
@@ -1755,6 +1928,7 @@ CbcModel::moveToModel(CbcModel * baseModel, int mode)
                     baseModel->tree_->push(node);
                 } else {
                     delete node;
+                    baseModel->treeEstimate_.addPruned(1);
                 }
             }
             for (i = 0; i < stuff->nDeleteNode(); i++) {
@@ -1771,6 +1945,7 @@ int
 CbcModel::parallelCuts(CbcBaseModel * master, OsiCuts & theseCuts,
                        CbcNode * /*node*/, OsiCuts & slackCuts, int lastNumberCuts)
 {
+    CbcProfileTimer timer(profile_, CbcProfile::cutSeparation);
     /*
       Is it time to scan the cuts in order to remove redundant cuts? If so, set
       up to do it.
@@ -62,6 +62,8 @@ public:
     void timedWait(int time);
     /// Actually starts a thread
     void startThread(void * (*routine ) (void *), CbcThread * thread);
+    /// Pins calling thread to a cpu (if >= 0 and Linux)
+    void pinToCpu(int cpu);
     /// Exits thread (called from master) - return code should be zero
     int exit();
     /// Exits thread
@@ -288,6 +290,19 @@ public:
     inline bool locked() const {
         return locked_;
     }
+    /// Get cpu thread is pinned to (-1 if not)
+    inline int cpu() const {
+        return cpu_;
+    }
+    /// Get socket of cpu
+    inline int socket() const {
+        return socket_;
+    }
+    /// Set cpu to pin thread to (before starting) and its socket
+    inline void setCpu(int cpu, int socket) {
+        cpu_ = cpu;
+        socket_ = socket;
+    }
 
 public: // private:
     CbcSpecificThread threadStuff_;
@@ -314,6 +329,8 @@ public: // private:
     int nodesThisTime_;
     int iterationsThisTime_;
     int deterministic_;
+    int cpu_; // pinned to (-1 if not)
+    int socket_; // of cpu
 #ifdef THREAD_DEBUG
 public:
     int threadNumber_;
@@ -415,6 +432,8 @@ private:
     int numberObjects_;
     OsiObject ** saveObjects_;
     int threadStats_[6];
+    /// Socket of thread which last gave back nodes
+    int lastSocket_;
     int defaultParallelIterations_;
     int defaultParallelNodes_;
 };
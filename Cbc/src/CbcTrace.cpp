@@ -0,0 +1,121 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include "CbcConfig.h"
+
+#ifdef CBC_THREAD
+#include <pthread.h>
+#endif
+
+#include "CoinTime.hpp"
+#include "CbcTrace.hpp"
+
+// Default Constructor
+CbcTrace::CbcTrace ()
+    : fp_(NULL),
+      startTime_(0.0),
+      numberEvents_(0),
+      mutex_(NULL)
+{
+#ifdef CBC_THREAD
+    pthread_mutex_t * mutex = new pthread_mutex_t;
+    pthread_mutex_init(mutex, NULL);
+    mutex_ = mutex;
+#endif
+}
+
+// Destructor
+CbcTrace::~CbcTrace ()
+{
+    close();
+#ifdef CBC_THREAD
+    pthread_mutex_t * mutex = reinterpret_cast<pthread_mutex_t *>(mutex_);
+    pthread_mutex_destroy(mutex);
+    delete mutex;
+#endif
+}
+
+void
+CbcTrace::lock()
+{
+#ifdef CBC_THREAD
+    pthread_mutex_lock(reinterpret_cast<pthread_mutex_t *>(mutex_));
+#endif
+}
+
+void
+CbcTrace::unlock()
+{
+#ifdef CBC_THREAD
+    pthread_mutex_unlock(reinterpret_cast<pthread_mutex_t *>(mutex_));
+#endif
+}
+
+// Open file and start trace
+int
+CbcTrace::open(const char * fileName)
+{
+    close();
+    fp_ = fopen(fileName, "w");
+    if (!fp_)
+        return 1;
+    startTime_ = CoinGetTimeOfDay();
+    numberEvents_ = 0;
+    fprintf(fp_, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    nameThread(0, "Main thread");
+    return 0;
+}
+
+// Finish trace and close file
+void
+CbcTrace::close()
+{
+    lock();
+    if (fp_) {
+        fprintf(fp_, "\n]}\n");
+        fclose(fp_);
+        fp_ = NULL;
+    }
+    unlock();
+}
+
+// Give thread a name
+void
+CbcTrace::nameThread(int thread, const char * name)
+{
+    lock();
+    if (fp_) {
+        fprintf(fp_, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                "\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                numberEvents_ ? ",\n" : "", thread, name);
+        numberEvents_++;
+    }
+    unlock();
+}
+
+// Add span
+void
+CbcTrace::span(int thread, const char * name, double start, double end)
+{
+    // microseconds from start
+    double startMicro = 1.0e6 * (start - startTime_);
+    double duration = 1.0e6 * (end - start);
+    if (duration < 0.0)
+        duration = 0.0;
+    lock();
+    if (fp_) {
+        fprintf(fp_, "%s{\"name\":\"%s\",\"cat\":\"cbc\",\"ph\":\"X\",\"pid\":1,"
+                "\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                numberEvents_ ? ",\n" : "", name, thread, startMicro, duration);
+        numberEvents_++;
+    }
+    unlock();
+}
+
@@ -0,0 +1,66 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcTrace_H
+#define CbcTrace_H
+
+#include <cstdio>
+
+/** Writes spans of search activity as a Chrome trace event file
+    (chrome://tracing or Perfetto can show it).
+
+    Each span is a complete ("X") event on thread 0 (main) or
+    thread i+1 (thread model i).  Spans come from CbcProfileTimer
+    (so phases nest as in CbcProfile), nodes and waiting in CbcThread.
+    Writing is locked so all threads can share one trace.
+*/
+
+class CbcTrace {
+
+public:
+
+    /// Default Constructor
+    CbcTrace ();
+
+    /// Destructor (closes file)
+    ~CbcTrace ();
+
+    /// Open file and start trace - returns 0 if ok
+    int open(const char * fileName);
+    /// Finish trace and close file
+    void close();
+    /// True if file open
+    inline bool isOpen() const {
+        return fp_ != NULL;
+    }
+    /// Number of events written
+    inline int numberEvents() const {
+        return numberEvents_;
+    }
+
+    /// Give thread a name
+    void nameThread(int thread, const char * name);
+    /// Add span - times as CoinGetTimeOfDay
+    void span(int thread, const char * name, double start, double end);
+
+private:
+    /// Illegal
+    CbcTrace (const CbcTrace &);
+    CbcTrace & operator=(const CbcTrace &);
+    void lock();
+    void unlock();
+
+    /// File
+    FILE * fp_;
+    /// Time trace started
+    double startTime_;
+    /// Number of events written
+    int numberEvents_;
+    /// Mutex (if threads)
+    void * mutex_;
+};
+
+#endif
+
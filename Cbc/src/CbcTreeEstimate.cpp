@@ -0,0 +1,160 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include <cmath>
+
+#include "CoinHelperFunctions.hpp"
+#include "CbcTreeEstimate.hpp"
+
+// Default Constructor
+CbcTreeEstimate::CbcTreeEstimate ()
+{
+    clear();
+}
+
+// Zero all
+void
+CbcTreeEstimate::clear()
+{
+    numberEvaluated_ = 0;
+    numberLeaves_ = 0;
+    numberPruned_ = 0;
+    gapNodes_ = 0;
+    sumWeight_ = 0.0;
+    sumWeightedSize_ = 0.0;
+    for (int i = 0; i < 2; i++) {
+        anchorNodes_[i] = -1;
+        anchorSeen_[i] = 0;
+        anchorLeaves_[i] = 0;
+        anchorGap_[i] = 1.0;
+        anchorSeconds_[i] = 0.0;
+    }
+    backtrackNodes_ = -1.0;
+    leafFrequencyNodes_ = -1.0;
+    gapClosureNodes_ = -1.0;
+    totalNodes_ = -1.0;
+    remainingNodes_ = -1.0;
+    remainingSeconds_ = -1.0;
+}
+
+// Node evaluated at depth
+void
+CbcTreeEstimate::addNode(int depth, bool leaf)
+{
+    numberEvaluated_++;
+    if (leaf) {
+        numberLeaves_++;
+        // weight 2^-d times size 2^(d+1)-1
+        double weight = ldexp(1.0, -CoinMax(depth, 0));
+        sumWeight_ += weight;
+        sumWeightedSize_ += 2.0 - weight;
+    }
+}
+
+// Add in nodes counted by another
+void
+CbcTreeEstimate::add(const CbcTreeEstimate & rhs)
+{
+    numberEvaluated_ += rhs.numberEvaluated_;
+    numberLeaves_ += rhs.numberLeaves_;
+    numberPruned_ += rhs.numberPruned_;
+    sumWeight_ += rhs.sumWeight_;
+    sumWeightedSize_ += rhs.sumWeightedSize_;
+}
+
+// Update estimates
+void
+CbcTreeEstimate::estimate(int numberNodes, int numberOpen, double gap,
+                          double seconds)
+{
+    // move anchors so rates are over recent half (or so) of search
+    bool gapKnown = gap < 1.0;
+    int numberSeen = numberEvaluated_ + numberPruned_;
+    int numberLeaves = numberLeaves_ + numberPruned_;
+    if (anchorNodes_[1] < 0) {
+        for (int i = 0; i < 2; i++) {
+            anchorNodes_[i] = numberNodes;
+            anchorSeen_[i] = numberSeen;
+            anchorLeaves_[i] = numberLeaves;
+            anchorGap_[i] = gap;
+            anchorSeconds_[i] = seconds;
+        }
+    } else if (numberNodes >= 2 * anchorNodes_[1] + 100) {
+        anchorNodes_[0] = anchorNodes_[1];
+        anchorSeen_[0] = anchorSeen_[1];
+        anchorLeaves_[0] = anchorLeaves_[1];
+        anchorGap_[0] = anchorGap_[1];
+        anchorSeconds_[0] = anchorSeconds_[1];
+        anchorNodes_[1] = numberNodes;
+        anchorSeen_[1] = numberSeen;
+        anchorLeaves_[1] = numberLeaves;
+        anchorGap_[1] = gap;
+        anchorSeconds_[1] = seconds;
+    }
+    if (gapKnown && anchorGap_[0] >= 1.0) {
+        // first gap
+        anchorGap_[0] = gap;
+        anchorGap_[1] = gap;
+        gapNodes_ = numberNodes;
+    }
+    double atLeast = numberNodes + numberOpen;
+    backtrackNodes_ = -1.0;
+    if (sumWeight_ > 0.0)
+        backtrackNodes_ = CoinMax(sumWeightedSize_ / sumWeight_, atLeast);
+    // each node seen takes one off open and a branch adds two
+    leafFrequencyNodes_ = -1.0;
+    int seen = numberSeen - anchorSeen_[0];
+    int leaves = numberLeaves - anchorLeaves_[0];
+    if (seen <= 0) {
+        seen = numberSeen;
+        leaves = numberLeaves;
+    }
+    if (seen) {
+        double fraction = static_cast<double> (leaves) /
+                          static_cast<double> (seen);
+        if (fraction > 0.5)
+            leafFrequencyNodes_ = numberNodes + numberOpen / (2.0 * fraction - 1.0);
+    }
+    gapClosureNodes_ = -1.0;
+    if (gapKnown) {
+        double closed = anchorGap_[0] - gap;
+        int nodes = numberNodes - CoinMax(anchorNodes_[0], gapNodes_);
+        if (gap <= 0.0)
+            gapClosureNodes_ = atLeast;
+        else if (closed > 0.0 && nodes > 0)
+            gapClosureNodes_ = CoinMax(numberNodes + gap * nodes / closed, atLeast);
+    }
+    // geometric mean of those known
+    double sumLog = 0.0;
+    int numberKnown = 0;
+    double estimates[3] = {backtrackNodes_, leafFrequencyNodes_, gapClosureNodes_};
+    for (int i = 0; i < 3; i++) {
+        if (estimates[i] > 0.0) {
+            sumLog += log(estimates[i]);
+            numberKnown++;
+        }
+    }
+    totalNodes_ = -1.0;
+    remainingNodes_ = -1.0;
+    remainingSeconds_ = -1.0;
+    if (numberKnown) {
+        totalNodes_ = CoinMax(exp(sumLog / numberKnown), atLeast);
+        remainingNodes_ = totalNodes_ - numberNodes;
+        double elapsed = seconds - anchorSeconds_[0];
+        int nodes = numberNodes - anchorNodes_[0];
+        if (nodes <= 0 || elapsed <= 0.0) {
+            elapsed = seconds;
+            nodes = numberNodes;
+        }
+        if (nodes > 0)
+            remainingSeconds_ = remainingNodes_ * elapsed / nodes;
+    }
+}
+
@@ -0,0 +1,120 @@
+/* $Id$ */
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcTreeEstimate_H
+#define CbcTreeEstimate_H
+
+/** Online estimate of size of branch and bound tree.
+
+    Nodes are counted as they are evaluated (leaf if no children were
+    created - infeasible, cut off or integral) and three estimates of
+    the total number of nodes are made from them:
+
+    - weighted backtrack - each leaf at depth d would be the only leaf
+      at that depth in a binary tree of 2^(d+1)-1 nodes.  Estimates are
+      averaged with weight 2^-d (as a random dive would reach it).
+    - leaf frequency - each node seen takes one off the open nodes and
+      each branch adds two, so if a fraction f of recent nodes are leaves
+      (or pruned) the open nodes will be gone after open/(2f-1) more
+      (none if f <= 0.5 as the tree is still growing).
+    - gap closure - the rate the gap has closed per node since the
+      search was about half as old, extrapolated to zero gap.
+
+    The total is the geometric mean of those available (each at least
+    the nodes done plus open) and remaining time is remaining nodes at
+    the recent node rate.  All are -1.0 if not known.
+
+    Thread models count their own nodes and are added into the base model.
+*/
+
+class CbcTreeEstimate {
+
+public:
+
+    /// Default Constructor
+    CbcTreeEstimate ();
+
+    /// Zero all
+    void clear();
+    /// Node evaluated at depth - leaf if no children
+    void addNode(int depth, bool leaf);
+    /// Nodes pruned from tree without being evaluated
+    inline void addPruned(int number) {
+        numberPruned_ += number;
+    }
+    /// Add in nodes counted by another (thread)
+    void add(const CbcTreeEstimate & rhs);
+
+    /** Update estimates given nodes done, unevaluated nodes on tree,
+        relative gap (>= 1.0 if not known) and elapsed seconds */
+    void estimate(int numberNodes, int numberOpen, double gap,
+                  double seconds);
+
+    /// Estimated total nodes from weighted backtrack
+    inline double backtrackNodes() const {
+        return backtrackNodes_;
+    }
+    /// Estimated total nodes from leaf frequency
+    inline double leafFrequencyNodes() const {
+        return leafFrequencyNodes_;
+    }
+    /// Estimated total nodes from gap closure
+    inline double gapClosureNodes() const {
+        return gapClosureNodes_;
+    }
+    /// Estimated total nodes
+    inline double totalNodes() const {
+        return totalNodes_;
+    }
+    /// Estimated nodes remaining
+    inline double remainingNodes() const {
+        return remainingNodes_;
+    }
+    /// Estimated seconds remaining
+    inline double remainingSeconds() const {
+        return remainingSeconds_;
+    }
+    /// Number of nodes evaluated
+    inline int numberEvaluated() const {
+        return numberEvaluated_;
+    }
+    /// Number of leaves (evaluated)
+    inline int numberLeaves() const {
+        return numberLeaves_;
+    }
+
+private:
+    /// Nodes evaluated
+    int numberEvaluated_;
+    /// Leaves evaluated
+    int numberLeaves_;
+    /// Nodes pruned without evaluation
+    int numberPruned_;
+    /// Sum of 2^-d over leaves
+    double sumWeight_;
+    /// Sum of 2^-d * (2^(d+1)-1) over leaves
+    double sumWeightedSize_;
+    /// Nodes at older and newer anchor (rates are from older)
+    int anchorNodes_[2];
+    /// Nodes seen (evaluated or pruned) and leaves at anchors
+    int anchorSeen_[2];
+    int anchorLeaves_[2];
+    /// Gap at anchors (>= 1.0 if not known)
+    double anchorGap_[2];
+    /// Seconds at anchors
+    double anchorSeconds_[2];
+    /// Nodes when gap first known
+    int gapNodes_;
+    /// Estimates
+    double backtrackNodes_;
+    double leafFrequencyNodes_;
+    double gapClosureNodes_;
+    double totalNodes_;
+    double remainingNodes_;
+    double remainingSeconds_;
+};
+
+#endif
+
@@ -5,14 +5,25 @@
 
 #include <cmath>
 #include <cfloat>
+#include <cstring>
+#include <map>
+
+#include "CbcConfig.h"
+#ifdef CBC_THREAD
+#include <pthread.h>
+#endif
 
 #include "CoinPragma.hpp"
-//#include "CoinHelperFunctions.hpp"
-//#include "CoinPackedMatrix.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinPackedMatrix.hpp"
 #include "CoinTime.hpp"
 
 #include "CbcModel.hpp"
 #include "CbcBranchActual.hpp"
+#include "CbcEventHandler.hpp"
+#include "CbcIncumbentStream.hpp"
+#include "CbcSnapshot.hpp"
+#include "CbcSolver.hpp"
 
 #include "CoinMessageHandler.hpp"
 #include "OsiClpSolverInterface.hpp"
@@ -42,6 +53,179 @@ Cbc_ ## prop (Cbc_Model *m, int index, T val) \
 
 const int  VERBOSE = 0;
 
+namespace {
+// Parameters for each model (so settings do not leak from one to another)
+typedef std::map<const Cbc_Model *, CbcSolverUsefulData *> CbcParameterDataMap;
+CbcParameterDataMap parameterDataMap;
+#ifdef CBC_THREAD
+pthread_mutex_t parameterDataMutex = PTHREAD_MUTEX_INITIALIZER;
+#ifndef CBC_THREAD_SAFE
+// Without CBC_THREAD_SAFE CbcMain0 sets file scope defaults so one at a time
+pthread_mutex_t mainMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+#endif
+inline void lockMain()
+{
+#if defined(CBC_THREAD) && !defined(CBC_THREAD_SAFE)
+    pthread_mutex_lock(&mainMutex);
+#endif
+}
+inline void unlockMain()
+{
+#if defined(CBC_THREAD) && !defined(CBC_THREAD_SAFE)
+    pthread_mutex_unlock(&mainMutex);
+#endif
+}
+// Parameters for model (created if needed)
+CbcSolverUsefulData * parameterData(const Cbc_Model * model)
+{
+#ifdef CBC_THREAD
+    pthread_mutex_lock(&parameterDataMutex);
+#endif
+    CbcSolverUsefulData *& data = parameterDataMap[model];
+    if (!data) {
+        data = new CbcSolverUsefulData();
+        data->noPrinting_ = false;
+        // CbcMain1 keeps everything local so solves can run in parallel
+        data->threadSafe_ = true;
+    }
+    CbcSolverUsefulData * result = data;
+#ifdef CBC_THREAD
+    pthread_mutex_unlock(&parameterDataMutex);
+#endif
+    return result;
+}
+void deleteParameterData(const Cbc_Model * model)
+{
+#ifdef CBC_THREAD
+    pthread_mutex_lock(&parameterDataMutex);
+#endif
+    CbcParameterDataMap::iterator it = parameterDataMap.find(model);
+    if (it != parameterDataMap.end()) {
+        delete it->second;
+        parameterDataMap.erase(it);
+    }
+#ifdef CBC_THREAD
+    pthread_mutex_unlock(&parameterDataMutex);
+#endif
+}
+#ifdef CBC_THREAD
+// Solve running in its own thread
+struct CbcAsyncSolve {
+    Cbc_Model * model;
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    /// Copy of event handler model had before solve (put back by Cbc_wait)
+    CbcEventHandler * userHandler;
+    /// Progress from branch and bound (set in solve thread)
+    double bestBound;
+    double bestObjective;
+    int nodeCount;
+    /// Tree estimate at last node log (cleared before branch and bound)
+    CbcTreeEstimate estimate;
+    bool cancelled;
+    bool finished;
+    int status;
+};
+/* Event handler for asynchronous solve - publishes progress for
+   Cbc_poll and stops search if cancelled.  Events are passed on to
+   any handler the model already had. */
+class CbcAsyncEventHandler : public CbcEventHandler {
+public:
+    CbcAsyncEventHandler(CbcAsyncSolve * info, const CbcEventHandler * userHandler)
+        : CbcEventHandler(),
+          info_(info),
+          userHandler_(userHandler ? userHandler->clone() : NULL) {}
+    CbcAsyncEventHandler(const CbcAsyncEventHandler & rhs)
+        : CbcEventHandler(rhs),
+          info_(rhs.info_),
+          userHandler_(rhs.userHandler_ ? rhs.userHandler_->clone() : NULL) {}
+    virtual ~CbcAsyncEventHandler() {
+        delete userHandler_;
+    }
+    virtual CbcEventHandler * clone() const {
+        return new CbcAsyncEventHandler(*this);
+    }
+    virtual CbcAction event(CbcEvent whichEvent);
+private:
+    CbcAsyncEventHandler & operator=(const CbcAsyncEventHandler &);
+    CbcAsyncSolve * info_;
+    CbcEventHandler * userHandler_;
+};
+CbcEventHandler::CbcAction
+CbcAsyncEventHandler::event(CbcEvent whichEvent)
+{
+    CbcAction action = noAction;
+    if (userHandler_) {
+        userHandler_->setModel(model_);
+        action = userHandler_->event(whichEvent);
+    }
+    if (model_->parentModel())
+        return action; // sub branch and bound
+    pthread_mutex_lock(&info_->mutex);
+    // copies in worker threads still point at master model so only
+    // look at model if this is its own handler (values then consistent)
+    if (model_->getEventHandler() == this &&
+            (whichEvent == treeStatus || whichEvent == solution ||
+             whichEvent == heuristicSolution || whichEvent == endSearch)) {
+        info_->bestBound = model_->getBestPossibleObjValue();
+        info_->bestObjective = model_->getObjValue();
+        info_->nodeCount = model_->getNodeCount();
+        if (whichEvent == treeStatus || whichEvent == endSearch)
+            info_->estimate = model_->treeEstimate();
+    }
+    if (info_->cancelled && (whichEvent == node || whichEvent == treeStatus ||
+                             whichEvent == afterHeuristic))
+        action = stop;
+    pthread_mutex_unlock(&info_->mutex);
+    return action;
+}
+typedef std::map<const Cbc_Model *, CbcAsyncSolve *> CbcAsyncSolveMap;
+CbcAsyncSolveMap asyncSolveMap;
+// So call back can find its solve
+pthread_key_t asyncSolveKey;
+pthread_once_t asyncSolveKeyOnce = PTHREAD_ONCE_INIT;
+void makeAsyncSolveKey()
+{
+    pthread_key_create(&asyncSolveKey, NULL);
+}
+CbcAsyncSolve * findAsyncSolve(const Cbc_Model * model)
+{
+    CbcAsyncSolve * info = NULL;
+    pthread_mutex_lock(&parameterDataMutex);
+    CbcAsyncSolveMap::iterator it = asyncSolveMap.find(model);
+    if (it != asyncSolveMap.end())
+        info = it->second;
+    pthread_mutex_unlock(&parameterDataMutex);
+    return info;
+}
+#endif
+/* Call back from CbcMain1 - resets progress as branch and bound starts
+   for asynchronous solves and stops early if cancelled */
+int solveCallBack(CbcModel * currentSolver, int whereFrom)
+{
+    int returnCode = 0;
+#ifdef CBC_THREAD
+    pthread_once(&asyncSolveKeyOnce, makeAsyncSolveKey);
+    CbcAsyncSolve * info =
+        reinterpret_cast<CbcAsyncSolve *> (pthread_getspecific(asyncSolveKey));
+    if (info) {
+        pthread_mutex_lock(&info->mutex);
+        if (whereFrom == 3) {
+            info->bestBound = currentSolver->getBestPossibleObjValue();
+            info->bestObjective = currentSolver->getObjValue();
+            info->nodeCount = 0;
+            info->estimate.clear();
+        }
+        if (info->cancelled && whereFrom < 4)
+            returnCode = 1;
+        pthread_mutex_unlock(&info->mutex);
+    }
+#endif
+    return returnCode;
+}
+}
+
 // To allow call backs
 class Cbc_MessageHandler
             : public CoinMessageHandler {
@@ -221,6 +405,38 @@ Cbc_MessageHandler::setCallBack(cbc_callback callback)
 #include <stdio.h>
 #include <iostream>
 
+namespace {
+// For incumbent call backs
+struct CbcIncumbentInfo {
+    Cbc_Model * model;
+    cbc_incumbent_callback callBack;
+    void * userData;
+};
+typedef std::map<const Cbc_Model *, CbcIncumbentInfo *> CbcIncumbentInfoMap;
+CbcIncumbentInfoMap incumbentInfoMap;
+void incumbentCallBack(const CbcIncumbentDelta & delta, void * userData)
+{
+    CbcIncumbentInfo * info = reinterpret_cast<CbcIncumbentInfo *> (userData);
+    info->callBack(info->model, delta.numberChanged, delta.which, delta.values,
+                   delta.objectiveValue, delta.source, delta.seconds,
+                   info->userData);
+}
+void deleteIncumbentInfo(const Cbc_Model * model)
+{
+#ifdef CBC_THREAD
+    pthread_mutex_lock(&parameterDataMutex);
+#endif
+    CbcIncumbentInfoMap::iterator it = incumbentInfoMap.find(model);
+    if (it != incumbentInfoMap.end()) {
+        delete it->second;
+        incumbentInfoMap.erase(it);
+    }
+#ifdef CBC_THREAD
+    pthread_mutex_unlock(&parameterDataMutex);
+#endif
+}
+}
+
 #if defined(__MWERKS__)
 #pragma export on
 #endif
@@ -243,7 +459,10 @@ Cbc_newModel()
     OsiClpSolverInterface solver1;
     model->solver_    = &solver1;
     model->model_     = new CbcModel(solver1);
-    CbcMain0(*model->model_);
+    CbcSolverUsefulData * data = parameterData(model);
+    lockMain();
+    CbcMain0(*model->model_, *data);
+    unlockMain();
     model->handler_   = NULL;
 
     if (VERBOSE > 0) printf("%s return\n", prefix);
@@ -258,6 +477,9 @@ Cbc_deleteModel(Cbc_Model * model)
     if (VERBOSE > 0) printf("%s begin\n", prefix);
     fflush(stdout);
 
+    // stop any solve in progress (and tidy up one which has finished)
+    Cbc_cancel(model);
+    Cbc_wait(model);
     if (VERBOSE > 1) printf("%s delete model->model_\n", prefix);
     fflush(stdout);
     delete model->model_;
@@ -268,6 +490,8 @@ Cbc_deleteModel(Cbc_Model * model)
 
     if (VERBOSE > 1) printf("%s delete model\n", prefix);
     fflush(stdout);
+    deleteParameterData(model);
+    deleteIncumbentInfo(model);
     delete model;
 
     if (VERBOSE > 0) printf("%s return\n", prefix);
@@ -325,6 +549,172 @@ Cbc_loadProblem (Cbc_Model * model,  const int numcols, const int numrows,
     if (VERBOSE > 0) printf("%s return\n", prefix);
 } //  Cbc_loadProblem()
 
+/* Arrays which can be handed over */
+COINLIBAPI double * COINLINKAGE
+Cbc_newDoubleArray(int size)
+{
+    return new double [size];
+}
+COINLIBAPI int * COINLINKAGE
+Cbc_newIntArray(int size)
+{
+    return new int [size];
+}
+COINLIBAPI CoinBigIndex * COINLINKAGE
+Cbc_newBigIndexArray(int size)
+{
+    return new CoinBigIndex [size];
+}
+/* Free arrays which were not handed over */
+COINLIBAPI void COINLINKAGE
+Cbc_freeArrays(CoinBigIndex * start, int * index, double * value,
+               double * collb, double * colub, double * obj,
+               double * rowlb, double * rowub)
+{
+    delete [] start;
+    delete [] index;
+    delete [] value;
+    delete [] collb;
+    delete [] colub;
+    delete [] obj;
+    delete [] rowlb;
+    delete [] rowub;
+}
+/* If solver is Clp load bounds and objective (copied - NULL gives
+   defaults) and hand over matrix without copying elements.
+   Returns false (nothing done) if not Clp */
+static bool
+loadClpTakingMatrix(OsiSolverInterface * solver, CoinPackedMatrix * matrix,
+                    const double* collb, const double* colub,
+                    const double* obj,
+                    const double* rowlb, const double* rowub)
+{
+    OsiClpSolverInterface * clpSolver =
+        dynamic_cast<OsiClpSolverInterface *> (solver);
+    if (!clpSolver)
+        return false;
+    int numcols = matrix->getNumCols();
+    int numrows = matrix->getNumRows();
+    // load with no elements
+    CoinBigIndex * emptyStart = new CoinBigIndex [numcols+1];
+    CoinZeroN(emptyStart, numcols + 1);
+    int emptyIndex = 0;
+    double emptyValue = 0.0;
+    clpSolver->loadProblem(numcols, numrows, emptyStart, &emptyIndex, &emptyValue,
+                           collb, colub, obj, rowlb, rowub);
+    delete [] emptyStart;
+    clpSolver->getModelPtr()->replaceMatrix(matrix, true);
+    return true;
+}
+/* Loads a problem taking over arrays */
+COINLIBAPI void COINLINKAGE
+Cbc_assignProblem (Cbc_Model * model,  const int numcols, const int numrows,
+                   CoinBigIndex * start, int* index,
+                   double* value,
+                   double* collb, double* colub,
+                   double* obj,
+                   double* rowlb, double* rowub)
+{
+    const char prefix[] = "Cbc_C_Interface::Cbc_assignProblem(): ";
+//  const int  VERBOSE = 2;
+    if (VERBOSE > 0) printf("%s begin\n", prefix);
+
+    OsiSolverInterface * solver = model->model_->solver();
+    if (!start) {
+        // no elements
+        start = new CoinBigIndex [numcols+1];
+        CoinZeroN(start, numcols + 1);
+    }
+    CoinBigIndex numberElements = start[numcols];
+    assert ((index && value) || !numberElements);
+    if (!index)
+        index = new int [1];
+    if (!value)
+        value = new double [1];
+    CoinPackedMatrix * matrix = new CoinPackedMatrix();
+    int * length = NULL;
+    // matrix takes over start, index and value
+    matrix->assignMatrix(true, numrows, numcols, numberElements,
+                         value, index, start, length);
+    if (loadClpTakingMatrix(solver, matrix, collb, colub, obj, rowlb, rowub)) {
+        Cbc_freeArrays(NULL, NULL, NULL, collb, colub, obj, rowlb, rowub);
+    } else {
+        // solver takes over matrix and rest (NULL gives defaults)
+        if (!collb) {
+            collb = new double [numcols];
+            CoinZeroN(collb, numcols);
+        }
+        if (!colub) {
+            colub = new double [numcols];
+            CoinFillN(colub, numcols, COIN_DBL_MAX);
+        }
+        if (!obj) {
+            obj = new double [numcols];
+            CoinZeroN(obj, numcols);
+        }
+        if (!rowlb) {
+            rowlb = new double [numrows];
+            CoinFillN(rowlb, numrows, -COIN_DBL_MAX);
+        }
+        if (!rowub) {
+            rowub = new double [numrows];
+            CoinFillN(rowub, numrows, COIN_DBL_MAX);
+        }
+        solver->assignProblem(matrix, collb, colub, obj, rowlb, rowub);
+    }
+
+    if (VERBOSE > 0) printf("%s return\n", prefix);
+} //  Cbc_assignProblem()
+/* Loads a problem given by rows */
+COINLIBAPI void COINLINKAGE
+Cbc_loadProblemByRows (Cbc_Model * model,  const int numcols, const int numrows,
+                       const CoinBigIndex * rowStart, const int* column,
+                       const double* value,
+                       const double* collb, const double* colub,
+                       const double* obj,
+                       const double* rowlb, const double* rowub)
+{
+    const char prefix[] = "Cbc_C_Interface::Cbc_loadProblemByRows(): ";
+//  const int  VERBOSE = 2;
+    if (VERBOSE > 0) printf("%s begin\n", prefix);
+
+    // transpose into arrays which solver can take over
+    CoinBigIndex numberElements = rowStart[numrows];
+    CoinBigIndex * start = new CoinBigIndex [numcols+1];
+    int * row = new int [numberElements];
+    double * element = new double [numberElements];
+    memset(start, 0, (numcols + 1)*sizeof(CoinBigIndex));
+    CoinBigIndex j;
+    for (j = 0; j < numberElements; j++)
+        start[column[j]+1]++;
+    for (int iColumn = 0; iColumn < numcols; iColumn++)
+        start[iColumn+1] += start[iColumn];
+    for (int iRow = 0; iRow < numrows; iRow++) {
+        for (j = rowStart[iRow]; j < rowStart[iRow+1]; j++) {
+            CoinBigIndex put = start[column[j]]++;
+            row[put] = iRow;
+            element[put] = value[j];
+        }
+    }
+    // starts have moved up by one column
+    for (int iColumn = numcols; iColumn > 0; iColumn--)
+        start[iColumn] = start[iColumn-1];
+    start[0] = 0;
+    CoinPackedMatrix * matrix = new CoinPackedMatrix();
+    int * length = NULL;
+    // matrix takes over start, row and element
+    matrix->assignMatrix(true, numrows, numcols, numberElements,
+                         element, row, start, length);
+    // bounds and objective go straight from caller's arrays
+    OsiSolverInterface * solver = model->model_->solver();
+    if (!loadClpTakingMatrix(solver, matrix, collb, colub, obj, rowlb, rowub)) {
+        solver->loadProblem(*matrix, collb, colub, obj, rowlb, rowub);
+        delete matrix;
+    }
+
+    if (VERBOSE > 0) printf("%s return\n", prefix);
+} //  Cbc_loadProblemByRows()
+
 /* Read an mps file from the given filename */
 COINLIBAPI int COINLINKAGE
 Cbc_readMps(Cbc_Model * model, const char *filename)
@@ -355,6 +745,38 @@ Cbc_writeMps(Cbc_Model * model, const char *filename)
     if (VERBOSE > 0) printf("%s return\n", prefix);
     return;
 }
+/* Read a snapshot of a preprocessed model */
+COINLIBAPI int COINLINKAGE
+Cbc_readSnapshot(Cbc_Model * model, const char *filename)
+{
+    const char prefix[] = "Cbc_C_Interface::Cbc_readSnapshot(): ";
+//  const int  VERBOSE = 2;
+    if (VERBOSE > 0) printf("%s begin\n", prefix);
+    if (VERBOSE > 1) printf("%s filename = '%s'\n", prefix, filename);
+
+    CbcSnapshot snapshot;
+    int result = snapshot.read(filename);
+    if (!result && snapshot.hasOriginal()) {
+        /* original model - solve uses preprocessed model and maps
+           solution back (arrays are copied out of mapped file here) */
+        OsiSolverInterface * solver = model->model_->solver();
+        snapshot.loadOriginal(solver);
+        std::vector<std::string> names = snapshot.originalColumnNames();
+        for (int i = 0; i < static_cast<int> (names.size()); i++)
+            solver->setColName(i, names[i]);
+        model->cmdargs_.push_back("-restore");
+        model->cmdargs_.push_back(filename);
+    } else if (!result) {
+        // only preprocessed model
+        snapshot.loadProblem(model->model_->solver());
+        snapshot.setupModel(*model->model_);
+        model->cmdargs_.push_back("-preprocess");
+        model->cmdargs_.push_back("off");
+    }
+
+    if (VERBOSE > 0) printf("%s return %i\n", prefix, result);
+    return result;
+}
 
 
 COINLIBAPI void COINLINKAGE
@@ -462,6 +884,35 @@ Cbc_getElements(Cbc_Model * model)
 
 
 
+/* Pass in incumbent call back */
+COINLIBAPI void COINLINKAGE
+Cbc_setIncumbentCallBack(Cbc_Model * model, cbc_incumbent_callback callBack,
+                         void * userData)
+{
+    const char prefix[] = "Cbc_C_Interface::Cbc_setIncumbentCallBack(): ";
+//  const int  VERBOSE = 1;
+    if (VERBOSE > 0) printf("%s begin\n", prefix);
+
+    model->model_->passInEventHandler(NULL);
+    deleteIncumbentInfo(model);
+    if (callBack) {
+        CbcIncumbentInfo * info = new CbcIncumbentInfo;
+        info->model = model;
+        info->callBack = callBack;
+        info->userData = userData;
+#ifdef CBC_THREAD
+        pthread_mutex_lock(&parameterDataMutex);
+#endif
+        incumbentInfoMap[model] = info;
+#ifdef CBC_THREAD
+        pthread_mutex_unlock(&parameterDataMutex);
+#endif
+        CbcIncumbentStream stream(incumbentCallBack, info);
+        model->model_->passInEventHandler(&stream);
+    }
+
+    if (VERBOSE > 0) printf("%s return\n", prefix);
+}
 /* Pass in Callback function */
 COINLIBAPI void COINLINKAGE
 Cbc_registerCallBack(Cbc_Model * model,
@@ -548,9 +999,10 @@ Cbc_solve(Cbc_Model * model)
     }
     argv.push_back("-solve");
     argv.push_back("-quit");
+    CbcSolverUsefulData * data = parameterData(model);
     try {
         
-        CbcMain1((int)argv.size(), &argv[0], *model->model_);
+        CbcMain1((int)argv.size(), &argv[0], *model->model_, solveCallBack, *data);
     } catch (CoinError e) {
         printf("%s ERROR: %s::%s, %s\n", prefix,
                e.className().c_str(), e.methodName().c_str(), e.message().c_str());
@@ -559,6 +1011,314 @@ Cbc_solve(Cbc_Model * model)
 
     return result;
 }
+#ifdef CBC_THREAD
+namespace {
+void * doAsyncSolve(void * voidInfo)
+{
+    CbcAsyncSolve * info = reinterpret_cast<CbcAsyncSolve *> (voidInfo);
+    pthread_setspecific(asyncSolveKey, info);
+    int status = Cbc_solve(info->model);
+    pthread_mutex_lock(&info->mutex);
+    info->status = status;
+    info->finished = true;
+    pthread_mutex_unlock(&info->mutex);
+    return NULL;
+}
+}
+#endif
+/* Start solve in another thread */
+COINLIBAPI int COINLINKAGE
+Cbc_solveAsync(Cbc_Model * model)
+{
+    const char prefix[] = "Cbc_C_Interface::Cbc_solveAsync(): ";
+//  const int  VERBOSE = 1;
+    if (VERBOSE > 0) printf("%s begin\n", prefix);
+
+    int returnCode = 0;
+#ifdef CBC_THREAD
+    CbcAsyncSolve * info = findAsyncSolve(model);
+    if (info) {
+        pthread_mutex_lock(&info->mutex);
+        bool finished = info->finished;
+        pthread_mutex_unlock(&info->mutex);
+        if (!finished)
+            return 1; // already running
+        Cbc_wait(model);
+    }
+    pthread_once(&asyncSolveKeyOnce, makeAsyncSolveKey);
+    info = new CbcAsyncSolve;
+    info->model = model;
+    pthread_mutex_init(&info->mutex, NULL);
+    CbcEventHandler * userHandler = model->model_->getEventHandler();
+    info->userHandler = userHandler ? userHandler->clone() : NULL;
+    // not known until branch and bound
+    double sense = model->model_->getObjSense();
+    info->bestBound = -COIN_DBL_MAX * sense;
+    info->bestObjective = COIN_DBL_MAX * sense;
+    info->nodeCount = 0;
+    info->estimate.clear();
+    info->cancelled = false;
+    info->finished = false;
+    info->status = -1;
+    {
+        // copied to model doing branch and bound
+        CbcAsyncEventHandler handler(info, userHandler);
+        model->model_->passInEventHandler(&handler);
+    }
+    pthread_mutex_lock(&parameterDataMutex);
+    asyncSolveMap[model] = info;
+    pthread_mutex_unlock(&parameterDataMutex);
+    if (pthread_create(&info->thread, NULL, doAsyncSolve, info)) {
+        pthread_mutex_lock(&parameterDataMutex);
+        asyncSolveMap.erase(model);
+        pthread_mutex_unlock(&parameterDataMutex);
+        model->model_->passInEventHandler(info->userHandler);
+        delete info->userHandler;
+        pthread_mutex_destroy(&info->mutex);
+        delete info;
+        returnCode = 2;
+    }
+#else
+    // no threads so just solve
+    Cbc_solve(model);
+#endif
+
+    if (VERBOSE > 0) printf("%s return %i\n", prefix, returnCode);
+    return returnCode;
+}
+/* Progress of asynchronous solve */
+COINLIBAPI int COINLINKAGE
+Cbc_poll(Cbc_Model * model, double * bestBound, double * bestObjective,
+         int * nodeCount, double * gap)
+{
+    int running = 0;
+    double bound = 0.0;
+    double objective = 0.0;
+    int nodes = 0;
+#ifdef CBC_THREAD
+    CbcAsyncSolve * info = findAsyncSolve(model);
+    if (info) {
+        pthread_mutex_lock(&info->mutex);
+        if (!info->finished) {
+            // model belongs to solve thread - use values it published
+            running = 1;
+            bound = info->bestBound;
+            objective = info->bestObjective;
+            nodes = info->nodeCount;
+        }
+        pthread_mutex_unlock(&info->mutex);
+    }
+#endif
+    if (!running) {
+        bound = model->model_->getBestPossibleObjValue();
+        objective = model->model_->getObjValue();
+        nodes = model->model_->getNodeCount();
+    }
+    if (bestBound)
+        *bestBound = bound;
+    if (bestObjective)
+        *bestObjective = objective;
+    if (nodeCount)
+        *nodeCount = nodes;
+    if (gap) {
+        if (fabs(objective) < 1.0e40 && fabs(bound) < 1.0e40)
+            *gap = fabs(objective - bound) / CoinMax(fabs(objective), 1.0e-10);
+        else
+            *gap = COIN_DBL_MAX;
+    }
+    return running;
+}
+/* Estimate of work left in branch and bound */
+COINLIBAPI int COINLINKAGE
+Cbc_estimateRemaining(Cbc_Model * model, double * remainingNodes,
+                      double * remainingSeconds, double * totalNodes)
+{
+    CbcTreeEstimate estimate;
+    bool running = false;
+#ifdef CBC_THREAD
+    CbcAsyncSolve * info = findAsyncSolve(model);
+    if (info) {
+        pthread_mutex_lock(&info->mutex);
+        if (!info->finished) {
+            // as published at last node log
+            running = true;
+            estimate = info->estimate;
+        }
+        pthread_mutex_unlock(&info->mutex);
+    }
+#endif
+    if (!running)
+        estimate = model->model_->treeEstimate();
+    if (remainingNodes)
+        *remainingNodes = estimate.remainingNodes();
+    if (remainingSeconds)
+        *remainingSeconds = estimate.remainingSeconds();
+    if (totalNodes)
+        *totalNodes = estimate.totalNodes();
+    return estimate.remainingNodes() >= 0.0 ? 1 : 0;
+}
+/* Ask asynchronous solve to stop */
+COINLIBAPI int COINLINKAGE
+Cbc_cancel(Cbc_Model * model)
+{
+    int returnCode = 1;
+#ifdef CBC_THREAD
+    CbcAsyncSolve * info = findAsyncSolve(model);
+    if (info) {
+        pthread_mutex_lock(&info->mutex);
+        if (!info->finished) {
+            // seen by call back and event handler in solve thread
+            info->cancelled = true;
+            returnCode = 0;
+        }
+        pthread_mutex_unlock(&info->mutex);
+    }
+#endif
+    return returnCode;
+}
+/* Wait for asynchronous solve */
+COINLIBAPI int COINLINKAGE
+Cbc_wait(Cbc_Model * model)
+{
+#ifdef CBC_THREAD
+    CbcAsyncSolve * info = findAsyncSolve(model);
+    if (info) {
+        pthread_join(info->thread, NULL);
+        pthread_mutex_lock(&parameterDataMutex);
+        asyncSolveMap.erase(model);
+        pthread_mutex_unlock(&parameterDataMutex);
+        // put back event handler
+        model->model_->passInEventHandler(info->userHandler);
+        delete info->userHandler;
+        pthread_mutex_destroy(&info->mutex);
+        delete info;
+    }
+#endif
+    return model->model_->status();
+}
+namespace {
+// For solving a batch
+struct CbcBatchInfo {
+    Cbc_Model ** models;
+    int * status;
+    int numberModels;
+    int next;
+#ifdef CBC_THREAD
+    pthread_mutex_t mutex;
+#endif
+};
+void * doBatch(void * voidInfo)
+{
+    CbcBatchInfo * info = reinterpret_cast<CbcBatchInfo *> (voidInfo);
+    while (true) {
+#ifdef CBC_THREAD
+        pthread_mutex_lock(&info->mutex);
+#endif
+        int which = info->next++;
+#ifdef CBC_THREAD
+        pthread_mutex_unlock(&info->mutex);
+#endif
+        if (which >= info->numberModels)
+            break;
+        int status = Cbc_solve(info->models[which]);
+        if (info->status)
+            info->status[which] = status;
+    }
+    return NULL;
+}
+}
+/* Solve many models */
+COINLIBAPI int COINLINKAGE
+Cbc_solveBatch(Cbc_Model ** models, int numberModels, int numberThreads,
+               int * status)
+{
+    const char prefix[] = "Cbc_C_Interface::Cbc_solveBatch(): ";
+//  const int  VERBOSE = 1;
+    if (VERBOSE > 0) printf("%s begin\n", prefix);
+
+    CbcBatchInfo info;
+    info.models = models;
+    info.status = status;
+    info.numberModels = numberModels;
+    info.next = 0;
+#ifdef CBC_THREAD
+    pthread_mutex_init(&info.mutex, NULL);
+    if (numberThreads > numberModels)
+        numberThreads = numberModels;
+    if (numberThreads > 1) {
+        pthread_t * threadId = new pthread_t [numberThreads];
+        int numberStarted = 0;
+        for (int i = 0; i < numberThreads; i++) {
+            if (!pthread_create(threadId + numberStarted, NULL, doBatch, &info))
+                numberStarted++;
+        }
+        // if no threads could be started do it here
+        if (!numberStarted)
+            doBatch(&info);
+        for (int i = 0; i < numberStarted; i++)
+            pthread_join(threadId[i], NULL);
+        delete [] threadId;
+    } else {
+        doBatch(&info);
+    }
+    pthread_mutex_destroy(&info.mutex);
+#else
+    doBatch(&info);
+#endif
+
+    if (VERBOSE > 0) printf("%s return\n", prefix);
+    return 0;
+}
+/* Keep information for Cbc_resolve */
+COINLIBAPI void COINLINKAGE
+Cbc_setKeepForResolve(Cbc_Model * model, int yesNo)
+{
+    model->model_->setKeepForResolve(yesNo != 0);
+}
+/* Change bounds of a variable for next Cbc_resolve */
+COINLIBAPI void COINLINKAGE
+Cbc_resolveSetColBounds(Cbc_Model * model, int index, double lower,
+                        double upper)
+{
+    model->model_->resolveSetColumnBounds(index, lower, upper);
+}
+/* Change objective coefficient for next Cbc_resolve */
+COINLIBAPI void COINLINKAGE
+Cbc_resolveSetObjCoeff(Cbc_Model * model, int index, double value)
+{
+    model->model_->resolveSetObjective(index, value);
+}
+/* Change bounds of a constraint for next Cbc_resolve */
+COINLIBAPI void COINLINKAGE
+Cbc_resolveSetRowBounds(Cbc_Model * model, int index, double lower,
+                        double upper)
+{
+    model->model_->resolveSetRowBounds(index, lower, upper);
+}
+/* Append constraints for next Cbc_resolve */
+COINLIBAPI void COINLINKAGE
+Cbc_resolveAddRows(Cbc_Model * model, int numRows, const CoinBigIndex * rowStarts,
+                   const int * colIndices, const double * elements,
+                   const double * rowLower, const double * rowUpper)
+{
+    model->model_->resolveAddRows(numRows, rowStarts, colIndices, elements,
+                                  rowLower, rowUpper);
+}
+/* Solve again after changes */
+COINLIBAPI int COINLINKAGE
+Cbc_resolve(Cbc_Model * model)
+{
+    const char prefix[] = "Cbc_C_Interface::Cbc_resolve(): ";
+//  const int  VERBOSE = 1;
+    if (VERBOSE > 0) printf("%s begin\n", prefix);
+
+    // put changed problem in model and solve with same parameters as Cbc_solve
+    model->model_->restoreForResolve();
+    int result = Cbc_solve(model);
+
+    if (VERBOSE > 0) printf("%s return %i\n", prefix, result);
+    return result;
+}
 
 /* Sum of primal infeasibilities */
 COINLIBAPI double COINLINKAGE
@@ -651,6 +1411,31 @@ CbcSetSolverProperty(double, setColLower)
 CbcGetProperty(const double*, getColUpper)
 CbcSetSolverProperty(double, setColUpper)
 
+/* Copy "row" solution into array */
+COINLIBAPI int COINLINKAGE
+Cbc_copyRowActivity(Cbc_Model * model, double * array)
+{
+    int n = model->model_->getNumRows();
+    const double * activity = model->model_->getRowActivity();
+    if (activity)
+        memcpy(array, activity, n*sizeof(double));
+    else
+        n = 0;
+    return n;
+}
+/* Copy best feasible solution into array */
+COINLIBAPI int COINLINKAGE
+Cbc_copyColSolution(Cbc_Model * model, double * array)
+{
+    int n = model->model_->getNumCols();
+    const double * solution = model->model_->getColSolution();
+    if (solution)
+        memcpy(array, solution, n*sizeof(double));
+    else
+        n = 0;
+    return n;
+}
+
 CbcGetProperty(double, getObjValue)
 CbcGetProperty(double, getBestPossibleObjValue)
 
@@ -726,6 +1511,94 @@ Cbc_isInteger(Cbc_Model * model, int i)
 
 CbcGetProperty(int, getNodeCount)
 
+/** Number of phases in profile */
+COINLIBAPI int COINLINKAGE
+Cbc_numberProfilePhases()
+{
+    return CbcProfile::numberPhases;
+}
+
+/** Name of profile phase */
+COINLIBAPI const char * COINLINKAGE
+Cbc_profilePhaseName(int phase)
+{
+    return CbcProfile::name(phase);
+}
+
+/** Copy time and count for each phase of last solve */
+COINLIBAPI int COINLINKAGE
+Cbc_getProfile(Cbc_Model * model, double * seconds, int * counts)
+{
+    const char prefix[] = "Cbc_C_Interface::Cbc_getProfile(): ";
+//  const int  VERBOSE = 1;
+    if (VERBOSE > 0) printf("%s begin\n", prefix);
+
+    const CbcProfile & profile = model->model_->profile();
+    for (int i = 0; i < CbcProfile::numberPhases; i++) {
+        if (seconds)
+            seconds[i] = profile.seconds(i);
+        if (counts)
+            counts[i] = profile.count(i);
+    }
+
+    if (VERBOSE > 0) printf("%s return\n", prefix);
+    return CbcProfile::numberPhases;
+}
+
+/** Set maximum memory (megabytes) */
+COINLIBAPI void COINLINKAGE
+Cbc_setMaximumMemory(Cbc_Model * model, double megabytes)
+{
+    model->model_->setMaximumMemory(megabytes);
+}
+
+/** Use deterministic work for time */
+COINLIBAPI void COINLINKAGE
+Cbc_setWorkClock(Cbc_Model * model, int yesNo)
+{
+    model->model_->setUseWorkClock(yesNo != 0);
+}
+
+/** Pin threads to cpus (Linux) so thread memory is local */
+COINLIBAPI void COINLINKAGE
+Cbc_setPinThreads(Cbc_Model * model, int yesNo)
+{
+    model->model_->setPinThreads(yesNo != 0);
+}
+
+/** Number of parts in memory estimates */
+COINLIBAPI int COINLINKAGE
+Cbc_numberMemoryParts()
+{
+    return CbcMemory::numberParts;
+}
+
+/** Name of memory part */
+COINLIBAPI const char * COINLINKAGE
+Cbc_memoryPartName(int part)
+{
+    return CbcMemory::name(part);
+}
+
+/** Copy peak memory estimates of last solve */
+COINLIBAPI double COINLINKAGE
+Cbc_getMemoryUsage(Cbc_Model * model, double * megabytes)
+{
+    const char prefix[] = "Cbc_C_Interface::Cbc_getMemoryUsage(): ";
+//  const int  VERBOSE = 1;
+    if (VERBOSE > 0) printf("%s begin\n", prefix);
+
+    const double toMegabytes = 1.0 / (1024.0 * 1024.0);
+    const CbcMemory & usage = model->model_->memoryPeak();
+    if (megabytes) {
+        for (int i = 0; i < CbcMemory::numberParts; i++)
+            megabytes[i] = usage.bytes(i) * toMegabytes;
+    }
+
+    if (VERBOSE > 0) printf("%s return\n", prefix);
+    return usage.processBytes() * toMegabytes;
+}
+
 /** Return a copy of this model */
 COINLIBAPI Cbc_Model * COINLINKAGE
 Cbc_clone(Cbc_Model * model)
@@ -739,9 +1612,18 @@ Cbc_clone(Cbc_Model * model)
     result->solver_    = dynamic_cast< OsiClpSolverInterface*> (result->model_->solver());
     result->handler_   = NULL;
     result->cmdargs_   = model->cmdargs_;
+    {
+        // parameters as from Cbc_newModel (CbcSolverUsefulData copy is shallow)
+        OsiClpSolverInterface dummySolver;
+        CbcModel dummyModel(dummySolver);
+        CbcSolverUsefulData * data = parameterData(result);
+        lockMain();
+        CbcMain0(dummyModel, *data);
+        unlockMain();
+    }
 
     if (VERBOSE > 0) printf("%s return\n", prefix);
-    return model;
+    return result;
 }
 /** Set this the variable to be continuous */
 COINLIBAPI void COINLINKAGE
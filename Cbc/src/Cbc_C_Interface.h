@@ -77,6 +77,55 @@ extern "C" {
                      const double* obj,
                      const double* rowlb, const double* rowub)
     ;
+    /** Arrays which can be handed over to Cbc by Cbc_assignProblem.
+        Free with Cbc_freeArrays if not handed over */
+    COINLIBAPI double * COINLINKAGE
+    Cbc_newDoubleArray(int size)
+    ;
+    COINLIBAPI int * COINLINKAGE
+    Cbc_newIntArray(int size)
+    ;
+    COINLIBAPI CoinBigIndex * COINLINKAGE
+    Cbc_newBigIndexArray(int size)
+    ;
+    /** Free arrays from Cbc_new...Array (any may be NULL) */
+    COINLIBAPI void COINLINKAGE
+    Cbc_freeArrays(CoinBigIndex * start, int * index, double * value,
+                   double * collb, double * colub, double * obj,
+                   double * rowlb, double * rowub)
+    ;
+    /** Loads a problem without copying the matrix.
+        Same as Cbc_loadProblem but ownership of the arrays is passed
+        to Cbc - they must have been allocated by Cbc_new...Array and the
+        caller must not use or free them afterwards.
+        start must have numcols+1 entries or be NULL if there are no
+        elements - index and value may then also be NULL.  Bounds and
+        objective may be NULL for the defaults of Cbc_loadProblem.
+        With Clp the matrix is taken over and the (row and column sized)
+        bounds and objective are copied and freed.
+    */
+    COINLIBAPI void COINLINKAGE
+    Cbc_assignProblem (Cbc_Model * model,  const int numcols, const int numrows,
+                       CoinBigIndex * start, int* index,
+                       double* value,
+                       double* collb, double* colub,
+                       double* obj,
+                       double* rowlb, double* rowub)
+    ;
+    /** Loads a problem given by rows.
+        Same as Cbc_loadProblem but the matrix is in compressed sparse
+        row form (rowStart[numrows] is number of elements).  The arrays
+        are only borrowed for the call - the matrix is transposed
+        straight into the arrays Cbc keeps so there is a single copy.
+    */
+    COINLIBAPI void COINLINKAGE
+    Cbc_loadProblemByRows (Cbc_Model * model,  const int numcols, const int numrows,
+                           const CoinBigIndex * rowStart, const int* column,
+                           const double* value,
+                           const double* collb, const double* colub,
+                           const double* obj,
+                           const double* rowlb, const double* rowub)
+    ;
     /** Read an mps file from the given filename */
     COINLIBAPI int COINLINKAGE
     Cbc_readMps(Cbc_Model * model, const char *filename)
@@ -85,6 +134,16 @@ extern "C" {
     COINLIBAPI void COINLINKAGE
     Cbc_writeMps(Cbc_Model * model, const char *filename)
     ;
+    /** Read a snapshot of a preprocessed model (as saved by
+        Cbc_setParameter(model, "save", "name.snap") before Cbc_solve).
+        The original model is loaded and Cbc_solve searches on the
+        preprocessed model (with its priorities and cuts) and maps the
+        solution back.  Snapshots saved without the original model load
+        the preprocessed model and solutions are for that model.
+        Returns 0 if OK, 1 if file can not be opened, 2 if bad format */
+    COINLIBAPI int COINLINKAGE
+    Cbc_readSnapshot(Cbc_Model * model, const char *filename)
+    ;
     /** Provide an initial feasible solution to accelerate branch-and-bound 
      Note that feasibility of the solution is *not* verified.
     */
@@ -245,6 +304,22 @@ extern "C" {
     COINLIBAPI void COINLINKAGE
     Cbc_clearCallBack(Cbc_Model * model)
     ;
+    /** Call back for new incumbents.  Gives numberChanged values
+        (columns which and new values) which changed from the previous
+        incumbent (the first is against all zero) with objective value,
+        heuristic name (or "branching") and seconds from start of solve.
+        Arrays are only valid during the call. Columns are original
+        columns (those removed by preprocessing are not given) */
+    typedef void (COINLINKAGE_CB *cbc_incumbent_callback)(Cbc_Model * model,
+            int numberChanged, const int * which, const double * values,
+            double objectiveValue, const char * source, double seconds,
+            void * userData);
+    /** Pass in incumbent call back (NULL to remove).
+        This uses the CbcModel event handler */
+    COINLIBAPI void COINLINKAGE
+    Cbc_setIncumbentCallBack(Cbc_Model * model, cbc_incumbent_callback callBack,
+                             void * userData)
+    ;
 
     /*@}*/
 
@@ -252,10 +327,99 @@ extern "C" {
     /**@name Solving the model */
     /*@{*/
     /* Solve the model with Cbc (using CbcMain1).
+       Each model has its own parameters and CbcMain1 keeps all its
+       state local, so different models may be solved from different
+       threads at the same time.  Ctrl-c is not caught - use
+       Cbc_cancel with Cbc_solveAsync to stop a solve.
     */
     COINLIBAPI int COINLINKAGE
     Cbc_solve(Cbc_Model * model)
     ;
+    /** Start solving the model (as Cbc_solve) in another thread.
+        Returns 0 if started, 1 if a solve of this model is still
+        running, 2 if thread could not be started.  Without thread
+        support the model is solved before returning.
+        Use Cbc_wait before looking at the solution.
+    */
+    COINLIBAPI int COINLINKAGE
+    Cbc_solveAsync(Cbc_Model * model)
+    ;
+    /** Progress of Cbc_solveAsync.  Returns 1 if still running else 0.
+        Gives best possible value, value of best solution (large if none),
+        nodes done and relative gap (large if not known) - any pointer
+        may be NULL.  While running values are as at the last node log
+        or solution in branch and bound.
+    */
+    COINLIBAPI int COINLINKAGE
+    Cbc_poll(Cbc_Model * model, double * bestBound, double * bestObjective,
+             int * nodeCount, double * gap)
+    ;
+    /** Estimate of work left in branch and bound (while Cbc_solveAsync
+        is running or as at end of last solve).  Gives estimated nodes
+        and seconds remaining and estimated total nodes in tree - any
+        pointer may be NULL.  Values are -1.0 if not known (e.g. not yet
+        in tree search).  Returns 1 if an estimate is known else 0.
+    */
+    COINLIBAPI int COINLINKAGE
+    Cbc_estimateRemaining(Cbc_Model * model, double * remainingNodes,
+                          double * remainingSeconds, double * totalNodes)
+    ;
+    /** Ask Cbc_solveAsync to stop as soon as possible (the best solution
+        so far is kept).  Branch and bound stops at the next node (next
+        node log with threads), earlier stages at their end.  Returns 0 if a running solve was told, 1 if
+        nothing running.  Use Cbc_wait afterwards.
+    */
+    COINLIBAPI int COINLINKAGE
+    Cbc_cancel(Cbc_Model * model)
+    ;
+    /** Wait for Cbc_solveAsync to finish. Returns status as Cbc_status */
+    COINLIBAPI int COINLINKAGE
+    Cbc_wait(Cbc_Model * model)
+    ;
+    /** Solve numberModels independent models as by Cbc_solve using
+        numberThreads threads (0 or 1 solves them in turn).
+        If status is not NULL status[i] is Cbc_status of models[i].
+        Models must all be different.  Returns 0.
+    */
+    COINLIBAPI int COINLINKAGE
+    Cbc_solveBatch(Cbc_Model ** models, int numberModels, int numberThreads,
+                   int * status)
+    ;
+    /** Keep problem, cuts, pseudocosts and incumbent after Cbc_solve or
+        Cbc_resolve so that the next Cbc_resolve can reuse them (1 on,
+        0 off).  Cbc_resolve solves like Cbc_solve, so parameters set by
+        Cbc_setParameter are used.  Cbc_resolve does not preprocess, as
+        changes are in terms of the model as given.  If Cbc_solve
+        preprocessed then only the incumbent is kept.
+    */
+    COINLIBAPI void COINLINKAGE
+    Cbc_setKeepForResolve(Cbc_Model * model, int yesNo)
+    ;
+    /** Change bounds of a variable for next Cbc_resolve */
+    COINLIBAPI void COINLINKAGE
+    Cbc_resolveSetColBounds(Cbc_Model * model, int index, double lower,
+                            double upper)
+    ;
+    /** Change objective coefficient for next Cbc_resolve */
+    COINLIBAPI void COINLINKAGE
+    Cbc_resolveSetObjCoeff(Cbc_Model * model, int index, double value)
+    ;
+    /** Change bounds of a constraint for next Cbc_resolve */
+    COINLIBAPI void COINLINKAGE
+    Cbc_resolveSetRowBounds(Cbc_Model * model, int index, double lower,
+                            double upper)
+    ;
+    /** Append constraints (in row order) for next Cbc_resolve */
+    COINLIBAPI void COINLINKAGE
+    Cbc_resolveAddRows(Cbc_Model * model, int numRows, const CoinBigIndex * rowStarts,
+                       const int * colIndices, const double * elements,
+                       const double * rowLower, const double * rowUpper)
+    ;
+    /** Solve again after changes keeping what can still be used
+        (the first call just solves).  Returns status as Cbc_status */
+    COINLIBAPI int COINLINKAGE
+    Cbc_resolve(Cbc_Model * model)
+    ;
     /*@}*/
 
 
@@ -331,6 +495,16 @@ extern "C" {
     COINLIBAPI const double * COINLINKAGE
     Cbc_getColSolution(Cbc_Model * model)
     ;
+    /** Copy "row" solution into array of Cbc_getNumRows values
+        (as Cbc_getRowActivity). Returns number of values copied */
+    COINLIBAPI int COINLINKAGE
+    Cbc_copyRowActivity(Cbc_Model * model, double * array)
+    ;
+    /** Copy best feasible solution into array of Cbc_getNumCols values
+        (as Cbc_getColSolution). Returns number of values copied */
+    COINLIBAPI int COINLINKAGE
+    Cbc_copyColSolution(Cbc_Model * model, double * array)
+    ;
     /** Objective value of best feasible solution */
     COINLIBAPI double COINLINKAGE
     Cbc_getObjValue(Cbc_Model * model)
@@ -343,6 +517,53 @@ extern "C" {
     COINLIBAPI int COINLINKAGE
     Cbc_getNodeCount(Cbc_Model * model)
     ;
+    /** Number of phases in profile of branch and bound */
+    COINLIBAPI int COINLINKAGE
+    Cbc_numberProfilePhases()
+    ;
+    /** Name of profile phase (node LP, strong branching ...) */
+    COINLIBAPI const char * COINLINKAGE
+    Cbc_profilePhaseName(int phase)
+    ;
+    /** Copy wall clock seconds and number of times for each phase
+        of last solve into arrays of Cbc_numberProfilePhases values
+        (either may be NULL).  Returns number of phases */
+    COINLIBAPI int COINLINKAGE
+    Cbc_getProfile(Cbc_Model * model, double * seconds, int * counts)
+    ;
+    /** Set maximum memory (megabytes) for branch and bound - as
+        resident size approaches it search degrades and then stops */
+    COINLIBAPI void COINLINKAGE
+    Cbc_setMaximumMemory(Cbc_Model * model, double megabytes)
+    ;
+    /** Use deterministic work rather than seconds for time in branch
+        and bound (1) or not (0).  Work counts simplex iterations, nodes,
+        cut generator calls and heuristic runs scaled by problem size -
+        a unit is very roughly a second.  Time limits then give the same
+        search on any machine. */
+    COINLIBAPI void COINLINKAGE
+    Cbc_setWorkClock(Cbc_Model * model, int yesNo)
+    ;
+    /** Pin threads to cpus (1) or not (0) - Linux only.  Threads fill
+        one socket before the next and keep their solvers in memory on
+        their own NUMA node. */
+    COINLIBAPI void COINLINKAGE
+    Cbc_setPinThreads(Cbc_Model * model, int yesNo)
+    ;
+    /** Number of parts in memory estimates of branch and bound */
+    COINLIBAPI int COINLINKAGE
+    Cbc_numberMemoryParts()
+    ;
+    /** Name of memory part (tree nodes, global cuts ...) */
+    COINLIBAPI const char * COINLINKAGE
+    Cbc_memoryPartName(int part)
+    ;
+    /** Copy peak estimated megabytes for each part during last solve
+        into array of Cbc_numberMemoryParts values (may be NULL).
+        Returns peak resident megabytes of process (0.0 if not known) */
+    COINLIBAPI double COINLINKAGE
+    Cbc_getMemoryUsage(Cbc_Model * model, double * megabytes)
+    ;
     /** Print the solution */
     COINLIBAPI void  COINLINKAGE
     Cbc_printSolution(Cbc_Model * model)
@@ -370,6 +591,7 @@ extern "C" {
         6 stopped on solutions
         7 linear relaxation unbounded
         8 stopped on iteration limit
+        9 stopped on memory limit
     */
     COINLIBAPI int COINLINKAGE
     Cbc_secondaryStatus(Cbc_Model * model)
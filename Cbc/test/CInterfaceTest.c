@@ -366,6 +366,308 @@ void testIntegerBounds() {
 
 }
 
+void testAssignProblem() {
+    /* knapsack of testKnapsack with arrays handed over to Cbc
+       (rowlb NULL so -infinity) */
+
+    Cbc_Model *model = Cbc_newModel();
+
+    CoinBigIndex *start = Cbc_newBigIndexArray(6);
+    int *rowindex = Cbc_newIntArray(5);
+    double *value = Cbc_newDoubleArray(5);
+    double *collb = Cbc_newDoubleArray(5);
+    double *colub = Cbc_newDoubleArray(5);
+    double *obj = Cbc_newDoubleArray(5);
+    double *rowub = Cbc_newDoubleArray(1);
+    double weight[] = {2, 8, 4, 2, 5};
+    double profit[] = {5, 3, 2, 7, 4};
+    const double *sol;
+    int i;
+
+    for (i = 0; i < 5; i++) {
+        start[i] = i;
+        rowindex[i] = 0;
+        value[i] = weight[i];
+        collb[i] = 0.0;
+        colub[i] = 1.0;
+        obj[i] = profit[i];
+    }
+    start[5] = 5;
+    rowub[0] = 10.0;
+
+    Cbc_assignProblem(model, 5, 1, start, rowindex, value, collb, colub, obj, NULL, rowub);
+
+    assert(Cbc_getNumCols(model) == 5);
+    assert(Cbc_getNumRows(model) == 1);
+    assert(Cbc_getNumElements(model) == 5);
+    assert(Cbc_getRowLower(model)[0] < -1.0e30);
+    assert(fabs(Cbc_getRowUpper(model)[0] - 10.0) < 1e-6);
+
+    for (i = 0; i < 5; i++)
+        Cbc_setInteger(model, i);
+    Cbc_setObjSense(model, -1);
+    Cbc_setParameter(model, "log", "0");
+
+    Cbc_solve(model);
+
+    assert(Cbc_isProvenOptimal(model));
+    assert(fabs(Cbc_getObjValue(model) - 16.0) < 1e-6);
+
+    sol = Cbc_getColSolution(model);
+
+    assert(fabs(sol[0] - 1.0) < 1e-6);
+    assert(fabs(sol[1] - 0.0) < 1e-6);
+    assert(fabs(sol[2] - 0.0) < 1e-6);
+    assert(fabs(sol[3] - 1.0) < 1e-6);
+    assert(fabs(sol[4] - 1.0) < 1e-6);
+
+    Cbc_deleteModel(model);
+
+    /* no elements - start, index and value all NULL */
+    model = Cbc_newModel();
+    obj = Cbc_newDoubleArray(2);
+    obj[0] = 1.0;
+    obj[1] = -1.0;
+    colub = Cbc_newDoubleArray(2);
+    colub[0] = 2.0;
+    colub[1] = 3.0;
+
+    Cbc_assignProblem(model, 2, 0, NULL, NULL, NULL, NULL, colub, obj, NULL, NULL);
+
+    assert(Cbc_getNumCols(model) == 2);
+    assert(Cbc_getNumElements(model) == 0);
+    Cbc_setInteger(model, 1);
+    Cbc_setParameter(model, "log", "0");
+
+    Cbc_solve(model);
+
+    assert(Cbc_isProvenOptimal(model));
+    assert(fabs(Cbc_getObjValue(model) + 3.0) < 1e-6);
+
+    Cbc_deleteModel(model);
+
+}
+
+/* knapsack of testKnapsack with given capacity */
+static Cbc_Model * knapsackModel(double capacity) {
+
+    Cbc_Model *model = Cbc_newModel();
+
+    CoinBigIndex start[] = {0, 1, 2, 3, 4, 5};
+    int rowindex[] = {0, 0, 0, 0, 0};
+    double value[] = {2, 8, 4, 2, 5};
+    double collb[] = {0,0,0,0,0};
+    double colub[] = {1,1,1,1,1};
+    double obj[] = {5, 3, 2, 7, 4};
+    double rowlb[] = {-INFINITY};
+    double rowub[1];
+    int i;
+
+    rowub[0] = capacity;
+    Cbc_loadProblem(model, 5, 1, start, rowindex, value, collb, colub, obj, rowlb, rowub);
+    for (i = 0; i < 5; i++)
+        Cbc_setInteger(model, i);
+    Cbc_setObjSense(model, -1);
+    Cbc_setParameter(model, "log", "0");
+    return model;
+}
+
+void testSolveBatch() {
+
+    /* capacities 10, 4 and 2 - best 16, 12 and 7 */
+    double capacity[] = {10.0, 4.0, 2.0, 10.0, 4.0, 2.0};
+    double best[] = {16.0, 12.0, 7.0, 16.0, 12.0, 7.0};
+    Cbc_Model *models[6];
+    int status[6];
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        models[i] = knapsackModel(capacity[i]);
+        status[i] = -1;
+    }
+
+    assert(Cbc_solveBatch(models, 6, 3, status) == 0);
+
+    for (i = 0; i < 6; i++) {
+        assert(status[i] == 0);
+        assert(Cbc_isProvenOptimal(models[i]));
+        assert(fabs(Cbc_getObjValue(models[i]) - best[i]) < 1e-6);
+        Cbc_deleteModel(models[i]);
+    }
+
+}
+
+/* market split feasibility problem - hard for branch and bound */
+static Cbc_Model * marketSplitModel() {
+
+    Cbc_Model *model = Cbc_newModel();
+    CoinBigIndex start[41];
+    int rowindex[160];
+    double value[160];
+    double collb[40], colub[40], obj[40];
+    double rowlb[4], rowub[4];
+    int i, j;
+
+    for (i = 0; i < 4; i++)
+        rowlb[i] = 0.0;
+    for (j = 0; j < 40; j++) {
+        start[j] = 4 * j;
+        collb[j] = 0.0;
+        colub[j] = 1.0;
+        obj[j] = 0.0;
+        for (i = 0; i < 4; i++) {
+            rowindex[4 * j + i] = i;
+            value[4 * j + i] = (double) ((i * 37 + j * 53 + i * j * 11) % 100);
+            rowlb[i] += value[4 * j + i];
+        }
+    }
+    start[40] = 160;
+    for (i = 0; i < 4; i++) {
+        rowlb[i] = (double) ((int) (rowlb[i] / 2.0));
+        rowub[i] = rowlb[i];
+    }
+    Cbc_loadProblem(model, 40, 4, start, rowindex, value, collb, colub, obj, rowlb, rowub);
+    for (j = 0; j < 40; j++)
+        Cbc_setInteger(model, j);
+    Cbc_setParameter(model, "log", "0");
+    Cbc_setParameter(model, "sec", "60");
+    return model;
+}
+
+void testAsyncSolve() {
+
+    Cbc_Model *model = knapsackModel(10.0);
+    double bound, objective, gap;
+    int nodes, status;
+
+    /* run to end */
+    assert(Cbc_solveAsync(model) == 0);
+    while (Cbc_poll(model, &bound, &objective, &nodes, &gap))
+        ;
+    assert(Cbc_wait(model) == 0);
+    assert(Cbc_isProvenOptimal(model));
+    assert(fabs(Cbc_getObjValue(model) - 16.0) < 1e-6);
+    assert(Cbc_poll(model, &bound, &objective, &nodes, NULL) == 0);
+    assert(fabs(objective - 16.0) < 1e-6);
+    assert(nodes >= 0);
+    assert(Cbc_cancel(model) == 1); /* nothing running */
+
+    /* solve again without waiting - model can be looked at afterwards */
+    assert(Cbc_solveAsync(model) == 0);
+    while (Cbc_poll(model, NULL, NULL, NULL, NULL))
+        ;
+    assert(fabs(Cbc_getObjValue(model) - 16.0) < 1e-6);
+    Cbc_deleteModel(model);
+
+    /* cancel - search stops early (or has already finished) */
+    model = marketSplitModel();
+    assert(Cbc_solveAsync(model) == 0);
+    Cbc_cancel(model);
+    status = Cbc_wait(model);
+    assert(status == 0 || status == 1);
+    assert(Cbc_poll(model, NULL, NULL, NULL, NULL) == 0);
+    assert(!Cbc_isSecondsLimitReached(model));
+    Cbc_deleteModel(model);
+
+    /* delete while running */
+    model = marketSplitModel();
+    assert(Cbc_solveAsync(model) == 0);
+    Cbc_deleteModel(model);
+
+}
+
+void testEstimateRemaining() {
+
+    Cbc_Model *model = knapsackModel(10.0);
+    double remaining, seconds, total;
+    int known, i;
+
+    /* nothing known before solve */
+    assert(Cbc_estimateRemaining(model, &remaining, &seconds, &total) == 0);
+    assert(remaining == -1.0 && seconds == -1.0 && total == -1.0);
+    Cbc_solve(model);
+    known = Cbc_estimateRemaining(model, &remaining, NULL, &total);
+    assert(known == 0 || (remaining >= 0.0 && total >= remaining));
+    Cbc_deleteModel(model);
+
+    /* while running values are as at last node log */
+    model = marketSplitModel();
+    assert(Cbc_solveAsync(model) == 0);
+    for (i = 0; i < 1000000; i++) {
+        known = Cbc_estimateRemaining(model, &remaining, &seconds, &total);
+        if (known) {
+            assert(remaining >= 0.0 && total >= remaining);
+            break;
+        }
+        assert(remaining == -1.0);
+        if (!Cbc_poll(model, NULL, NULL, NULL, NULL))
+            break;
+    }
+    Cbc_cancel(model);
+    Cbc_wait(model);
+    Cbc_deleteModel(model);
+
+}
+
+/* incumbent built up from changes given to call back */
+static int incumbent_calls = 0;
+static double incumbent[5];
+static double incumbent_objective = 0.0;
+
+void (COINLINKAGE_CB test_incumbent_callback)(Cbc_Model * model,
+        int numberChanged, const int * which, const double * values,
+        double objectiveValue, const char * source, double seconds,
+        void * userData) {
+
+    int i;
+    assert(userData == (void *) incumbent);
+    assert(source != NULL);
+    assert(seconds >= 0.0);
+    for (i = 0; i < numberChanged; i++) {
+        assert(which[i] >= 0 && which[i] < 5);
+        incumbent[which[i]] = values[i];
+    }
+    /* maximizing so each is better */
+    if (incumbent_calls)
+        assert(objectiveValue >= incumbent_objective - 1e-6);
+    incumbent_objective = objectiveValue;
+    incumbent_calls++;
+
+}
+
+void testIncumbentCallBack() {
+
+    Cbc_Model *model = knapsackModel(10.0);
+    double obj[] = {5, 3, 2, 7, 4};
+    const double *sol;
+    double value = 0.0;
+    int i;
+
+    for (i = 0; i < 5; i++)
+        incumbent[i] = 0.0;
+    /* so all columns are given */
+    Cbc_setParameter(model, "preprocess", "off");
+    Cbc_setIncumbentCallBack(model, test_incumbent_callback, incumbent);
+    Cbc_solve(model);
+    assert(Cbc_isProvenOptimal(model));
+    assert(incumbent_calls > 0);
+    assert(fabs(incumbent_objective - 16.0) < 1e-6);
+    sol = Cbc_getColSolution(model);
+    for (i = 0; i < 5; i++) {
+        assert(fabs(incumbent[i] - sol[i]) < 1e-6);
+        value += obj[i] * incumbent[i];
+    }
+    assert(fabs(value - 16.0) < 1e-6);
+
+    /* removed - not called again */
+    Cbc_setIncumbentCallBack(model, NULL, NULL);
+    incumbent_calls = 0;
+    Cbc_solve(model);
+    assert(incumbent_calls == 0);
+    Cbc_deleteModel(model);
+
+}
+
 
 int main() {
 
@@ -381,6 +683,16 @@ int main() {
     testProblemModification();*/
     printf("Integer bounds test\n");
     testIntegerBounds();
+    printf("Assign problem test\n");
+    testAssignProblem();
+    printf("Solve batch test\n");
+    testSolveBatch();
+    printf("Async solve test\n");
+    testAsyncSolve();
+    printf("Estimate remaining test\n");
+    testEstimateRemaining();
+    printf("Incumbent call back test\n");
+    testIncumbentCallBack();
 
     return 0;
 }
@@ -0,0 +1,409 @@
+// $Id$
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+/*
+  Benchmark runner for Cbc.
+
+  cbcBenchmark manifest [-directory dir] [-json file] [-baseline file]
+               [-tolerance fraction] [-floor seconds]
+               [-threads 1,4] [-seeds 0,1] [-- cbc settings]
+
+  The manifest has one instance per line - name and known optimal value
+  (blank lines and lines starting with # are ignored).  Each instance is
+  read from directory/name.mps (or .mps.gz) and solved by CbcMain1 with
+  the given cbc settings for each number of threads and each seed (seed 0
+  leaves the default).  One JSON object per run is written with wall
+  time, time to first solution, primal integral, final gap, nodes and
+  nodes per second.
+
+  If a baseline (a previous JSON output) is given, a run fails if the
+  objective is wrong, or if wall time or primal integral is worse than
+  baseline*(1+tolerance)+floor.  The exit code is the number of failures.
+*/
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
+#include "OsiClpSolverInterface.hpp"
+#include "CbcModel.hpp"
+#include "CbcSolver.hpp"
+#include "CbcIncumbentStream.hpp"
+
+namespace {
+
+// One instance from manifest
+struct Instance {
+    std::string name;
+    double optimalValue;
+};
+
+// Results of one run
+struct Run {
+    std::string name;
+    int numberThreads;
+    int seed;
+    double optimalValue;
+    double startTime;
+    // incumbent history (wall seconds, objective)
+    std::vector<double> incumbentTimes;
+    std::vector<double> incumbentValues;
+    // from end of branch and bound
+    bool haveBab;
+    bool proven;
+    double bestPossible;
+    int numberNodes;
+    // final
+    double objectiveValue;
+    double wallTime;
+    double firstSolutionTime;
+    double primalIntegral;
+    double gap;
+    double nodesPerSecond;
+    bool objectiveCorrect;
+};
+
+// Seed to use (set before each run)
+int currentSeed = 0;
+Run * currentRun = NULL;
+
+// Primal gap function (Berthold) for incumbent value against optimal
+double primalGap(double value, double optimalValue)
+{
+    if (fabs(value - optimalValue) < 1.0e-9)
+        return 0.0;
+    if (value * optimalValue < 0.0)
+        return 1.0;
+    return fabs(optimalValue - value) /
+           CoinMax(fabs(optimalValue), fabs(value));
+}
+
+// Each new incumbent
+void incumbentCallBack(const CbcIncumbentDelta & delta, void * userData)
+{
+    Run * run = reinterpret_cast<Run *> (userData);
+    run->incumbentTimes.push_back(CoinGetTimeOfDay() - run->startTime);
+    run->incumbentValues.push_back(delta.objectiveValue);
+}
+
+// Call back from CbcMain1
+int benchmarkCallBack(CbcModel * model, int whereFrom)
+{
+    if (whereFrom == 3) {
+        if (currentSeed) {
+            model->setRandomSeed(currentSeed);
+            model->randomNumberGenerator()->setSeed(currentSeed);
+        }
+    } else if (whereFrom == 4 && currentRun) {
+        currentRun->haveBab = true;
+        currentRun->proven = model->isProvenOptimal();
+        currentRun->bestPossible = model->getBestPossibleObjValue();
+        currentRun->numberNodes = model->getNodeCount();
+    }
+    return 0;
+}
+
+// Comma separated integers
+std::vector<int> readList(const char * text)
+{
+    std::vector<int> list;
+    while (*text) {
+        list.push_back(atoi(text));
+        const char * comma = strchr(text, ',');
+        if (!comma)
+            break;
+        text = comma + 1;
+    }
+    return list;
+}
+
+// Read manifest - returns false if can't open
+bool readManifest(const char * fileName, std::vector<Instance> & instances)
+{
+    FILE * fp = fopen(fileName, "r");
+    if (!fp)
+        return false;
+    char line[1000];
+    while (fgets(line, sizeof(line), fp)) {
+        char name[1000];
+        double value;
+        char * start = line;
+        while (*start == ' ' || *start == '\t')
+            start++;
+        if (*start == '#' || *start == '\n' || !*start)
+            continue;
+        if (sscanf(start, "%s %lf", name, &value) == 2) {
+            Instance instance;
+            instance.name = name;
+            instance.optimalValue = value;
+            instances.push_back(instance);
+        } else {
+            fprintf(stderr, "Bad manifest line %s", line);
+        }
+    }
+    fclose(fp);
+    return true;
+}
+
+// Finish statistics for a run
+void finishRun(Run & run, CbcModel & model)
+{
+    run.wallTime = CoinGetTimeOfDay() - run.startTime;
+    int numberIncumbents = static_cast<int>(run.incumbentTimes.size());
+    run.objectiveValue = numberIncumbents ? run.incumbentValues[numberIncumbents - 1]
+                         : COIN_DBL_MAX;
+    if (model.bestSolution() && !numberIncumbents)
+        run.objectiveValue = model.getObjValue();
+    run.firstSolutionTime = numberIncumbents ? run.incumbentTimes[0] : -1.0;
+    // gap function is 1 until first solution then steps
+    double integral = 0.0;
+    double lastTime = 0.0;
+    double lastGap = 1.0;
+    for (int i = 0; i < numberIncumbents; i++) {
+        double time = CoinMin(run.incumbentTimes[i], run.wallTime);
+        integral += lastGap * (time - lastTime);
+        lastTime = time;
+        lastGap = primalGap(run.incumbentValues[i], run.optimalValue);
+    }
+    integral += lastGap * (run.wallTime - lastTime);
+    run.primalIntegral = integral;
+    if (run.objectiveValue < 1.0e50 && run.haveBab) {
+        double bound = run.proven ? run.objectiveValue : run.bestPossible;
+        run.gap = fabs(run.objectiveValue - bound) /
+                  CoinMax(1.0e-10, fabs(run.objectiveValue));
+    } else {
+        run.gap = -1.0;
+    }
+    run.nodesPerSecond = run.wallTime > 0.0 ? run.numberNodes / run.wallTime : 0.0;
+    run.objectiveCorrect = fabs(run.objectiveValue - run.optimalValue) <=
+                           1.0e-5 * (1.0 + fabs(run.optimalValue));
+}
+
+// Write one run as a line of JSON
+void writeRun(FILE * fp, const Run & run, bool first)
+{
+    fprintf(fp, "%s  {\"instance\": \"%s\", \"threads\": %d, \"seed\": %d, "
+            "\"optimal\": %.15g, \"objective\": %.15g, \"correct\": %s, "
+            "\"wallTime\": %.6f, \"firstSolutionTime\": %.6f, "
+            "\"primalIntegral\": %.6f, \"gap\": %.10g, \"nodes\": %d, "
+            "\"nodesPerSecond\": %.3f}",
+            first ? "" : ",\n", run.name.c_str(), run.numberThreads, run.seed,
+            run.optimalValue,
+            run.objectiveValue < 1.0e50 ? run.objectiveValue : 1.0e50,
+            run.objectiveCorrect ? "true" : "false",
+            run.wallTime, run.firstSolutionTime, run.primalIntegral, run.gap,
+            run.numberNodes, run.nodesPerSecond);
+}
+
+// Value of field in a line of our JSON (false if not there)
+bool jsonField(const char * line, const char * field, std::string & value)
+{
+    std::string key = std::string("\"") + field + "\": ";
+    const char * where = strstr(line, key.c_str());
+    if (!where)
+        return false;
+    where += key.size();
+    if (*where == '"') {
+        where++;
+        const char * end = strchr(where, '"');
+        if (!end)
+            return false;
+        value.assign(where, end - where);
+    } else {
+        const char * end = where;
+        while (*end && *end != ',' && *end != '}')
+            end++;
+        value.assign(where, end - where);
+    }
+    return true;
+}
+
+// Baseline key
+std::string runKey(const std::string & name, int numberThreads, int seed)
+{
+    char key[1100];
+    sprintf(key, "%s/%d/%d", name.c_str(), numberThreads, seed);
+    return std::string(key);
+}
+
+// Read baseline - wall time and primal integral per run
+bool readBaseline(const char * fileName,
+                  std::map<std::string, std::pair<double, double> > & baseline)
+{
+    FILE * fp = fopen(fileName, "r");
+    if (!fp)
+        return false;
+    char line[4000];
+    while (fgets(line, sizeof(line), fp)) {
+        std::string name, threads, seed, wallTime, integral;
+        if (jsonField(line, "instance", name) &&
+                jsonField(line, "threads", threads) &&
+                jsonField(line, "seed", seed) &&
+                jsonField(line, "wallTime", wallTime) &&
+                jsonField(line, "primalIntegral", integral)) {
+            baseline[runKey(name, atoi(threads.c_str()), atoi(seed.c_str()))] =
+                std::make_pair(atof(wallTime.c_str()), atof(integral.c_str()));
+        }
+    }
+    fclose(fp);
+    return true;
+}
+}
+
+int main (int argc, const char *argv[])
+{
+    WindowsErrorPopupBlocker();
+    if (argc < 2) {
+        fprintf(stderr, "Usage: cbcBenchmark manifest [-directory dir] [-json file]"
+                " [-baseline file] [-tolerance fraction] [-floor seconds]"
+                " [-threads 1,4] [-seeds 0,1] [-- cbc settings]\n");
+        return 1;
+    }
+    std::string directory = ".";
+    const char * jsonName = NULL;
+    const char * baselineName = NULL;
+    double tolerance = 0.2;
+    double noiseFloor = 1.0;
+    std::vector<int> threadList(1, 0);
+    std::vector<int> seedList(1, 0);
+    std::vector<const char *> settings;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--") {
+            for (i++; i < argc; i++)
+                settings.push_back(argv[i]);
+        } else if (i + 1 < argc && arg == "-directory") {
+            directory = argv[++i];
+        } else if (i + 1 < argc && arg == "-json") {
+            jsonName = argv[++i];
+        } else if (i + 1 < argc && arg == "-baseline") {
+            baselineName = argv[++i];
+        } else if (i + 1 < argc && arg == "-tolerance") {
+            tolerance = atof(argv[++i]);
+        } else if (i + 1 < argc && arg == "-floor") {
+            noiseFloor = atof(argv[++i]);
+        } else if (i + 1 < argc && arg == "-threads") {
+            threadList = readList(argv[++i]);
+        } else if (i + 1 < argc && arg == "-seeds") {
+            seedList = readList(argv[++i]);
+        } else {
+            fprintf(stderr, "Unknown argument %s\n", argv[i]);
+            return 1;
+        }
+    }
+    std::vector<Instance> instances;
+    if (!readManifest(argv[1], instances)) {
+        fprintf(stderr, "Unable to open manifest %s\n", argv[1]);
+        return 1;
+    }
+    std::map<std::string, std::pair<double, double> > baseline;
+    if (baselineName && !readBaseline(baselineName, baseline)) {
+        fprintf(stderr, "Unable to open baseline %s\n", baselineName);
+        return 1;
+    }
+    FILE * fp = jsonName ? fopen(jsonName, "w") : stdout;
+    if (!fp) {
+        fprintf(stderr, "Unable to open %s\n", jsonName);
+        return 1;
+    }
+    int numberRuns = static_cast<int>(instances.size() * threadList.size() *
+                                      seedList.size());
+    int numberFailures = 0;
+    int iRun = 0;
+    int numberWritten = 0;
+    fprintf(fp, "{\"runs\": [\n");
+    for (size_t iInstance = 0; iInstance < instances.size(); iInstance++) {
+        const Instance & instance = instances[iInstance];
+        std::string fileName = directory + "/" + instance.name;
+        for (size_t iThread = 0; iThread < threadList.size(); iThread++) {
+            for (size_t iSeed = 0; iSeed < seedList.size(); iSeed++) {
+                Run run;
+                run.name = instance.name;
+                run.numberThreads = threadList[iThread];
+                run.seed = seedList[iSeed];
+                run.optimalValue = instance.optimalValue;
+                run.haveBab = false;
+                run.proven = false;
+                run.bestPossible = -COIN_DBL_MAX;
+                run.numberNodes = 0;
+                iRun++;
+                OsiClpSolverInterface solver;
+                solver.messageHandler()->setLogLevel(0);
+                if (solver.readMps(fileName.c_str(), "mps")) {
+                    fprintf(stderr, "Unable to read %s\n", fileName.c_str());
+                    numberFailures++;
+                    continue;
+                }
+                CbcModel model(solver);
+                CbcSolverUsefulData parameterData;
+                CbcMain0(model, parameterData);
+                CbcIncumbentStream stream(incumbentCallBack, &run);
+                model.passInEventHandler(&stream);
+                char threadText[20];
+                sprintf(threadText, "%d", run.numberThreads);
+                std::vector<const char *> args;
+                args.push_back("cbcBenchmark");
+                args.push_back("-threads");
+                args.push_back(threadText);
+                args.insert(args.end(), settings.begin(), settings.end());
+                args.push_back("-solve");
+                args.push_back("-quit");
+                fprintf(stderr, "Run %d of %d - %s threads %d seed %d\n",
+                        iRun, numberRuns, run.name.c_str(),
+                        run.numberThreads, run.seed);
+                currentSeed = run.seed;
+                currentRun = &run;
+                run.startTime = CoinGetTimeOfDay();
+                CbcMain1(static_cast<int>(args.size()), &args[0], model,
+                         benchmarkCallBack, parameterData);
+                currentRun = NULL;
+                finishRun(run, model);
+                writeRun(fp, run, !numberWritten);
+                numberWritten++;
+                fflush(fp);
+                bool failed = false;
+                if (run.proven && !run.objectiveCorrect) {
+                    fprintf(stderr, "%s - objective %g should be %g\n",
+                            run.name.c_str(), run.objectiveValue, run.optimalValue);
+                    failed = true;
+                }
+                std::map<std::string, std::pair<double, double> >::const_iterator it =
+                    baseline.find(runKey(run.name, run.numberThreads, run.seed));
+                if (it != baseline.end()) {
+                    double baseWall = it->second.first;
+                    double baseIntegral = it->second.second;
+                    if (run.wallTime > baseWall * (1.0 + tolerance) + noiseFloor) {
+                        fprintf(stderr, "%s - wall time %g against baseline %g\n",
+                                run.name.c_str(), run.wallTime, baseWall);
+                        failed = true;
+                    }
+                    if (run.primalIntegral > baseIntegral * (1.0 + tolerance) + noiseFloor) {
+                        fprintf(stderr, "%s - primal integral %g against baseline %g\n",
+                                run.name.c_str(), run.primalIntegral, baseIntegral);
+                        failed = true;
+                    }
+                }
+                if (failed)
+                    numberFailures++;
+            }
+        }
+    }
+    fprintf(fp, "\n]}\n");
+    if (fp != stdout)
+        fclose(fp);
+    fprintf(stderr, "Finished - %d runs, %d failures\n", numberRuns, numberFailures);
+    return numberFailures;
+}
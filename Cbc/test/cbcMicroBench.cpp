@@ -0,0 +1,439 @@
+// $Id$
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+/*
+  Microbenchmarks for Cbc data structures.
+
+  cbcMicroBench [-scale n] [-seed n]
+
+  Each benchmark times one operation on synthetic data and prints
+  operations per second and allocations (count and bytes) per operation.
+  Allocations are counted by replacing global operator new so they
+  include everything done inside Cbc, Clp and CoinUtils.
+
+    tree            CbcTree push, bestNode, pop and cleanTree (nothing
+                    pruned) on nodes with random objectives
+    rowCuts         CbcRowCuts::addCutIfNotDuplicate on a stream of cuts
+                    with some duplicates
+    createInfo      CbcNode::createInfo at root and creation of partial
+                    node info for children (as createInfo does below root)
+    walkback        walk from node to root and apply node info as
+                    CbcModel::addCuts1 does, at several depths
+    feasible        CbcModel::feasibleSolution with many integer objects
+
+  The non-root createInfo and addCuts1 need state set up inside
+  branchAndBound so they are reproduced here with the same calls.
+*/
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinTime.hpp"
+#include "CoinWarmStartBasis.hpp"
+#include "OsiClpSolverInterface.hpp"
+#include "OsiRowCut.hpp"
+#include "CbcModel.hpp"
+#include "CbcTree.hpp"
+#include "CbcNode.hpp"
+#include "CbcFullNodeInfo.hpp"
+#include "CbcPartialNodeInfo.hpp"
+#include "CbcCompareDefault.hpp"
+#include "CbcCountRowCut.hpp"
+
+// Allocation counting
+static double numberAllocations = 0.0;
+static double bytesAllocated = 0.0;
+
+#if __cplusplus >= 201103L
+#define CBC_THROW_BAD_ALLOC
+#define CBC_THROW_NOTHING noexcept
+#else
+#define CBC_THROW_BAD_ALLOC throw(std::bad_alloc)
+#define CBC_THROW_NOTHING throw()
+#endif
+
+void * operator new(size_t size) CBC_THROW_BAD_ALLOC
+{
+    numberAllocations++;
+    bytesAllocated += size;
+    void * p = malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void * p) CBC_THROW_NOTHING
+{
+    free(p);
+}
+
+void * operator new[](size_t size) CBC_THROW_BAD_ALLOC
+{
+    return operator new(size);
+}
+
+void operator delete[](void * p) CBC_THROW_NOTHING
+{
+    free(p);
+}
+
+namespace {
+
+// Timer which also counts allocations
+class Measure {
+public:
+    Measure(const char * name)
+        : name_(name) {
+        startAllocations_ = numberAllocations;
+        startBytes_ = bytesAllocated;
+        startTime_ = CoinGetTimeOfDay();
+    }
+    // Stop and print
+    void report(double numberOperations) {
+        double time = CoinGetTimeOfDay() - startTime_;
+        double allocations = numberAllocations - startAllocations_;
+        double bytes = bytesAllocated - startBytes_;
+        if (numberOperations <= 0.0)
+            numberOperations = 1.0;
+        printf("%-32s %12.0f ops %10.4f sec %14.1f ops/sec %8.2f allocs/op %10.1f bytes/op\n",
+               name_.c_str(), numberOperations, time,
+               time > 0.0 ? numberOperations / time : 0.0,
+               allocations / numberOperations, bytes / numberOperations);
+    }
+private:
+    std::string name_;
+    double startTime_;
+    double startAllocations_;
+    double startBytes_;
+};
+
+// Random 0-1 (own generator so results repeat across platforms)
+unsigned int randomSeed = 12345;
+inline double randomDouble()
+{
+    randomSeed = 1664525 * randomSeed + 1013904223;
+    return static_cast<double>(randomSeed >> 8) / 16777216.0;
+}
+inline int randomInt(int n)
+{
+    return static_cast<int>(randomDouble() * n) % n;
+}
+
+// Random set covering problem with binary columns
+void makeProblem(OsiClpSolverInterface & solver, int numberRows,
+                 int numberColumns, int perColumn)
+{
+    std::vector<CoinBigIndex> start(numberColumns + 1);
+    std::vector<int> row;
+    std::vector<double> element;
+    std::vector<double> objective(numberColumns);
+    std::vector<double> columnLower(numberColumns, 0.0);
+    std::vector<double> columnUpper(numberColumns, 1.0);
+    std::vector<double> rowLower(numberRows, 1.0);
+    std::vector<double> rowUpper(numberRows, COIN_DBL_MAX);
+    std::vector<char> used(numberRows, 0);
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+        start[iColumn] = static_cast<CoinBigIndex>(row.size());
+        objective[iColumn] = 1.0 + randomInt(100);
+        for (int j = 0; j < perColumn; j++) {
+            int iRow = randomInt(numberRows);
+            if (!used[iRow]) {
+                used[iRow] = 1;
+                row.push_back(iRow);
+                element.push_back(1.0);
+            }
+        }
+        for (CoinBigIndex j = start[iColumn]; j < static_cast<CoinBigIndex>(row.size()); j++)
+            used[row[j]] = 0;
+    }
+    start[numberColumns] = static_cast<CoinBigIndex>(row.size());
+    std::vector<int> length(numberColumns);
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+        length[iColumn] = start[iColumn+1] - start[iColumn];
+    CoinPackedMatrix matrix(true, numberRows, numberColumns,
+                            start[numberColumns], &element[0], &row[0],
+                            &start[0], &length[0]);
+    solver.loadProblem(matrix, &columnLower[0], &columnUpper[0], &objective[0],
+                       &rowLower[0], &rowUpper[0]);
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+        solver.setInteger(iColumn);
+    solver.messageHandler()->setLogLevel(0);
+    solver.initialSolve();
+}
+
+// Delete a node which has not been branched on
+void deleteNode(CbcNode * node)
+{
+    // same as CbcTree::cleanTree
+    if (node->nodeInfo())
+        node->nodeInfo()->throwAway();
+    delete node;
+}
+
+void benchmarkTree(CbcModel & model, int numberNodes)
+{
+    CbcTree tree;
+    CbcCompareDefault compare;
+    tree.setComparison(compare);
+    std::vector<CbcNode *> nodes(numberNodes);
+    for (int i = 0; i < numberNodes; i++) {
+        CbcNode * node = new CbcNode();
+        node->createInfo(&model, NULL, NULL, NULL, NULL, 0, 0);
+        node->setObjectiveValue(1000.0 * randomDouble());
+        node->setDepth(randomInt(50));
+        node->setNumberUnsatisfied(randomInt(100));
+        nodes[i] = node;
+    }
+    {
+        Measure measure("CbcTree::push");
+        for (int i = 0; i < numberNodes; i++)
+            tree.push(nodes[i]);
+        measure.report(numberNodes);
+    }
+    {
+        Measure measure("CbcTree::bestNode");
+        int n = 0;
+        while (!tree.empty()) {
+            CbcNode * node = tree.bestNode(COIN_DBL_MAX);
+            if (!node)
+                break;
+            n++;
+        }
+        measure.report(n);
+    }
+    for (int i = 0; i < numberNodes; i++)
+        tree.push(nodes[i]);
+    {
+        Measure measure("CbcTree::cleanTree (no pruning)");
+        double bestPossible;
+        int numberPasses = 10;
+        for (int iPass = 0; iPass < numberPasses; iPass++)
+            tree.cleanTree(&model, COIN_DBL_MAX, bestPossible);
+        measure.report(static_cast<double>(numberPasses) * numberNodes);
+    }
+    {
+        Measure measure("CbcTree::top+pop");
+        int n = 0;
+        while (!tree.empty()) {
+            tree.top();
+            tree.pop();
+            n++;
+        }
+        measure.report(n);
+    }
+    for (int i = 0; i < numberNodes; i++)
+        deleteNode(nodes[i]);
+}
+
+void benchmarkRowCuts(int numberColumns, int numberCuts, double duplicateFraction)
+{
+    // make cuts first
+    std::vector<OsiRowCut> cuts;
+    cuts.reserve(numberCuts);
+    std::vector<int> indices;
+    std::vector<double> elements;
+    std::vector<char> used(numberColumns, 0);
+    for (int i = 0; i < numberCuts; i++) {
+        if (i && randomDouble() < duplicateFraction) {
+            OsiRowCut copy = cuts[randomInt(i)];
+            cuts.push_back(copy);
+            continue;
+        }
+        int length = 2 + randomInt(30);
+        indices.clear();
+        elements.clear();
+        for (int j = 0; j < length; j++) {
+            int iColumn = randomInt(numberColumns);
+            if (!used[iColumn]) {
+                used[iColumn] = 1;
+                indices.push_back(iColumn);
+                elements.push_back(1.0 + randomInt(5));
+            }
+        }
+        for (size_t j = 0; j < indices.size(); j++)
+            used[indices[j]] = 0;
+        OsiRowCut cut;
+        cut.setRow(static_cast<int>(indices.size()), &indices[0], &elements[0]);
+        cut.setLb(-COIN_DBL_MAX);
+        cut.setUb(static_cast<double>(indices.size()) - 1.0);
+        cuts.push_back(cut);
+    }
+    CbcRowCuts pool;
+    Measure measure("CbcRowCuts::addCutIfNotDuplicate");
+    int numberAdded = 0;
+    for (int i = 0; i < numberCuts; i++) {
+        if (!pool.addCutIfNotDuplicate(cuts[i]))
+            numberAdded++;
+    }
+    measure.report(numberCuts);
+    printf("%-32s %d of %d cuts added\n", "", numberAdded, numberCuts);
+}
+
+// Partial node info below parent - as createInfo (one bound change)
+CbcNodeInfo * makeChild(CbcModel & model, CbcNodeInfo * parent,
+                        const CoinWarmStartBasis & lastws)
+{
+    OsiSolverInterface * solver = model.solver();
+    CoinWarmStartBasis * ws =
+        dynamic_cast<CoinWarmStartBasis *> (solver->getWarmStart());
+    // as if a few pivots
+    int numberColumns = ws->getNumStructural();
+    for (int i = 0; i < 5; i++) {
+        int iColumn = randomInt(numberColumns);
+        ws->setStructStatus(iColumn, ws->getStructStatus(iColumn) ==
+                            CoinWarmStartBasis::basic ?
+                            CoinWarmStartBasis::atLowerBound :
+                            CoinWarmStartBasis::basic);
+    }
+    CoinWarmStartDiff * basisDiff = ws->generateDiff(&lastws);
+    int variable = randomInt(numberColumns);
+    double bound;
+    if (randomDouble() < 0.5) {
+        bound = 0.0;
+        variable |= 0x80000000;
+    } else {
+        bound = 1.0;
+    }
+    CbcNodeInfo * info = new CbcPartialNodeInfo(parent, NULL, 1, &variable,
+                                                &bound, basisDiff);
+    delete basisDiff;
+    delete ws;
+    return info;
+}
+
+// Delete chain from leaf to root
+void deleteChain(std::vector<CbcNodeInfo *> & chain)
+{
+    for (int i = static_cast<int>(chain.size()) - 1; i >= 0; i--) {
+        chain[i]->nullParent();
+        chain[i]->throwAway();
+        delete chain[i];
+    }
+    chain.clear();
+}
+
+void benchmarkNodeInfo(CbcModel & model, int numberReps)
+{
+    OsiSolverInterface * solver = model.solver();
+    int numberRows = solver->getNumRows();
+    int numberColumns = solver->getNumCols();
+    {
+        Measure measure("CbcNode::createInfo (root)");
+        for (int i = 0; i < numberReps; i++) {
+            CbcNode * node = new CbcNode();
+            node->createInfo(&model, NULL, NULL, NULL, NULL, 0, 0);
+            deleteNode(node);
+        }
+        measure.report(numberReps);
+    }
+    CoinWarmStartBasis * lastws =
+        dynamic_cast<CoinWarmStartBasis *> (solver->getWarmStart());
+    std::vector<CbcNodeInfo *> chain;
+    chain.push_back(new CbcFullNodeInfo(&model, numberRows));
+    {
+        Measure measure("createInfo (partial)");
+        for (int i = 0; i < numberReps; i++)
+            chain.push_back(makeChild(model, chain.back(), *lastws));
+        measure.report(numberReps);
+    }
+    delete lastws;
+    // save bounds as applyToModel changes them
+    std::vector<double> lower(solver->getColLower(),
+                              solver->getColLower() + numberColumns);
+    std::vector<double> upper(solver->getColUpper(),
+                              solver->getColUpper() + numberColumns);
+    std::vector<CbcNodeInfo *> walkback;
+    walkback.reserve(chain.size());
+    int depths[] = {10, 100, 1000, 10000};
+    for (int iDepth = 0; iDepth < 4; iDepth++) {
+        int depth = depths[iDepth];
+        if (depth >= static_cast<int>(chain.size()))
+            break;
+        CbcNodeInfo * leaf = chain[depth];
+        int numberWalks = CoinMax(1, 10 * numberReps / depth);
+        char name[40];
+        sprintf(name, "walkback depth %d", depth);
+        Measure measure(name);
+        for (int i = 0; i < numberWalks; i++) {
+            // as CbcModel::addCuts1
+            walkback.clear();
+            for (CbcNodeInfo * nodeInfo = leaf; nodeInfo; nodeInfo = nodeInfo->parent())
+                walkback.push_back(nodeInfo);
+            CoinWarmStartBasis * basis = model.getEmptyBasis();
+            basis->setSize(numberColumns, numberRows);
+            int currentNumberCuts = 0;
+            for (int j = static_cast<int>(walkback.size()) - 1; j >= 0; j--)
+                walkback[j]->applyToModel(&model, basis, NULL, currentNumberCuts);
+            delete basis;
+        }
+        measure.report(numberWalks);
+    }
+    solver->setColLower(&lower[0]);
+    solver->setColUpper(&upper[0]);
+    deleteChain(chain);
+}
+
+void benchmarkFeasible(CbcModel & model, int numberReps)
+{
+    model.findIntegers(true);
+    int numberIntegerInfeasibilities;
+    int numberObjectInfeasibilities;
+    char name[60];
+    sprintf(name, "feasibleSolution %d objects", model.numberObjects());
+    Measure measure(name);
+    for (int i = 0; i < numberReps; i++)
+        model.feasibleSolution(numberIntegerInfeasibilities,
+                               numberObjectInfeasibilities);
+    measure.report(numberReps);
+}
+}
+
+int main (int argc, const char *argv[])
+{
+    WindowsErrorPopupBlocker();
+    int scale = 1;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 < argc && arg == "-scale") {
+            scale = CoinMax(1, atoi(argv[++i]));
+        } else if (i + 1 < argc && arg == "-seed") {
+            randomSeed = static_cast<unsigned int>(atoi(argv[++i]));
+        } else {
+            fprintf(stderr, "Usage: cbcMicroBench [-scale n] [-seed n]\n");
+            return 1;
+        }
+    }
+    // small model for tree (node info size does not matter)
+    OsiClpSolverInterface smallSolver;
+    makeProblem(smallSolver, 10, 20, 3);
+    CbcModel smallModel(smallSolver);
+    smallModel.messageHandler()->setLogLevel(0);
+    benchmarkTree(smallModel, 100000 * scale);
+
+    benchmarkRowCuts(10000, 100000 * scale, 0.2);
+
+    OsiClpSolverInterface solver;
+    makeProblem(solver, 1000, 5000, 5);
+    CbcModel model(solver);
+    model.messageHandler()->setLogLevel(0);
+    benchmarkNodeInfo(model, 2000 * scale);
+
+    OsiClpSolverInterface bigSolver;
+    makeProblem(bigSolver, 2000, 200000, 3);
+    CbcModel bigModel(bigSolver);
+    bigModel.messageHandler()->setLogLevel(0);
+    benchmarkFeasible(bigModel, 100 * scale);
+    return 0;
+}
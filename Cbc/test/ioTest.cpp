@@ -0,0 +1,684 @@
+// $Id$
+// Copyright (C) 2015, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+#include <cassert>
+#include <cstdio>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+#include "CoinHelperFunctions.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "OsiClpSolverInterface.hpp"
+#include "CbcMpsImport.hpp"
+#include "CbcSnapshot.hpp"
+#include "CbcModel.hpp"
+#include "CbcMipStartIO.hpp"
+#include "CbcConfig.h"
+#include "CbcEventHandler.hpp"
+#include "CbcHeuristic.hpp"
+#include "CbcMemory.hpp"
+#include "CbcSimpleIntegerDynamicPseudoCost.hpp"
+#include "CglProbing.hpp"
+#define testtol 1e-9
+/** Fast MPS reader (CbcMpsImport) must give same problem as CoinMpsIO
+ * and must give up (-1) on duplicates and anything malformed */
+void mpsImport(int& error_count, int& warning_count);
+/** Snapshot (CbcSnapshot) keeps original model and names and rejects
+ * truncated or inconsistent files */
+void snapshot(int& error_count, int& warning_count);
+/** Text mipstart (readMIPStart) is read in 1MB blocks - lines across
+ * block boundaries and lines longer than a block must be kept whole */
+void mipStart(int& error_count, int& warning_count);
+/** Options set on model before CbcMain1 or by parameters (work clock,
+ * pin threads) must be set on the model doing branch and bound */
+void modelOptions(int& error_count, int& warning_count);
+/** When branch and bound with threads gets near maximum memory the
+ * thread models must also stop cuts (and heuristics) */
+void memoryLimit(int& error_count, int& warning_count);
+/** resolveIncremental keeps incumbent and cuts while a change leaves
+ * them valid and drops them when not - pseudocosts are kept even if
+ * objects are made again */
+void resolve(int& error_count, int& warning_count);
+int main (int argc, const char *argv[])
+{
+   WindowsErrorPopupBlocker();
+   int error_count = 0;
+   int warning_count = 0;
+
+   mpsImport(error_count, warning_count);
+   cout << "\n***********************\n" << endl;
+   snapshot(error_count, warning_count);
+   cout << "\n***********************\n" << endl;
+   mipStart(error_count, warning_count);
+   cout << "\n***********************\n" << endl;
+   modelOptions(error_count, warning_count);
+   cout << "\n***********************\n" << endl;
+   memoryLimit(error_count, warning_count);
+   cout << "\n***********************\n" << endl;
+   resolve(error_count, warning_count);
+
+   cout << endl << "Finished - there have been " << error_count << " errors and " << warning_count << " warnings." << endl;
+   return error_count;
+}
+static void writeFile(const char * name, const char * text)
+{
+   FILE * fp = fopen(name, "w");
+   assert(fp);
+   fputs(text, fp);
+   fclose(fp);
+}
+// Write large file so COLUMNS is split between threads - duplicate
+// entry in middle column if wanted
+static void writeLargeFile(const char * name, bool duplicate)
+{
+   FILE * fp = fopen(name, "w");
+   assert(fp);
+   int numberRows = 200;
+   int numberColumns = 40000;
+   fprintf(fp, "NAME          LARGE\nROWS\n N  COST\n");
+   for (int i = 0; i < numberRows; i++)
+      fprintf(fp, " %c  R%d\n", (i % 3 == 0) ? 'E' : ((i % 3 == 1) ? 'L' : 'G'), i);
+   fprintf(fp, "COLUMNS\n");
+   fprintf(fp, "    MARKER                 'MARKER'                 'INTORG'\n");
+   for (int j = 0; j < numberColumns; j++) {
+      if (j == numberColumns / 2)
+         fprintf(fp, "    MARKER                 'MARKER'                 'INTEND'\n");
+      fprintf(fp, "    C%d  COST  %g  R%d  %g\n", j, 1.0 + (j % 7),
+              j % numberRows, 1.0 + (j % 5));
+      fprintf(fp, "    C%d  R%d  %g\n", j, (j + 1) % numberRows, -1.0 - (j % 3));
+      fprintf(fp, "    C%d  R%d  %g\n", j, (j + 7) % numberRows, 0.5);
+      if (duplicate && j == numberColumns / 2 + 1)
+         fprintf(fp, "    C%d  R%d  %g\n", j, j % numberRows, 2.0);
+   }
+   fprintf(fp, "RHS\n");
+   for (int i = 0; i < numberRows; i++)
+      fprintf(fp, "    RHS  R%d  %g\n", i, 10.0 + i);
+   fprintf(fp, "BOUNDS\n");
+   for (int j = numberColumns / 2; j < numberColumns; j += 3)
+      fprintf(fp, " UP BND  C%d  %g\n", j, 4.0);
+   fprintf(fp, "ENDATA\n");
+   fclose(fp);
+}
+// Read with CbcMpsImport (returns -1 if not handled)
+static int fastRead(const char * name, int numberThreads,
+                    OsiClpSolverInterface & solver)
+{
+   CbcMpsImport fastImport;
+   int returnCode = fastImport.readMps(name, numberThreads);
+   if (!returnCode)
+      fastImport.assignProblem(&solver);
+   return returnCode;
+}
+// Compare two problems
+static bool sameProblem(const OsiSolverInterface & a, const OsiSolverInterface & b)
+{
+   int numberRows = a.getNumRows();
+   int numberColumns = a.getNumCols();
+   if (numberRows != b.getNumRows() || numberColumns != b.getNumCols() ||
+       a.getNumElements() != b.getNumElements())
+      return false;
+   for (int i = 0; i < numberRows; i++) {
+      if (fabs(a.getRowLower()[i] - b.getRowLower()[i]) > testtol ||
+          fabs(a.getRowUpper()[i] - b.getRowUpper()[i]) > testtol)
+         return false;
+   }
+   for (int j = 0; j < numberColumns; j++) {
+      if (fabs(a.getColLower()[j] - b.getColLower()[j]) > testtol ||
+          fabs(a.getColUpper()[j] - b.getColUpper()[j]) > testtol ||
+          fabs(a.getObjCoefficients()[j] - b.getObjCoefficients()[j]) > testtol ||
+          a.isInteger(j) != b.isInteger(j))
+         return false;
+   }
+   return a.getMatrixByCol()->isEquivalent(*b.getMatrixByCol());
+}
+void mpsImport(int& error_count, int& warning_count) {
+   // Small valid file - markers, ranges, most bound types, explicit zero
+   writeFile("fastmps1.mps",
+             "NAME          SMALL\n"
+             "ROWS\n"
+             " N  COST\n"
+             " L  LIM1\n"
+             " G  LIM2\n"
+             " E  MYEQN\n"
+             "COLUMNS\n"
+             "    X1        COST         1.0   LIM1         1.0\n"
+             "    X1        LIM2         1.0\n"
+             "    MARKER                 'MARKER'                 'INTORG'\n"
+             "    X2        COST         2.0   LIM1         1.0\n"
+             "    X2        MYEQN       -1.0   LIM2         0.0\n"
+             "    MARKER                 'MARKER'                 'INTEND'\n"
+             "    X3        COST        -1.0   MYEQN        1.0\n"
+             "    X4        LIM2         3.0\n"
+             "    X5        COST         1.5   LIM1         2.0\n"
+             "RHS\n"
+             "    RHS       LIM1         4.0   LIM2         1.0\n"
+             "    RHS       MYEQN        7.0\n"
+             "RANGES\n"
+             "    RNG       LIM1         2.5   MYEQN       -2.0\n"
+             "BOUNDS\n"
+             " UP BND       X1           4.0\n"
+             " LO BND       X2          -1.0\n"
+             " UP BND       X2           5.0\n"
+             " FR BND       X3\n"
+             " MI BND       X4\n"
+             " BV BND       X5\n"
+             "ENDATA\n");
+   {
+      OsiClpSolverInterface normal;
+      normal.messageHandler()->setLogLevel(0);
+      normal.readMps("fastmps1.mps", "");
+      for (int numberThreads = 1; numberThreads <= 4; numberThreads += 3) {
+         OsiClpSolverInterface fast;
+         if (fastRead("fastmps1.mps", numberThreads, fast)) {
+            cerr << "Fast reader failed on valid small file with " << numberThreads << " threads" << endl;
+            error_count++;
+         } else if (!sameProblem(normal, fast)) {
+            cerr << "Fast reader gives different problem for small file with " << numberThreads << " threads" << endl;
+            error_count++;
+         }
+      }
+   }
+   // Large valid file so more than one chunk
+   writeLargeFile("fastmps2.mps", false);
+   {
+      OsiClpSolverInterface normal;
+      normal.messageHandler()->setLogLevel(0);
+      normal.readMps("fastmps2.mps", "");
+      for (int numberThreads = 1; numberThreads <= 4; numberThreads += 3) {
+         OsiClpSolverInterface fast;
+         if (fastRead("fastmps2.mps", numberThreads, fast)) {
+            cerr << "Fast reader failed on valid large file with " << numberThreads << " threads" << endl;
+            error_count++;
+         } else if (!sameProblem(normal, fast)) {
+            cerr << "Fast reader gives different problem for large file with " << numberThreads << " threads" << endl;
+            error_count++;
+         }
+      }
+   }
+   // Duplicate entries must be left to CoinMpsIO
+   writeLargeFile("fastmps3.mps", true);
+   {
+      OsiClpSolverInterface fast;
+      if (fastRead("fastmps3.mps", 4, fast) != -1) {
+         cerr << "Fast reader accepted duplicate entry in large file" << endl;
+         error_count++;
+      }
+   }
+   const char * bad[] = {
+      // row twice in a column (same line)
+      "NAME  BAD\nROWS\n N  COST\n L  R1\nCOLUMNS\n"
+      "    X1  R1  1.0  R1  2.0\nRHS\n    RHS  R1  1.0\nENDATA\n",
+      // row twice in a column (different lines)
+      "NAME  BAD\nROWS\n N  COST\n L  R1\nCOLUMNS\n"
+      "    X1  R1  1.0\n    X1  R1  2.0\nRHS\n    RHS  R1  1.0\nENDATA\n",
+      // objective twice for a column
+      "NAME  BAD\nROWS\n N  COST\n L  R1\nCOLUMNS\n"
+      "    X1  COST  1.0  R1  1.0\n    X1  COST  2.0\nRHS\n    RHS  R1  1.0\nENDATA\n",
+      // column not contiguous
+      "NAME  BAD\nROWS\n N  COST\n L  R1\n L  R2\nCOLUMNS\n"
+      "    X1  R1  1.0\n    X2  R1  1.0\n    X1  R2  1.0\nENDATA\n",
+      // unknown row
+      "NAME  BAD\nROWS\n N  COST\n L  R1\nCOLUMNS\n"
+      "    X1  R9  1.0\nENDATA\n",
+      // bad number
+      "NAME  BAD\nROWS\n N  COST\n L  R1\nCOLUMNS\n"
+      "    X1  R1  1.x\nENDATA\n",
+      // wrong number of fields
+      "NAME  BAD\nROWS\n N  COST\n L  R1\nCOLUMNS\n"
+      "    X1  R1  1.0  R1\nENDATA\n",
+      // unknown row type
+      "NAME  BAD\nROWS\n N  COST\n Q  R1\nCOLUMNS\n"
+      "    X1  R1  1.0\nENDATA\n",
+      // bound on unknown column
+      "NAME  BAD\nROWS\n N  COST\n L  R1\nCOLUMNS\n"
+      "    X1  R1  1.0\nBOUNDS\n UP BND  X9  1.0\nENDATA\n",
+      // semi-continuous not handled
+      "NAME  BAD\nROWS\n N  COST\n L  R1\nCOLUMNS\n"
+      "    X1  R1  1.0\nBOUNDS\n SC BND  X1  1.0\nENDATA\n"
+   };
+   int numberBad = static_cast<int> (sizeof(bad) / sizeof(const char *));
+   for (int i = 0; i < numberBad; i++) {
+      writeFile("fastmps4.mps", bad[i]);
+      OsiClpSolverInterface fast;
+      if (fastRead("fastmps4.mps", 1, fast) != -1) {
+         cerr << "Fast reader accepted bad file " << i << endl;
+         error_count++;
+      }
+   }
+   remove("fastmps1.mps");
+   remove("fastmps2.mps");
+   remove("fastmps3.mps");
+   remove("fastmps4.mps");
+}
+void snapshot(int& error_count, int& warning_count) {
+   writeFile("snapshot.mps",
+             "NAME          SNAP\n"
+             "ROWS\n"
+             " N  COST\n"
+             " L  LIM1\n"
+             " G  LIM2\n"
+             "COLUMNS\n"
+             "    MARKER                 'MARKER'                 'INTORG'\n"
+             "    X1        COST        -1.0   LIM1         1.0\n"
+             "    X1        LIM2         1.0\n"
+             "    X2        COST        -2.0   LIM1         1.0\n"
+             "    MARKER                 'MARKER'                 'INTEND'\n"
+             "    X3        COST        -1.0   LIM1         1.0\n"
+             "RHS\n"
+             "    RHS       LIM1         3.5   LIM2         1.0\n"
+             "BOUNDS\n"
+             " UP BND       X1           2.0\n"
+             " UP BND       X2           2.0\n"
+             " UP BND       X3           0.5\n"
+             "ENDATA\n");
+   OsiClpSolverInterface original;
+   original.messageHandler()->setLogLevel(0);
+   original.readMps("snapshot.mps", "");
+   remove("snapshot.mps");
+   std::vector<std::string> names;
+   for (int i = 0; i < original.getNumCols(); i++)
+      names.push_back(original.getColName(i));
+   // preprocessed model is just a copy here
+   if (CbcSnapshot::write("snapshot.snap", &original, NULL, original.getNumCols(),
+                          NULL, &names, &original)) {
+      cerr << "Unable to write snapshot" << endl;
+      error_count++;
+      return;
+   }
+   {
+      CbcSnapshot snap;
+      if (snap.read("snapshot.snap") || !snap.hasOriginal()) {
+         cerr << "Unable to read snapshot or original model missing" << endl;
+         error_count++;
+      } else {
+         OsiClpSolverInterface copy;
+         snap.loadOriginal(&copy);
+         if (!sameProblem(original, copy)) {
+            cerr << "Original model in snapshot is different" << endl;
+            error_count++;
+         }
+         std::vector<std::string> copyNames = snap.originalColumnNames();
+         if (copyNames != names || snap.columnNames() != names) {
+            cerr << "Names in snapshot are different" << endl;
+            error_count++;
+         }
+         // solution maps back onto original
+         double solution[3] = {1.0, 2.0, 0.3};
+         double originalSolution[3];
+         if (snap.postSolve(&copy, solution, originalSolution) ||
+             fabs(originalSolution[0] - 1.0) > 1.0e-7 ||
+             fabs(originalSolution[1] - 2.0) > 1.0e-7 ||
+             fabs(originalSolution[2] - 0.5) > 1.0e-7) {
+            cerr << "Snapshot solution not mapped back" << endl;
+            error_count++;
+         }
+      }
+   }
+   // truncated and corrupt files must be rejected
+   FILE * fp = fopen("snapshot.snap", "rb");
+   assert(fp);
+   fseek(fp, 0, SEEK_END);
+   long size = ftell(fp);
+   fseek(fp, 0, SEEK_SET);
+   char * buffer = new char [size];
+   size_t nRead = fread(buffer, 1, size, fp);
+   assert (nRead == static_cast<size_t> (size));
+   fclose(fp);
+   for (int iTry = 0; iTry < 3; iTry++) {
+      fp = fopen("snapshot.snap", "wb");
+      assert(fp);
+      if (iTry == 0) {
+         // lose last section
+         fwrite(buffer, 1, size - 8, fp);
+      } else if (iTry == 1) {
+         // extra bytes
+         fwrite(buffer, 1, size, fp);
+         fwrite(buffer, 1, 8, fp);
+      } else {
+         // names (last section "X1 X2 X3" padded to 16) not terminated
+         char * corrupt = CoinCopyOfArray(buffer, size);
+         for (long i = size - 16; i < size - 7; i++) {
+            if (!corrupt[i])
+               corrupt[i] = 'x';
+         }
+         fwrite(corrupt, 1, size, fp);
+         delete [] corrupt;
+      }
+      fclose(fp);
+      CbcSnapshot snap;
+      if (snap.read("snapshot.snap") != 2) {
+         cerr << "Bad snapshot " << iTry << " accepted" << endl;
+         error_count++;
+      }
+   }
+   delete [] buffer;
+   remove("snapshot.snap");
+}
+void mipStart(int& error_count, int& warning_count) {
+   const int numberValues = 100000;
+   const long blockSize = 1048576;
+   FILE * fp = fopen("mipstart.sol", "w");
+   assert(fp);
+   fprintf(fp, "Stopped on iterations - objective value 12.5\n");
+   long position = ftell(fp);
+   bool straddles = false;
+   for (int i = 0; i < numberValues; i++) {
+      if (i == numberValues / 2) {
+         // comment line longer than a block
+         std::string longLine(blockSize + blockSize / 2, 'x');
+         fprintf(fp, "%s\n", longLine.c_str());
+      }
+      fprintf(fp, "%d variable%d %d.25 0\n", i, i, i);
+      long next = ftell(fp);
+      if (position < blockSize && next > blockSize)
+         straddles = true;
+      position = next;
+   }
+   fclose(fp);
+   if (!straddles) {
+      cerr << "mipstart.sol has no line across first block" << endl;
+      warning_count++;
+   }
+   OsiClpSolverInterface solver;
+   CbcModel model(solver);
+   model.messageHandler()->setLogLevel(0);
+   std::vector< std::pair< std::string, double > > colValues;
+   double objective = 0.0;
+   if (readMIPStart(&model, "mipstart.sol", colValues, objective)) {
+      cerr << "Unable to read mipstart.sol" << endl;
+      error_count++;
+   } else if (colValues.size() != static_cast<size_t> (numberValues)) {
+      cerr << "mipstart.sol gave " << colValues.size() << " values not "
+           << numberValues << endl;
+      error_count++;
+   } else {
+      int numberBad = 0;
+      char name[20];
+      for (int i = 0; i < numberValues; i++) {
+         sprintf(name, "variable%d", i);
+         if (colValues[i].first != name ||
+               fabs(colValues[i].second - (i + 0.25)) > testtol)
+            numberBad++;
+      }
+      if (numberBad) {
+         cerr << numberBad << " bad values in mipstart.sol" << endl;
+         error_count++;
+      }
+   }
+   remove("mipstart.sol");
+}
+// options seen on model after branch and bound
+static int optionsAfterSearch = -1;
+static int recordOptions(CbcModel * model, int whereFrom)
+{
+   if (whereFrom == 4)
+      optionsAfterSearch = (model->useWorkClock() ? 1 : 0) +
+                           (model->pinThreads() ? 2 : 0);
+   return 0;
+}
+// knapsack - optimal -16 with items 0, 3 and 4
+static void loadKnapsack(OsiClpSolverInterface & solver)
+{
+   int start[] = {0, 1, 2, 3, 4, 5};
+   int index[] = {0, 0, 0, 0, 0};
+   double value[] = {2.0, 8.0, 4.0, 2.0, 5.0};
+   double collb[] = {0.0, 0.0, 0.0, 0.0, 0.0};
+   double colub[] = {1.0, 1.0, 1.0, 1.0, 1.0};
+   double obj[] = {-5.0, -3.0, -2.0, -7.0, -4.0};
+   double rowlb[] = {-COIN_DBL_MAX};
+   double rowub[] = {10.0};
+   solver.loadProblem(5, 1, start, index, value, collb, colub, obj, rowlb, rowub);
+   for (int i = 0; i < 5; i++)
+      solver.setInteger(i);
+}
+void modelOptions(int& error_count, int& warning_count) {
+   OsiClpSolverInterface solver;
+   loadKnapsack(solver);
+   // set on model then by parameters
+   for (int iTry = 0; iTry < 2; iTry++) {
+      CbcModel model(solver);
+      CbcMain0(model);
+      std::vector<const char *> args;
+      args.push_back("iotest_options");
+      args.push_back("-log");
+      args.push_back("0");
+      if (!iTry) {
+         model.setUseWorkClock(true);
+         model.setPinThreads(true);
+      } else {
+         args.push_back("-workClock");
+         args.push_back("1");
+         args.push_back("-pinThreads");
+         args.push_back("1");
+      }
+      args.push_back("-solve");
+      args.push_back("-quit");
+      optionsAfterSearch = -1;
+      CbcMain1(static_cast<int> (args.size()), &args[0], model, recordOptions);
+      if (!model.isProvenOptimal() || fabs(model.getObjValue() + 16.0) > 1.0e-6) {
+         cerr << "Error: knapsack not solved to optimality" << endl;
+         error_count++;
+      }
+      if (optionsAfterSearch < 0 || !(optionsAfterSearch & 1)) {
+         cerr << "Error: work clock not set for branch and bound (try " << iTry << ")" << endl;
+         error_count++;
+      }
+      if (optionsAfterSearch < 0 || !(optionsAfterSearch & 2)) {
+         cerr << "Error: pin threads not set for branch and bound (try " << iTry << ")" << endl;
+         error_count++;
+      }
+   }
+}
+#ifdef CBC_THREAD
+// what thread models saw after memory degraded (set by any thread)
+static int threadDegraded = 0;
+static int threadCutsOn = 0;
+static int threadHeuristicsOn = 0;
+// Each thread gets own copy (moreSpecialOptions2 32) so model is thread model
+class MemoryCheckHandler : public CbcEventHandler {
+public:
+   MemoryCheckHandler(CbcModel * baseModel)
+      : CbcEventHandler(baseModel), baseModel_(baseModel) {}
+   virtual CbcEventHandler * clone() const {
+      return new MemoryCheckHandler(*this);
+   }
+   virtual CbcAction event(CbcEvent whichEvent) {
+      if (whichEvent != node || model_ == baseModel_ || model_->memoryState() < 1)
+         return noAction;
+      threadDegraded = 1;
+      for (int i = 0; i < model_->numberCutGenerators(); i++) {
+         if (!model_->cutGenerator(i)->switchedOff())
+            threadCutsOn = 1;
+      }
+      if (model_->memoryState() >= 3) {
+         for (int i = 0; i < model_->numberHeuristics(); i++) {
+            if (model_->heuristic(i)->whereFrom())
+               threadHeuristicsOn = 1;
+         }
+      }
+      return noAction;
+   }
+private:
+   CbcModel * baseModel_;
+};
+#endif
+void memoryLimit(int& error_count, int& warning_count) {
+#ifdef CBC_THREAD
+   // multiple knapsack which needs some nodes
+   int numberColumns = 40;
+   int numberRows = 3;
+   std::vector<CoinBigIndex> start(numberColumns + 1);
+   std::vector<int> index;
+   std::vector<double> value;
+   std::vector<double> collb(numberColumns, 0.0);
+   std::vector<double> colub(numberColumns, 1.0);
+   std::vector<double> obj(numberColumns);
+   std::vector<double> rowlb(numberRows, -COIN_DBL_MAX);
+   std::vector<double> rowub(numberRows);
+   for (int j = 0; j < numberColumns; j++) {
+      start[j] = static_cast<CoinBigIndex> (index.size());
+      obj[j] = -(10.0 + (j * 37) % 23);
+      for (int i = 0; i < numberRows; i++) {
+         index.push_back(i);
+         value.push_back(5.0 + ((j + 1) * (i + 3) * 17) % 29);
+      }
+   }
+   start[numberColumns] = static_cast<CoinBigIndex> (index.size());
+   for (int i = 0; i < numberRows; i++)
+      rowub[i] = 200.0 + 13.0 * i;
+   OsiClpSolverInterface solver;
+   solver.loadProblem(numberColumns, numberRows, &start[0], &index[0], &value[0],
+                      &collb[0], &colub[0], &obj[0], &rowlb[0], &rowub[0]);
+   for (int j = 0; j < numberColumns; j++)
+      solver.setInteger(j);
+   CbcModel model(solver);
+   model.setLogLevel(0);
+   CglProbing probing;
+   model.addCutGenerator(&probing, 1, "Probing");
+   CbcRounding rounding(model);
+   model.addHeuristic(&rounding);
+   model.setNumberThreads(2);
+   model.setMoreSpecialOptions2(model.moreSpecialOptions2() | 32);
+   MemoryCheckHandler handler(&model);
+   model.passInEventHandler(&handler);
+   // what is in use now is 75% of maximum - so degraded at first check
+   double used = CbcMemory::residentBytes() / (1024.0 * 1024.0);
+   model.setMaximumMemory(used / 0.75);
+   threadDegraded = 0;
+   threadCutsOn = 0;
+   threadHeuristicsOn = 0;
+   model.branchAndBound();
+   if (model.memoryState() < 1) {
+      cerr << "Error: branch and bound did not degrade with maximum memory "
+           << model.getMaximumMemory() << " megabytes" << endl;
+      error_count++;
+   } else if (!threadDegraded) {
+      // may have gone straight to stopping
+      cerr << "Warning: no thread model saw memory degradation (state "
+           << model.memoryState() << ")" << endl;
+      warning_count++;
+   }
+   if (threadCutsOn) {
+      cerr << "Error: thread model still generating cuts after memory degraded" << endl;
+      error_count++;
+   }
+   if (threadHeuristicsOn) {
+      cerr << "Error: thread model still running heuristics after memory degraded" << endl;
+      error_count++;
+   }
+#else
+   cerr << "Warning: memory limit with threads not tested (no threads)" << endl;
+   warning_count++;
+#endif
+}
+// sum over integers of times branched on
+static int numberBranches(const CbcModel & model, std::vector<int> & count)
+{
+   int total = 0;
+   count.assign(model.getNumCols(), 0);
+   for (int i = 0; i < model.numberObjects(); i++) {
+      const CbcSimpleIntegerDynamicPseudoCost * obj =
+         dynamic_cast<const CbcSimpleIntegerDynamicPseudoCost *> (model.object(i));
+      if (obj) {
+         count[obj->columnNumber()] = obj->numberTimesDown() + obj->numberTimesUp();
+         total += count[obj->columnNumber()];
+      }
+   }
+   return total;
+}
+void resolve(int& error_count, int& warning_count) {
+   OsiClpSolverInterface solver;
+   loadKnapsack(solver);
+   CbcModel model(solver);
+   model.setLogLevel(0);
+   model.setNumberBeforeTrust(5);
+   model.setKeepForResolve(true);
+   model.initialSolve();
+   model.branchAndBound();
+   if (!model.isProvenOptimal() || fabs(model.getObjValue() + 16.0) > 1.0e-6) {
+      cerr << "Error: knapsack not solved to optimality" << endl;
+      error_count++;
+      return;
+   }
+   std::vector<int> before;
+   if (!numberBranches(model, before)) {
+      cerr << "Warning: no branching so pseudocosts not tested" << endl;
+      warning_count++;
+   }
+   // valid cut x1 + x2 <= 1
+   int cutIndex[] = {1, 2};
+   double cutElement[] = {1.0, 1.0};
+   OsiRowCut cut;
+   cut.setRow(2, cutIndex, cutElement);
+   cut.setLb(-COIN_DBL_MAX);
+   cut.setUb(1.0);
+   model.makeGlobalCut(cut);
+   int numberCuts = model.globalCuts()->sizeRowCuts();
+   // 1) smaller region and incumbent (x1 = 0) still feasible - all kept
+   model.resolveSetColumnBounds(1, 0.0, 0.0);
+   model.restoreForResolve();
+   if (!model.bestSolution() || fabs(model.getMinimizationObjValue() + 16.0) > 1.0e-6) {
+      cerr << "Error: feasible incumbent not kept after bound change" << endl;
+      error_count++;
+   }
+   if (model.globalCuts()->sizeRowCuts() != numberCuts || !numberCuts) {
+      cerr << "Error: cuts not kept after bound change which made region smaller" << endl;
+      error_count++;
+   }
+   // objects made again (as CbcMain1 does) - pseudocosts must come back
+   model.deleteObjects(true);
+   model.initialSolve();
+   model.branchAndBound();
+   if (!model.isProvenOptimal() || fabs(model.getObjValue() + 16.0) > 1.0e-6) {
+      cerr << "Error: wrong answer after first resolve" << endl;
+      error_count++;
+   }
+   std::vector<int> after;
+   numberBranches(model, after);
+   for (size_t i = 0; i < before.size(); i++) {
+      if (after[i] < before[i]) {
+         cerr << "Error: pseudocosts of column " << i << " not kept by resolve" << endl;
+         error_count++;
+         break;
+      }
+   }
+   // 2) change cuts off incumbent (x3 = 1) - incumbent and cuts dropped
+   model.makeGlobalCut(cut);
+   model.resolveSetColumnBounds(3, 0.0, 0.0);
+   model.restoreForResolve();
+   if (model.bestSolution() || model.getSolutionCount()) {
+      cerr << "Error: infeasible incumbent kept after bound change" << endl;
+      error_count++;
+   }
+   if (model.globalCuts()->sizeRowCuts()) {
+      cerr << "Error: cuts kept when incumbent no longer feasible" << endl;
+      error_count++;
+   }
+   model.initialSolve();
+   model.branchAndBound();
+   // best is now items 0 and 4
+   if (!model.isProvenOptimal() || fabs(model.getObjValue() + 9.0) > 1.0e-6) {
+      cerr << "Error: wrong answer after second resolve" << endl;
+      error_count++;
+   }
+   // 3) bigger region - incumbent still feasible but cuts dropped
+   model.makeGlobalCut(cut);
+   model.resolveSetColumnBounds(3, 0.0, 1.0);
+   model.restoreForResolve();
+   if (!model.bestSolution() || fabs(model.getMinimizationObjValue() + 9.0) > 1.0e-6) {
+      cerr << "Error: feasible incumbent not kept after bound relaxed" << endl;
+      error_count++;
+   }
+   if (model.globalCuts()->sizeRowCuts()) {
+      cerr << "Error: cuts kept after region made bigger" << endl;
+      error_count++;
+   }
+}